@@ -66,6 +66,19 @@ public:
   inline static void fftw_destroy_plan(const FFTW_plan p) {
     ::fftw_destroy_plan(p);
   }
+  inline static void *fftw_malloc(size_t bytes) {
+    return ::fftw_malloc(bytes);
+  }
+  inline static void fftw_free(void *p) {
+    ::fftw_free(p);
+  }
+  inline static int fftw_import_wisdom_from_filename(const char *file) {
+    return ::fftw_import_wisdom_from_filename(file);
+  }
+  inline static int fftw_export_wisdom_to_filename(const char *file) {
+    return ::fftw_export_wisdom_to_filename(file);
+  }
+  static const char *precision(void) { return "double"; }
 };
 
 template<> struct FFTW<ComplexF> {
@@ -93,6 +106,103 @@ public:
   inline static void fftw_destroy_plan(const FFTW_plan p) {
     ::fftwf_destroy_plan(p);
   }
+  inline static void *fftw_malloc(size_t bytes) {
+    return ::fftwf_malloc(bytes);
+  }
+  inline static void fftw_free(void *p) {
+    ::fftwf_free(p);
+  }
+  inline static int fftw_import_wisdom_from_filename(const char *file) {
+    return ::fftwf_import_wisdom_from_filename(file);
+  }
+  inline static int fftw_export_wisdom_to_filename(const char *file) {
+    return ::fftwf_export_wisdom_to_filename(file);
+  }
+  static const char *precision(void) { return "single"; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// FFTW plans, created once per job.
+//
+// FFT calls in place 1d transforms of howmany interleaved components; a plan
+// depends only on the length, component count, strides, sign, precision
+// (the template parameter) and the alignment of the data, so these are the
+// cache key. Plans are made with FFTW_MEASURE on scratch memory of the same
+// alignment, as measuring overwrites the arrays, and are never destroyed.
+//
+// With a tuning cache directory (--tune-cache) the accumulated FFTW wisdom is
+// read from <Directory>/fftw_wisdom_<precision>_<machine> before the first
+// plan and rewritten by rank 0 whenever a new plan is made, so later jobs on
+// the same machine skip the measurement.
+////////////////////////////////////////////////////////////////////////////////
+template<class scalar> class FFTWPlanCache {
+public:
+  typedef typename FFTW<scalar>::FFTW_scalar FFTW_scalar;
+  typedef typename FFTW<scalar>::FFTW_plan   FFTW_plan;
+
+  static FFTW_plan Plan(int n,int howmany,int stride,int dist,int sign,bool aligned,FFTW_scalar *data)
+  {
+    int align = aligned ? (int)(((uint64_t)data)%64) : -1;
+    auto key  = std::make_tuple(n,howmany,stride,dist,sign,align);
+    auto &plans = Plans();
+    auto it = plans.find(key);
+    if ( it != plans.end() ) return it->second;
+
+    ImportWisdom();
+
+    // scratch congruent to data modulo the largest SIMD alignment
+    uint64_t words = (uint64_t)(n-1)*stride+(uint64_t)(howmany-1)*dist+1;
+    char *mem = (char *)FFTW<scalar>::fftw_malloc(words*sizeof(FFTW_scalar)+64);
+    FFTW_scalar *scratch = (FFTW_scalar *)(mem + (aligned ? align : 0));
+
+    unsigned flags = FFTW_MEASURE;
+    if ( !aligned ) flags |= FFTW_UNALIGNED;
+    int nn[] = {n};
+    FFTW_plan p = FFTW<scalar>::fftw_plan_many_dft(1,nn,howmany,
+						   scratch,nn,stride,dist,
+						   scratch,nn,stride,dist,
+						   sign,flags);
+    FFTW<scalar>::fftw_free(mem);
+    assert(p != NULL);
+    plans[key] = p;
+
+    ExportWisdom();
+    return p;
+  }
+
+private:
+  typedef std::tuple<int,int,int,int,int,int> Key;
+
+  static std::map<Key,FFTW_plan> &Plans(void)
+  {
+    static std::map<Key,FFTW_plan> plans;
+    return plans;
+  }
+
+  static std::string WisdomFile(void)
+  {
+    std::string machine = GridTuneCache::Machine();
+    for(auto &c : machine) if ( !isalnum(c) && (c != '.') && (c != '-') ) c = '_';
+    return GridTuneCache::Directory + "/fftw_wisdom_" + FFTW<scalar>::precision() + "_" + machine;
+  }
+
+  static void ImportWisdom(void)
+  {
+    static int imported = 0;
+    if ( imported || !GridTuneCache::Persistent() ) return;
+    imported = 1;
+    if ( FFTW<scalar>::fftw_import_wisdom_from_filename(WisdomFile().c_str()) ) {
+      std::cout << GridLogMessage << "FFTWPlanCache: imported wisdom from " << WisdomFile() << std::endl;
+    }
+  }
+
+  static void ExportWisdom(void)
+  {
+    if ( !GridTuneCache::Persistent() || (CartesianCommunicator::RankWorld() != 0) ) return;
+    if ( !FFTW<scalar>::fftw_export_wisdom_to_filename(WisdomFile().c_str()) ) {
+      std::cout << GridLogWarning << "FFTWPlanCache: could not write " << WisdomFile() << std::endl;
+    }
+  }
 };
 
 #endif
@@ -102,11 +212,15 @@ public:
 #define FFTW_BACKWARD (+1)
 #endif
 
+////////////////////////////////////////////////////////////////////////////
+// Constructing an FFT splits one sub-communicator per distributed dimension
+// of the grid, so it is collective: every rank of the grid must construct it,
+// and in the same order relative to other FFT objects.
+////////////////////////////////////////////////////////////////////////////
 class FFT {
 private:
     
   GridCartesian *vgrid;
-  GridCartesian *sgrid;
     
   int Nd;
   double flops;
@@ -116,6 +230,10 @@ private:
   Coordinate dimensions;
   Coordinate processors;
   Coordinate processor_coor;
+
+  // One communicator per distributed dimension, spanning the processors of
+  // that dimension; split once here rather than on every exchange
+  std::vector<std::shared_ptr<CartesianCommunicator> > dimcomm;
     
 public:
     
@@ -135,27 +253,38 @@ public:
   {
     flops=0;
     usec =0;
-    Coordinate layout(Nd,1);
-    sgrid = new GridCartesian(dimensions,layout,processors,*grid);
+    dimcomm.resize(Nd);
+    for(int d=0;d<Nd;d++){
+      if ( processors[d] > 1 ) {
+	Coordinate row(Nd,1);
+	row[d] = processors[d];
+	int srank;
+	dimcomm[d] = std::make_shared<CartesianCommunicator>(row,*grid,srank);
+      }
+    }
   };
     
-  ~FFT ( void)  {
-    delete sgrid;
-  }
-    
+  ////////////////////////////////////////////////////////////////////////////
+  // Distributed FFT by transposition.
+  //
+  // For each transformed dimension the local lines along that dimension are
+  // dealt out over the processors of the dimension with one AllToAll, every
+  // processor transforms complete global lines, and a second AllToAll returns
+  // them. A 4d FFT therefore costs two all-to-all exchanges per distributed
+  // dimension, none for dimensions that are not distributed, and no redundant
+  // work; the batched overloads move all fields in the same exchanges.
+  ////////////////////////////////////////////////////////////////////////////
   template<class vobj>
   void FFT_dim_mask(Lattice<vobj> &result,const Lattice<vobj> &source,Coordinate mask,int sign){
 
     conformable(result.Grid(),vgrid);
     conformable(source.Grid(),vgrid);
-    Lattice<vobj> tmp(vgrid);
-    tmp = source;
-    for(int d=0;d<Nd;d++){
-      if( mask[d] ) {
-	FFT_dim(result,tmp,d,sign);
-	tmp=result;
-      }
-    }
+
+    typedef typename vobj::scalar_object sobj;
+    std::vector<sobj> data(vgrid->lSites());
+    unvectorizeToLexOrdArray(data,source);
+    FFT_lex(data,1,mask,sign);
+    vectorizeFromLexOrdArray(data,result);
   }
 
   template<class vobj>
@@ -164,129 +293,161 @@ public:
     FFT_dim_mask(result,source,mask,sign);
   }
 
-
   template<class vobj>
   void FFT_dim(Lattice<vobj> &result,const Lattice<vobj> &source,int dim, int sign){
-#ifndef HAVE_FFTW
-    assert(0);
-#else
-    conformable(result.Grid(),vgrid);
-    conformable(source.Grid(),vgrid);
+    Coordinate mask(Nd,0);
+    mask[dim]=1;
+    FFT_dim_mask(result,source,mask,sign);
+  }
+
+  template<class vobj>
+  void FFT_dim_mask(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,Coordinate mask,int sign){
 
-    int L = vgrid->_ldimensions[dim];
-    int G = vgrid->_fdimensions[dim];
-      
-    Coordinate layout(Nd,1);
-    Coordinate pencil_gd(vgrid->_fdimensions);
-      
-    pencil_gd[dim] = G*processors[dim];
-      
-    // Pencil global vol LxLxGxLxL per node
-    GridCartesian pencil_g(pencil_gd,layout,processors,*vgrid);
-      
-    // Construct pencils
     typedef typename vobj::scalar_object sobj;
-    typedef typename sobj::scalar_type   scalar;
-      
-    Lattice<sobj> pgbuf(&pencil_g);
-    autoView(pgbuf_v , pgbuf, CpuWrite);
 
+    int nfield = source.size();
+    assert(result.size()==nfield);
+    for(int f=0;f<nfield;f++){
+      conformable(result[f].Grid(),vgrid);
+      conformable(source[f].Grid(),vgrid);
+    }
+
+    uint64_t lsites = vgrid->lSites();
+    std::vector<sobj> data(nfield*lsites);
+    std::vector<sobj> scalardata(lsites);
+    for(int f=0;f<nfield;f++){
+      unvectorizeToLexOrdArray(scalardata,source[f]);
+      thread_for(site,lsites,{
+	data[f*lsites+site] = scalardata[site];
+      });
+    }
+
+    FFT_lex(data,nfield,mask,sign);
+
+    for(int f=0;f<nfield;f++){
+      thread_for(site,lsites,{
+	scalardata[site] = data[f*lsites+site];
+      });
+      vectorizeFromLexOrdArray(scalardata,result[f]);
+    }
+  }
+
+  template<class vobj>
+  void FFT_all_dim(std::vector<Lattice<vobj> > &result,const std::vector<Lattice<vobj> > &source,int sign){
+    Coordinate mask(Nd,1);
+    FFT_dim_mask(result,source,mask,sign);
+  }
+
+private:
+
+  // nfield fields, each in local lexicographic order, transformed in place
+  template<class sobj>
+  void FFT_lex(std::vector<sobj> &data,int nfield,Coordinate mask,int sign){
+    for(int d=0;d<Nd;d++){
+      if( mask[d] ) FFT_lex_dim(data,nfield,d,sign);
+    }
+  }
+
+  template<class sobj>
+  void FFT_lex_dim(std::vector<sobj> &data,int nfield,int dim,int sign){
+#ifndef HAVE_FFTW
+    assert(0);
+#else
+    typedef typename sobj::scalar_type         scalar;
     typedef typename FFTW<scalar>::FFTW_scalar FFTW_scalar;
     typedef typename FFTW<scalar>::FFTW_plan   FFTW_plan;
-      
-    int Ncomp = sizeof(sobj)/sizeof(scalar);
-    int Nlow  = 1;
-    for(int d=0;d<dim;d++){
-      Nlow*=vgrid->_ldimensions[d];
+
+    Coordinate ldims = vgrid->_ldimensions;
+    uint64_t lsites  = vgrid->lSites();
+
+    int L = ldims[dim];
+    int P = processors[dim];
+    int G = L*P;
+
+    uint64_t Nlow = 1;
+    for(int d=0;d<dim;d++) Nlow*=ldims[d];
+    uint64_t Northo = lsites/L;
+    uint64_t Nlines = nfield*Northo;
+    uint64_t B      = (Nlines+P-1)/P; // lines transformed by each processor
+
+    // sendbuf[q][b][x] holds x-th local point of line q*B+b, destined for processor q;
+    // aligned so that every call hits the same cached plan
+    typedef std::vector<sobj,alignedAllocator<sobj> > sobjVector;
+    sobjVector sendbuf(P*B*L);
+    sobjVector recvbuf(P>1 ? P*B*L : 0);
+
+    thread_for(qb,P*B,{
+      uint64_t line = qb;
+      if ( line < Nlines ) {
+	uint64_t f    = line/Northo;
+	uint64_t o    = line%Northo;
+	uint64_t base = f*lsites + o%Nlow + (o/Nlow)*Nlow*L;
+	for(int x=0;x<L;x++) sendbuf[qb*L+x] = data[base+x*Nlow];
+      } else {
+	for(int x=0;x<L;x++) sendbuf[qb*L+x] = Zero();
+      }
+    });
+
+    // pencil[b][g] : B complete global lines, reusing sendbuf
+    sobjVector &pencil = sendbuf;
+    if ( P > 1 ) {
+      dimcomm[dim]->AllToAll((void *)&sendbuf[0],(void *)&recvbuf[0],B*L,sizeof(sobj));
+      thread_for(pb,P*B,{
+	uint64_t p = pb/B;
+	uint64_t b = pb%B;
+	for(int x=0;x<L;x++) pencil[b*G+p*L+x] = recvbuf[pb*L+x];
+      });
     }
-      
-    int rank = 1;  /* 1d transforms */
-    int n[] = {G}; /* 1d transforms of length G */
-    int howmany = Ncomp;
-    int odist,idist,istride,ostride;
-    idist   = odist   = 1;          /* Distance between consecutive FT's */
-    istride = ostride = Ncomp*Nlow; /* distance between two elements in the same FT */
-    int *inembed = n, *onembed = n;
-      
+
+    // 1d transforms of length G over the Ncomp interleaved components of a line
+    int Ncomp = sizeof(sobj)/sizeof(scalar);
+
+    // lines share the alignment of the first line only if their spacing allows it
+    bool aligned = ((G*sizeof(sobj)) % 64) == 0;
+    FFTW_plan p = FFTWPlanCache<scalar>::Plan(G,Ncomp,Ncomp,1,sign,aligned,(FFTW_scalar *)&pencil[0]);
+
     scalar div;
     if ( sign == backward ) div = 1.0/G;
     else if ( sign == forward ) div = 1.0;
     else assert(0);
-      
-    FFTW_plan p;
-    {
-      FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[0];
-      FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[0];
-      p = FFTW<scalar>::fftw_plan_many_dft(rank,n,howmany,
-					   in,inembed,
-					   istride,idist,
-					   out,onembed,
-					   ostride, odist,
-					   sign,FFTW_ESTIMATE);
-    }
-      
-    // Barrel shift and collect global pencil
-    Coordinate lcoor(Nd), gcoor(Nd);
-    result = source;
-    int pc = processor_coor[dim];
-    for(int p=0;p<processors[dim];p++) {
-      {
-	autoView(r_v,result,CpuRead);
-	autoView(p_v,pgbuf,CpuWrite);
-	thread_for(idx, sgrid->lSites(),{
-          Coordinate cbuf(Nd);
-          sobj s;
-	  sgrid->LocalIndexToLocalCoor(idx,cbuf);
-	  peekLocalSite(s,r_v,cbuf);
-	  cbuf[dim]+=((pc+p) % processors[dim])*L;
-	  pokeLocalSite(s,p_v,cbuf);
-        });
-      }
-      if (p != processors[dim] - 1) {
-	result = Cshift(result,dim,L);
-      }
-    }
-      
-    // Loop over orthog coords
-    int NN=pencil_g.lSites();
+
+    uint64_t Nmine = std::min(B,Nlines-std::min(Nlines,processor_coor[dim]*B));
     GridStopWatch timer;
     timer.Start();
-    thread_for( idx,NN,{
-        Coordinate cbuf(Nd);
-	pencil_g.LocalIndexToLocalCoor(idx, cbuf);
-	if ( cbuf[dim] == 0 ) {  // restricts loop to plane at lcoor[dim]==0
-	  FFTW_scalar *in = (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW_scalar *out= (FFTW_scalar *)&pgbuf_v[idx];
-	  FFTW<scalar>::fftw_execute_dft(p,in,out);
-	}
+    thread_for(b,Nmine,{
+      FFTW_scalar *in = (FFTW_scalar *)&pencil[b*G];
+      FFTW_scalar *out= (FFTW_scalar *)&pencil[b*G];
+      FFTW<scalar>::fftw_execute_dft(p,in,out);
+      if ( sign == backward ) {
+	scalar *s = (scalar *)&pencil[b*G];
+	for(int i=0;i<G*Ncomp;i++) s[i] = s[i]*div;
+      }
     });
     timer.Stop();
-      
+
     // performance counting
     double add,mul,fma;
     FFTW<scalar>::fftw_flops(p,&add,&mul,&fma);
     flops_call = add+mul+2.0*fma;
     usec += timer.useconds();
-    flops+= flops_call*NN;
-      
-    // writing out result
-    {
-      autoView(pgbuf_v,pgbuf,CpuRead);
-      autoView(result_v,result,CpuWrite);
-      thread_for(idx,sgrid->lSites(),{
-	Coordinate clbuf(Nd), cgbuf(Nd);
-	sobj s;
-	sgrid->LocalIndexToLocalCoor(idx,clbuf);
-	cgbuf = clbuf;
-	cgbuf[dim] = clbuf[dim]+L*pc;
-	peekLocalSite(s,pgbuf_v,cgbuf);
-	pokeLocalSite(s,result_v,clbuf);
+    flops+= flops_call*Nmine;
+
+    // return the transformed lines to their owners
+    if ( P > 1 ) {
+      thread_for(pb,P*B,{
+	uint64_t p = pb/B;
+	uint64_t b = pb%B;
+	for(int x=0;x<L;x++) recvbuf[pb*L+x] = pencil[b*G+p*L+x];
       });
+      dimcomm[dim]->AllToAll((void *)&recvbuf[0],(void *)&sendbuf[0],B*L,sizeof(sobj));
     }
-    result = result*div;
-      
-    // destroying plan
-    FFTW<scalar>::fftw_destroy_plan(p);
+
+    thread_for(line,Nlines,{
+      uint64_t f    = line/Northo;
+      uint64_t o    = line%Northo;
+      uint64_t base = f*lsites + o%Nlow + (o/Nlow)*Nlow*L;
+      for(int x=0;x<L;x++) data[base+x*Nlow] = sendbuf[line*L+x];
+    });
 #endif
   }
 };
@@ -277,6 +277,27 @@ template<class Matrix,class Field>
       axpy(out,-1.0,tmp,out);
     }
 };
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Same operator through the matrix MpcFused/MpcDagFused, fused for e.g. CayleyFermion5D;
+// the work fields are kept for the life of the operator
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<class Matrix,class Field>
+  class SchurDiagMooeeFusedOperator :  public SchurDiagMooeeOperator<Matrix,Field> {
+ protected:
+    Field tmp;
+    Field col;
+    Field mid;
+ public:
+    SchurDiagMooeeFusedOperator (Matrix &Mat): SchurDiagMooeeOperator<Matrix,Field>(Mat),
+      tmp(Mat.RedBlackGrid()), col(Mat.RedBlackGrid()), mid(Mat.RedBlackGrid()) {};
+    virtual void Mpc      (const Field &in, Field &out) { this->_Mat.MpcFused(in,out,tmp,col); }
+    virtual void MpcDag   (const Field &in, Field &out) { this->_Mat.MpcDagFused(in,out,tmp,col); }
+    virtual void MpcDagMpc(const Field &in, Field &out) {
+      mid.Checkerboard() = in.Checkerboard();
+      Mpc(in,mid);
+      MpcDag(mid,out);
+    }
+};
 template<class Matrix,class Field>
   class SchurDiagOneOperator :  public SchurOperatorBase<Field> {
  protected:
@@ -514,6 +535,18 @@ class SchurStaggeredOperator :  public SchurOperatorBase<Field> {
 };
 template<class Matrix,class Field> using SchurStagOperator = SchurStaggeredOperator<Matrix,Field>;
 
+/////////////////////////////////////////////////////////////
+// Running tally of Krylov iterations performed by the solvers.
+// Callers (e.g. the HMC integrator) difference it around a
+// block of work to attribute solver cost without needing
+// access to the solver objects held inside actions.
+/////////////////////////////////////////////////////////////
+class SolverIterationCounter {
+public:
+  static uint64_t & Total(void) { static uint64_t count = 0; return count; }
+  static void Add(uint64_t iter) { Total() += iter; }
+};
+
 /////////////////////////////////////////////////////////////
 // Base classes for functions of operators
 /////////////////////////////////////////////////////////////
@@ -73,6 +73,27 @@ public:
   virtual  void MeooeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeDag    (const Field &in, Field &out)=0;
   virtual  void MooeeInvDag (const Field &in, Field &out)=0;
+
+  //////////////////////////////////////////////////////////////////////
+  // Schur complement Mooee - Meooe MooeeInv Meooe and its adjoint on
+  // caller owned work fields; matrices with a fused kernel override these
+  //////////////////////////////////////////////////////////////////////
+  virtual  void MpcFused    (const Field &in, Field &out, Field &tmp, Field &work) {
+    tmp.Checkerboard() = !in.Checkerboard();
+    Meooe(in,tmp);
+    MooeeInv(tmp,out);
+    Meooe(out,tmp);
+    Mooee(in,out);
+    axpy(out,-1.0,tmp,out);
+  }
+  virtual  void MpcDagFused (const Field &in, Field &out, Field &tmp, Field &work) {
+    tmp.Checkerboard() = !in.Checkerboard();
+    MeooeDag(in,tmp);
+    MooeeInvDag(tmp,out);
+    MeooeDag(out,tmp);
+    MooeeDag(in,out);
+    axpy(out,-1.0,tmp,out);
+  }
   virtual ~CheckerBoardedSparseMatrixBase() {};
 };
 
@@ -182,6 +182,7 @@ public:
 
 	IterationsToComplete = k;	
 	TrueResidual = true_residual;
+	SolverIterationCounter::Add(k);
 
         return;
       }
@@ -196,6 +197,7 @@ public:
 
     if (ErrorOnNoConverge) assert(0);
     IterationsToComplete = k;
+    SolverIterationCounter::Add(k);
 
   }
 };
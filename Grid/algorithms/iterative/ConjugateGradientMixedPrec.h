@@ -52,6 +52,10 @@ NAMESPACE_BEGIN(Grid);
 
     //Option to speed up *inner single precision* solves using a LinearFunction that produces a guess
     LinearFunction<FieldF> *guesser;
+
+    //Option to keep the inner solver residual in 16 bit storage (ConjugateGradientHalfStorage)
+    bool InnerHalfStorage;
+    HalfPrecisionFormat InnerHalfFormat;
     
     MixedPrecisionConjugateGradient(RealD tol, 
 				    Integer maxinnerit, 
@@ -61,11 +65,16 @@ NAMESPACE_BEGIN(Grid);
 				    LinearOperatorBase<FieldD> &_Linop_d) :
       Linop_f(_Linop_f), Linop_d(_Linop_d),
       Tolerance(tol), InnerTolerance(tol), MaxInnerIterations(maxinnerit), MaxOuterIterations(maxouterit), SinglePrecGrid(_sp_grid),
-      OuterLoopNormMult(100.), guesser(NULL){ };
+      OuterLoopNormMult(100.), guesser(NULL), InnerHalfStorage(false), InnerHalfFormat(HalfPrecisionFP16){ };
 
     void useGuesser(LinearFunction<FieldF> &g){
       guesser = &g;
     }
+
+    void useHalfStorage(HalfPrecisionFormat format = HalfPrecisionFP16){
+      InnerHalfStorage = true;
+      InnerHalfFormat  = format;
+    }
   
   void operator() (const FieldD &src_d_in, FieldD &sol_d){
     TotalInnerIterations = 0;
@@ -100,6 +109,9 @@ NAMESPACE_BEGIN(Grid);
     ConjugateGradient<FieldF> CG_f(inner_tol, MaxInnerIterations);
     CG_f.ErrorOnNoConverge = false;
 
+    ConjugateGradientHalfStorage<FieldF> CGH_f(inner_tol, MaxInnerIterations, InnerHalfFormat);
+    CGH_f.ErrorOnNoConverge = false;
+
     GridStopWatch InnerCGtimer;
 
     GridStopWatch PrecChangeTimer;
@@ -130,11 +142,19 @@ NAMESPACE_BEGIN(Grid);
 	(*guesser)(src_f, sol_f);
 
       //Inner CG
-      CG_f.Tolerance = inner_tol;
       InnerCGtimer.Start();
-      CG_f(Linop_f, src_f, sol_f);
+      if ( InnerHalfStorage ) {
+	// 16 bit residual words cannot be reduced further than their precision;
+	// the outer defect correction takes over from there
+	CGH_f.Tolerance = std::max(inner_tol, ConjugateGradientHalfStorage<FieldF>::ToleranceFloor(InnerHalfFormat));
+	CGH_f(Linop_f, src_f, sol_f);
+	TotalInnerIterations += CGH_f.IterationsToComplete;
+      } else {
+	CG_f.Tolerance = inner_tol;
+	CG_f(Linop_f, src_f, sol_f);
+	TotalInnerIterations += CG_f.IterationsToComplete;
+      }
       InnerCGtimer.Stop();
-      TotalInnerIterations += CG_f.IterationsToComplete;
       
       //Convert sol back to double and add to double prec solution
       PrecChangeTimer.Start();
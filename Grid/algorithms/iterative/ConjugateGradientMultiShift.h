@@ -82,6 +82,65 @@ public:
     return;
   }
 
+  ////////////////////////////////////////////////////////////////////////
+  // Single sweep over the shared residual r for all shifts:
+  //
+  //   p      <- a p + r                                   (if a != 0)
+  //   psi[s] <- psi[s] + cpsi[s] ps[s]                    (if cpsi[s] != 0)
+  //   ps[s]  <- cr[s] r + cps[s] ps[s]                    (if cr[s]   != 0)
+  //
+  // The psi update of one iteration and the search direction update of the
+  // next are adjacent, so r is loaded once and each ps[s] once instead of
+  // three and two passes per shift.
+  ////////////////////////////////////////////////////////////////////////
+  static void MultiShiftUpdate(RealD a, const Field &r, Field &p,
+			       std::vector<Field> &ps, std::vector<Field> &psi,
+			       const std::vector<RealD> &cpsi,
+			       const std::vector<RealD> &cr,
+			       const std::vector<RealD> &cps)
+  {
+    typedef decltype(ps[0].View(AcceleratorWrite)) View;
+    GridBase *grid = r.Grid();
+    int nshift = ps.size();
+
+    Vector<View> ps_v;  ps_v.reserve(nshift);
+    Vector<View> psi_v; psi_v.reserve(nshift);
+    Vector<RealD> coeff(3*nshift);
+    for(int s=0;s<nshift;s++){
+      ps_v.push_back(ps[s].View(AcceleratorWrite));
+      psi_v.push_back(psi[s].View(AcceleratorWrite));
+      coeff[3*s+0] = cpsi[s];
+      coeff[3*s+1] = cr[s];
+      coeff[3*s+2] = cps[s];
+    }
+    View  *ps_p  = &ps_v[0];
+    View  *psi_p = &psi_v[0];
+    RealD *c_p   = &coeff[0];
+
+    autoView( r_v , r, AcceleratorRead);
+    autoView( p_v , p, AcceleratorWrite);
+    const uint64_t Nsimd = grid->Nsimd();
+    accelerator_for(ss, grid->oSites(), Nsimd, {
+      auto rr = r_v(ss);
+      if ( a != 0.0 ) coalescedWrite(p_v[ss], a*p_v(ss) + rr);
+      for(int s=0;s<nshift;s++){
+	RealD cpsi_s = c_p[3*s+0];
+	RealD cr_s   = c_p[3*s+1];
+	RealD cps_s  = c_p[3*s+2];
+	if ( (cpsi_s != 0.0) || (cr_s != 0.0) ) {
+	  auto pss = ps_p[s](ss);
+	  if ( cpsi_s != 0.0 ) coalescedWrite(psi_p[s][ss], psi_p[s](ss) + cpsi_s*pss);
+	  if ( cr_s   != 0.0 ) coalescedWrite(ps_p[s][ss], cr_s*rr + cps_s*pss);
+	}
+      }
+    });
+
+    for(int s=0;s<nshift;s++){
+      ps_v[s].ViewClose();
+      psi_v[s].ViewClose();
+    }
+  }
+
   void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &psi)
   {
   
@@ -196,31 +255,32 @@ public:
     // Iteration loop
     int k;
   
+    // Solution updates of the previous iteration are deferred and fused
+    // with the search direction updates of the next
+    std::vector<RealD> cpsi(nshift,0.0);
+    std::vector<RealD> cr(nshift,0.0);
+    std::vector<RealD> cps(nshift,0.0);
+
     for (k=1;k<=MaxIterations;k++){
     
       a = c /cp;
-    AXPYTimer.Start();
-      axpy(p,a,p,r);
-    AXPYTimer.Stop();
-    
-      // Note to self - direction ps is iterated seperately
-      // for each shift. Does not appear to have any scope
-      // for avoiding linear algebra in "single" case.
-      // 
-      // However SAME r is used. Could load "r" and update
-      // ALL ps[s]. 2/3 Bandwidth saving
-      // New Kernel: Load r, vector of coeffs, vector of pointers ps
     AXPYTimer.Start();
       for(int s=0;s<nshift;s++){
 	if ( ! converged[s] ) { 
 	  if (s==0){
-	    axpy(ps[s],a,ps[s],r);
+	    cr[s]  = 1.0;
+	    cps[s] = a;
 	  } else{
 	    RealD as =a *z[s][iz]*bs[s] /(z[s][1-iz]*b);
-	    axpby(ps[s],z[s][iz],as,r,ps[s]);
+	    cr[s]  = z[s][iz];
+	    cps[s] = as;
 	  }
+	} else {
+	  cr[s]  = 0.0;
+	  cps[s] = 0.0;
 	}
       }
+      MultiShiftUpdate(a,r,p,ps,psi,cpsi,cr,cps);
     AXPYTimer.Stop();
     
       cp=c;
@@ -260,24 +320,9 @@ public:
       }
     ShiftTimer.Stop();
     
+      // psi[s] -= bs[s] ps[s], applied in the next sweep
       for(int s=0;s<nshift;s++){
-	int ss = s;
-	// Scope for optimisation here in case of "single".
-	// Could load psi[0] and pull all ps[s] in.
-	//      if ( single ) ss=primary;
-	// Bandwith saving in single case is Ls * 3 -> 2+Ls, so ~ 3x saving
-	// Pipelined CG gain:
-	//
-	// New Kernel: Load r, vector of coeffs, vector of pointers ps
-	// New Kernel: Load psi[0], vector of coeffs, vector of pointers ps
-	// If can predict the coefficient bs then we can fuse these and avoid write reread cyce
-	//  on ps[s].
-	// Before:  3 x npole  + 3 x npole
-	// After :  2 x npole (ps[s])        => 3x speed up of multishift CG.
-      
-	if( (!converged[s]) ) { 
-	  axpy(psi[ss],-bs[s]*alpha[s],ps[s],psi[ss]);
-	}
+	cpsi[s] = (!converged[s]) ? -bs[s]*alpha[s] : 0.0;
       }
     
       // Convergence checks
@@ -300,6 +345,14 @@ public:
 	}
       }
     
+      if ( all_converged || (k==MaxIterations) ) {
+	// flush the deferred solution updates
+	std::fill(cr.begin(),cr.end(),0.0);
+    AXPYTimer.Start();
+	MultiShiftUpdate(0.0,r,p,ps,psi,cpsi,cr,cps);
+    AXPYTimer.Stop();
+      }
+
       if ( all_converged ){
 
     SolverTimer.Stop();
@@ -326,6 +379,7 @@ public:
       std::cout << GridLogMessage << "\tShift    " << ShiftTimer.Elapsed()     <<std::endl;
 
       IterationsToComplete = k;	
+      SolverIterationCounter::Add(k);
 
 	return;
       }
@@ -333,6 +387,7 @@ public:
    
     }
     // ugly hack
+    SolverIterationCounter::Add(MaxIterations);
     std::cout<<GridLogMessage<<"CG multi shift did not converge"<<std::endl;
     //  assert(0);
   }
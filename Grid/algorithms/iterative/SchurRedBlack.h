@@ -435,6 +435,30 @@ namespace Grid {
     }
   };
 
+  ///////////////////////////////////////////////////////////////////////////////////////////////////////
+  // As SchurRedBlackDiagMooeeSolve, but the hermitian solve runs on SchurDiagMooeeFusedOperator.
+  // Matrices with a fused Schur kernel (Cayley) use it; others compose the same sequence.
+  ///////////////////////////////////////////////////////////////////////////////////////////////////////
+  template<class Field> class SchurRedBlackDiagMooeeFusedSolve : public SchurRedBlackDiagMooeeSolve<Field> {
+  public:
+    typedef CheckerBoardedSparseMatrixBase<Field> Matrix;
+
+    SchurRedBlackDiagMooeeFusedSolve(OperatorFunction<Field> &HermitianRBSolver, const bool initSubGuess = false,
+        const bool _solnAsInitGuess = false)  
+      : SchurRedBlackDiagMooeeSolve<Field> (HermitianRBSolver,initSubGuess,_solnAsInitGuess) {};
+
+    virtual void RedBlackSolve   (Matrix & _Matrix,const Field &src_o, Field &sol_o)
+    {
+      SchurDiagMooeeFusedOperator<Matrix,Field> _HermOpEO(_Matrix);
+      this->_HermitianRBSolver(_HermOpEO,src_o,sol_o);  assert(sol_o.Checkerboard()==Odd);
+    };
+    virtual void RedBlackSolve   (Matrix & _Matrix,const std::vector<Field> &src_o,  std::vector<Field> &sol_o)
+    {
+      SchurDiagMooeeFusedOperator<Matrix,Field> _HermOpEO(_Matrix);
+      this->_HermitianRBSolver(_HermOpEO,src_o,sol_o); 
+    }
+  };
+
   template<class Field> class NonHermitianSchurRedBlackDiagMooeeSolve : public SchurRedBlackBase<Field> 
   {
     public:
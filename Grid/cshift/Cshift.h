@@ -59,4 +59,6 @@ auto Cshift(const Expression &expr,int dim,int shift)  -> decltype(closure(expr)
 }
 NAMESPACE_END(Grid);
 
+#include <Grid/cshift/Cshift_many.h>
+
 #endif
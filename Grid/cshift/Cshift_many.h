@@ -0,0 +1,136 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./Grid/cshift/Cshift_many.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <mutex>
+#include <Grid/stencil/GeneralLocalStencil.h>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Several shifts of one field with a single halo exchange.
+//
+//   CshiftMany(rhs,{{mu,+1},{mu,-1},{nu,+1}},outs);
+//
+// gives outs[i] = Cshift(rhs,shifts[i].first,shifts[i].second), but gathers
+// the planes of all the shifts together, exchanges them in one set of
+// messages (one per neighbouring rank) through a GeneralStencil, and writes
+// all the outputs in one sweep. Stencils are cached per grid geometry and
+// shift set. Checkerboarded fields fall back to Cshift.
+////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+std::shared_ptr<GeneralStencil<vobj> > CshiftManyStencil(GridBase *grid,const std::vector<std::pair<int,int> > &shifts)
+{
+  // The layout is part of the key, so a grid reallocated at the same address
+  // with a different geometry cannot hit a stale stencil. One with the same
+  // geometry can, which is safe: the stencil tables depend only on the geometry,
+  // and HaloExchange communicates through the grid of the field it is given.
+  std::vector<int> key({grid->ThisRank()});
+  for(int d=0;d<grid->Nd();d++){
+    key.push_back(grid->_fdimensions[d]);
+    key.push_back(grid->_simd_layout[d]);
+    key.push_back(grid->_processors[d]);
+    key.push_back(grid->_processor_coor[d]);
+  }
+  std::vector<Coordinate> points;
+  for(auto &s : shifts){
+    int fd = grid->_fdimensions[s.first];
+    Coordinate shift(grid->Nd(),0);
+    shift[s.first] = ((s.second % fd) + fd) % fd;
+    points.push_back(shift);
+    key.push_back(s.first);
+    key.push_back(shift[s.first]);
+  }
+
+  // Callers hold a shared_ptr for the duration of their exchange, so a
+  // stencil dropped from a full cache by another thread stays alive until
+  // they are done with it
+  typedef std::pair<GridBase *,std::vector<int> > Key;
+  static std::map<Key,std::shared_ptr<GeneralStencil<vobj> > > cache;
+  static std::mutex cache_mutex;
+  static const int max_cached = 16;
+
+  std::unique_lock<std::mutex> lock(cache_mutex);
+  Key k(grid,key);
+  auto it = cache.find(k);
+  if ( it != cache.end() ) return it->second;
+
+  if ( cache.size() >= max_cached ) cache.clear();
+  std::shared_ptr<GeneralStencil<vobj> > st = std::make_shared<GeneralStencil<vobj> >(grid,points);
+  cache[k] = st;
+  return st;
+}
+
+template<class vobj>
+void CshiftMany(const Lattice<vobj> &rhs,const std::vector<std::pair<int,int> > &shifts,std::vector<Lattice<vobj> > &outs)
+{
+  GridBase *grid = rhs.Grid();
+  int npoints    = shifts.size();
+  assert(outs.size()==shifts.size());
+  for(int p=0;p<npoints;p++) conformable(grid,outs[p].Grid());
+
+  if ( grid->_isCheckerBoarded ) {
+    for(int p=0;p<npoints;p++) outs[p] = Cshift(rhs,shifts[p].first,shifts[p].second);
+    return;
+  }
+
+  std::shared_ptr<GeneralStencil<vobj> > stencil = CshiftManyStencil<vobj>(grid,shifts);
+  GeneralStencil<vobj> &st = *stencil;
+  st.HaloExchange(rhs);
+
+  typedef LatticeView<vobj> View;
+  Vector<View> OutViewContainer;
+  for(int p=0;p<npoints;p++) {
+    outs[p].Checkerboard() = rhs.Checkerboard();
+    OutViewContainer.push_back(outs[p].View(AcceleratorWrite));
+  }
+  View *out_p = &OutViewContainer[0];
+  {
+    autoView( st_v , st, AcceleratorRead);
+    autoView( rhs_v, rhs, AcceleratorRead);
+    uint64_t osites = grid->oSites();
+    accelerator_for(ss, osites, vobj::Nsimd(), {
+      for(int p=0;p<npoints;p++){
+	auto SE = st_v.GetEntry(p,ss);
+	if ( SE->_is_local ) coalescedWrite(out_p[p][ss],coalescedReadGeneralPermute(rhs_v[SE->_offset],SE->_permute));
+	else                 coalescedWrite(out_p[p][ss],coalescedRead(st_v.CommBuf()[SE->_offset]));
+      }
+    });
+  }
+  for(int p=0;p<npoints;p++) OutViewContainer[p].ViewClose();
+}
+
+template<class vobj>
+std::vector<Lattice<vobj> > CshiftMany(const Lattice<vobj> &rhs,const std::vector<std::pair<int,int> > &shifts)
+{
+  std::vector<Lattice<vobj> > outs(shifts.size(),rhs.Grid());
+  CshiftMany(rhs,shifts,outs);
+  return outs;
+}
+
+NAMESPACE_END(Grid);
@@ -41,6 +41,8 @@
 #undef  RNG_FAST_DISCARD
 #endif
 
+#include <Grid/lattice/Lattice_rng_philox.h>
+
 NAMESPACE_BEGIN(Grid);
 
 //////////////////////////////////////////////////////////////
@@ -146,6 +148,30 @@ public:
   std::vector<std::discrete_distribution<int32_t> >   _bernoulli;
   std::vector<std::uniform_int_distribution<uint32_t> > _uid;
 
+  ///////////////////////
+  // Counter based mode (--rng-counter): Philox4x32 keyed by the seeds and
+  // counted by (site, draw). No per site engines, no skip ahead and no
+  // broadcast of serial draws; reproducible under any decomposition.
+  ///////////////////////
+  static int UseCounterBased;  // mode for RNGs constructed afterwards
+
+  bool     _counter_based;
+  uint32_t _counter_key[2];
+  uint64_t _counter_draw;
+
+  GridRNGbase() : _counter_based(UseCounterBased), _counter_draw(0) {
+    _counter_key[0] = 0;
+    _counter_key[1] = 0;
+  }
+
+  bool CounterBased(void) const { return _counter_based; }
+
+  void SeedCounterBased(const std::vector<int> &seeds) {
+    std::seed_seq src(seeds.begin(),seeds.end());
+    src.generate(&_counter_key[0],&_counter_key[2]);
+    _counter_draw = 0;
+  }
+
   ///////////////////////
   // support for parallel init
   ///////////////////////
@@ -211,6 +237,17 @@ public:
     }
   }
   void GetState(std::vector<RngStateType> & saved,int gen) {
+    if ( _counter_based ) {
+      // Key and draw number replicated in every site record; checkpoints keep their layout
+      saved.resize(RngStateCount);
+      for(int i=0;i<RngStateCount;i++) saved[i]=0;
+      saved[0] = _counter_key[0];
+      saved[1] = _counter_key[1];
+      saved[2] = (uint32_t)_counter_draw;
+      saved[3] = (uint32_t)(_counter_draw>>32);
+      saved[4] = CounterStateTag;
+      return;
+    }
     GetState(saved,_generators[gen]);
   }
   void SetState(std::vector<RngStateType> & saved,RngEngine &eng){
@@ -223,6 +260,16 @@ public:
     ss>>eng;
   }
   void SetState(std::vector<RngStateType> & saved,int gen){
+    if ( _counter_based ) {
+      assert(saved.size()==RngStateCount);
+      assert(saved[4]==CounterStateTag);
+      if ( gen==0 ) { // identical in every record; one writer avoids a race under thread_for
+	_counter_key[0] = saved[0];
+	_counter_key[1] = saved[1];
+	_counter_draw   = ((uint64_t)saved[3]<<32) | (uint64_t)(uint32_t)saved[2];
+      }
+      return;
+    }
     SetState(saved,_generators[gen]);
   }
   void SetEngine(RngEngine &Eng, int gen){
@@ -235,6 +282,8 @@ public:
   {
     _generators[gen] = RngEngine(src);
   }    
+
+  static const uint32_t CounterStateTag = 0x50484C58; // "PHLX"
 };
 
 class GridSerialRNG : public GridRNGbase {
@@ -248,6 +297,23 @@ public:
     _uid.resize(1,std::uniform_int_distribution<uint32_t>() );
   }
 
+  // Every rank draws the same words; stateful engines draw on one rank and broadcast,
+  // the counter based stream is identical everywhere and needs no communication.
+  template <class scalar,class distribution> inline void fillWords(scalar *buf,int words,std::vector<distribution> &dist){
+    dist[0].reset();
+    if ( _counter_based ) {
+      PhiloxStream gen(_counter_key,Philox4x32::SerialSite,_counter_draw++);
+      for(int idx=0;idx<words;idx++){
+	fillScalar(buf[idx],dist[0],gen);
+      }
+    } else {
+      for(int idx=0;idx<words;idx++){
+	fillScalar(buf[idx],dist[0],_generators[0]);
+      }
+      CartesianCommunicator::BroadcastWorld(0,(void *)buf,sizeof(scalar)*words);
+    }
+  }
+
   template <class sobj,class distribution> inline void fill(sobj &l,std::vector<distribution> &dist){
 
     typedef typename sobj::scalar_type scalar_type;
@@ -256,71 +322,41 @@ public:
 
     scalar_type *buf = (scalar_type *) & l;
 
-    dist[0].reset();
-    for(int idx=0;idx<words;idx++){
-      fillScalar(buf[idx],dist[0],_generators[0]);
-    }
-
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
-
+    fillWords(buf,words,dist);
   }
 
   template <class distribution>  inline void fill(ComplexF &l,std::vector<distribution> &dist){
-    dist[0].reset();
-    fillScalar(l,dist[0],_generators[0]);
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords(&l,1,dist);
   }
   template <class distribution>  inline void fill(ComplexD &l,std::vector<distribution> &dist){
-    dist[0].reset();
-    fillScalar(l,dist[0],_generators[0]);
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords(&l,1,dist);
   }
   template <class distribution>  inline void fill(RealF &l,std::vector<distribution> &dist){
-    dist[0].reset();
-    fillScalar(l,dist[0],_generators[0]);
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords(&l,1,dist);
   }
   template <class distribution>  inline void fill(RealD &l,std::vector<distribution> &dist){
-    dist[0].reset();
-    fillScalar(l,dist[0],_generators[0]);
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords(&l,1,dist);
   }
   // vector fill
   template <class distribution>  inline void fill(vComplexF &l,std::vector<distribution> &dist){
-    RealF *pointer=(RealF *)&l;
-    dist[0].reset();
-    for(int i=0;i<2*vComplexF::Nsimd();i++){
-      fillScalar(pointer[i],dist[0],_generators[0]);
-    }
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords((RealF *)&l,2*vComplexF::Nsimd(),dist);
   }
   template <class distribution>  inline void fill(vComplexD &l,std::vector<distribution> &dist){
-    RealD *pointer=(RealD *)&l;
-    dist[0].reset();
-    for(int i=0;i<2*vComplexD::Nsimd();i++){
-      fillScalar(pointer[i],dist[0],_generators[0]);
-    }
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords((RealD *)&l,2*vComplexD::Nsimd(),dist);
   }
   template <class distribution>  inline void fill(vRealF &l,std::vector<distribution> &dist){
-    RealF *pointer=(RealF *)&l;
-    dist[0].reset();
-    for(int i=0;i<vRealF::Nsimd();i++){
-      fillScalar(pointer[i],dist[0],_generators[0]);
-    }
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords((RealF *)&l,vRealF::Nsimd(),dist);
   }
   template <class distribution>  inline void fill(vRealD &l,std::vector<distribution> &dist){
-    RealD *pointer=(RealD *)&l;
-    dist[0].reset();
-    for(int i=0;i<vRealD::Nsimd();i++){
-      fillScalar(pointer[i],dist[0],_generators[0]);
-    }
-    CartesianCommunicator::BroadcastWorld(0,(void *)&l,sizeof(l));
+    fillWords((RealD *)&l,vRealD::Nsimd(),dist);
   }
     
   void SeedFixedIntegers(const std::vector<int> &seeds){
     CartesianCommunicator::BroadcastWorld(0,(void *)&seeds[0],sizeof(int)*seeds.size());
+    if ( _counter_based ) {
+      SeedCounterBased(seeds);
+      return;
+    }
     std::seed_seq src(seeds.begin(),seeds.end());
     Seed(src,0);
   }
@@ -355,15 +391,24 @@ public:
     _grid = grid;
     _vol  =_grid->iSites()*_grid->oSites();
 
-    _generators.resize(_vol);
-    _uniform.resize(_vol,std::uniform_real_distribution<RealD>{0,1});
-    _gaussian.resize(_vol,std::normal_distribution<RealD>(0.0,1.0) );
-    _bernoulli.resize(_vol,std::discrete_distribution<int32_t>{1,1});
-    _uid.resize(_vol,std::uniform_int_distribution<uint32_t>() );
+    // Counter based mode keeps no per site state; dist[0] carries the parameters
+    int nstate = _counter_based ? 1 : _vol;
+    if ( !_counter_based ) _generators.resize(_vol);
+    _uniform.resize(nstate,std::uniform_real_distribution<RealD>{0,1});
+    _gaussian.resize(nstate,std::normal_distribution<RealD>(0.0,1.0) );
+    _bernoulli.resize(nstate,std::discrete_distribution<int32_t>{1,1});
+    _uid.resize(nstate,std::uniform_int_distribution<uint32_t>() );
   }
 
   template <class vobj,class distribution> inline void fill(Lattice<vobj> &l,std::vector<distribution> &dist){
 
+    if ( _counter_based ) {
+      double inner_time_counter = usecond();
+      fillCounter(l,dist[0]);
+      _time_counter += usecond()- inner_time_counter;
+      return;
+    }
+
     typedef typename vobj::scalar_object scalar_object;
     typedef typename vobj::scalar_type scalar_type;
     typedef typename vobj::vector_type vector_type;
@@ -399,6 +444,184 @@ public:
     _time_counter += usecond()- inner_time_counter;
   }
 
+  ////////////////////////////////////////////////////////////////////////
+  // Counter based fill. Every lane is keyed by the global site index in
+  // the field's own grid, so the numbers are independent of the processor
+  // and SIMD decomposition, and of the grid used to construct the RNG.
+  ////////////////////////////////////////////////////////////////////////
+  // The global index is linear in the outer and inner coordinates, so it is
+  // a per site base plus a per lane offset; the offsets are set up once per fill.
+  static inline void GlobalLaneOffsets(GridBase *grid,int Nsimd,uint64_t *off)
+  {
+    Coordinate icoor;
+    for(int lane=0;lane<Nsimd;lane++){
+      grid->iCoorFromIindex(icoor,lane);
+      uint64_t o=0, mult=1;
+      for(int d=0;d<grid->Nd();d++) {
+	o   += mult*icoor[d]*grid->_rdimensions[d];
+	mult*= grid->_gdimensions[d];
+      }
+      off[lane]=o;
+    }
+  }
+  static inline uint64_t GlobalSiteBase(GridBase *grid,int ss)
+  {
+    Coordinate ocoor;
+    grid->oCoorFromOindex(ocoor,ss);
+    uint64_t base=0, mult=1;
+    for(int d=0;d<grid->Nd();d++) {
+      base += mult*(ocoor[d]+grid->_lstart[d]);
+      mult *= grid->_gdimensions[d];
+    }
+    return base;
+  }
+
+  // Any distribution: one Philox stream per lane
+  template <class vobj,class distribution> inline void fillCounter(Lattice<vobj> &l,distribution &dist0){
+
+    typedef typename vobj::scalar_object scalar_object;
+    typedef typename vobj::scalar_type scalar_type;
+    typedef typename vobj::vector_type vector_type;
+
+    // Real fields on a complex layout repeat each grid lane; merge duplicates
+    const int Nsimd = vector_type::Nsimd();
+    GridBase *grid = l.Grid();
+    int lanes  = grid->Nsimd();
+    int osites = grid->oSites();
+    int words  = sizeof(scalar_object) / sizeof(scalar_type);
+    uint64_t draw = _counter_draw++;
+
+    uint64_t laneoff[Nsimd];
+    GlobalLaneOffsets(grid,lanes,laneoff);
+
+    autoView(l_v, l, CpuWrite);
+    thread_for( ss, osites, {
+      ExtractBuffer<scalar_object> buf(lanes);
+      uint64_t base = GlobalSiteBase(grid,ss);
+      for (int si = 0; si < lanes; si++) {
+	distribution dist(dist0);
+	PhiloxStream gen(_counter_key,base+laneoff[si],draw);
+	scalar_type *pointer = (scalar_type *)&buf[si];
+	for (int idx = 0; idx < words; idx++) 
+	  fillScalar(pointer[idx], dist, gen);
+      }
+      merge(l_v[ss], buf);
+    });
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Uniform and gaussian: each Philox block gives two reals. The (block,lane)
+  // counters of a site are generated and transformed Philox4x32::Batch at a
+  // time in straight line lane loops, and the results are stored directly
+  // into the SIMD lanes of the vector object, with no extract/merge.
+  ////////////////////////////////////////////////////////////////////////
+  struct UniformTransform {
+    RealD a, b;
+    template<int N> inline void apply(RealD *x1,RealD *x2) const {
+      for(int j=0;j<N;j++){
+	x1[j] = a + (b-a)*x1[j];
+	x2[j] = a + (b-a)*x2[j];
+      }
+    }
+  };
+  struct BoxMullerTransform {
+    RealD mean, sigma;
+    template<int N> inline void apply(RealD *x1,RealD *x2) const {
+      RandomTransforms::BoxMuller<N>(x1,x2);
+      for(int j=0;j<N;j++){
+	x1[j] = mean + sigma*x1[j];
+	x2[j] = mean + sigma*x2[j];
+      }
+    }
+  };
+  template <class vobj> inline void fillCounter(Lattice<vobj> &l,std::uniform_real_distribution<RealD> &dist){
+    typedef typename GridTypeMapper<typename vobj::scalar_type>::Realified real;
+    UniformTransform T;
+    T.a = dist.a();
+    T.b = dist.b();
+    fillCounterPairs(l,dist,T,std::integral_constant<bool,std::is_floating_point<real>::value>());
+  }
+  template <class vobj> inline void fillCounter(Lattice<vobj> &l,std::normal_distribution<RealD> &dist){
+    typedef typename GridTypeMapper<typename vobj::scalar_type>::Realified real;
+    BoxMullerTransform T;
+    T.mean  = dist.mean();
+    T.sigma = dist.stddev();
+    fillCounterPairs(l,dist,T,std::integral_constant<bool,std::is_floating_point<real>::value>());
+  }
+  // integer fields take the generic path
+  template <class vobj,class distribution,class transform> 
+  inline void fillCounterPairs(Lattice<vobj> &l,distribution &dist,transform &T,std::false_type){
+    fillCounter<vobj,distribution>(l,dist);
+  }
+  template <class vobj,class distribution,class transform> 
+  inline void fillCounterPairs(Lattice<vobj> &l,distribution &dist,transform &T,std::true_type){
+
+    typedef typename vobj::scalar_type scalar_type;
+    typedef typename vobj::vector_type vector_type;
+    typedef typename GridTypeMapper<scalar_type>::Realified real;
+
+    const int Nsimd = vector_type::Nsimd();
+    const int Batch = Philox4x32::Batch;
+    const int cplx  = sizeof(scalar_type) / sizeof(real);
+    GridBase *grid = l.Grid();
+    int lanes  = grid->Nsimd();           // a real field on a complex layout
+    int dup    = Nsimd / lanes;           // holds each grid lane dup times
+    int osites = grid->oSites();
+    int nreal  = cplx * sizeof(vobj) / sizeof(vector_type);
+    int ncount = lanes * ((nreal+1)/2);   // (block,lane) pairs per site
+    int spg    = std::max(1,Batch/ncount); // small objects batch several sites
+    uint64_t ngroup = (osites+spg-1)/spg;
+    uint32_t draw_lo = (uint32_t)_counter_draw;
+    uint32_t draw_hi = (uint32_t)(_counter_draw>>32);
+    _counter_draw++;
+
+    uint64_t laneoff[Nsimd];
+    GlobalLaneOffsets(grid,lanes,laneoff);
+
+    autoView(l_v, l, CpuWrite);
+    thread_for( g, ngroup, {
+      uint64_t base[Batch];
+      uint32_t ctr[4][Batch];
+      RealD x1[Batch], x2[Batch];
+      int s0 = g*spg;
+      int ns = std::min(spg,osites-s0);
+      for(int s=0;s<ns;s++) base[s] = GlobalSiteBase(grid,s0+s);
+      int total = ns*ncount;
+      for(int j0=0;j0<total;j0+=Batch){
+	for(int j=0;j<Batch;j++){
+	  int jj = std::min(j0+j,total-1);    // the tail of the last batch is padding
+	  int c  = jj % ncount;
+	  uint64_t site = base[jj / ncount] + laneoff[c % lanes];
+	  ctr[0][j] = Philox4x32::BlockWord(c / lanes, site);
+	  ctr[1][j] = (uint32_t)site;
+	  ctr[2][j] = draw_lo;
+	  ctr[3][j] = draw_hi;
+	}
+	Philox4x32::Blocks<Batch>(ctr,_counter_key);
+	for(int j=0;j<Batch;j++){
+	  x1[j] = Philox4x32::Uniform(ctr[0][j],ctr[1][j]);
+	  x2[j] = Philox4x32::Uniform(ctr[2][j],ctr[3][j]);
+	}
+	T.template apply<Batch>(x1,x2);
+	int jmax = std::min(Batch,total-j0);
+	for(int j=0;j<jmax;j++){
+	  int c    = (j0+j) % ncount;
+	  real *out= (real *)&l_v[s0 + (j0+j)/ncount];
+	  int r    = 2*(c / lanes);           // real index within the scalar object
+	  for(int d=0;d<dup;d++){
+	    int lane = (c % lanes)*dup + d;
+	    out[LaneOffset(r,lane,Nsimd,cplx)] = x1[j];
+	    if ( r+1 < nreal ) out[LaneOffset(r+1,lane,Nsimd,cplx)] = x2[j];
+	  }
+	}
+      }
+    });
+  }
+  // Offset in reals of real number r of the scalar object in SIMD lane "lane"
+  static accelerator_inline int LaneOffset(int r,int lane,int Nsimd,int cplx) {
+    return ((r/cplx)*Nsimd + lane)*cplx + (r%cplx);
+  }
+
     void SeedUniqueString(const std::string &s){
       std::vector<int> seeds;
       seeds = GridChecksum::sha256_seeds(s);
@@ -412,6 +635,11 @@ public:
     // Everyone generates the same seed_seq based on input seeds
     CartesianCommunicator::BroadcastWorld(0,(void *)&seeds[0],sizeof(int)*seeds.size());
 
+    if ( _counter_based ) {
+      SeedCounterBased(seeds);
+      return;
+    }
+
     std::seed_seq source(seeds.begin(),seeds.end());
 
     RngEngine master_engine(source);
@@ -494,6 +722,12 @@ public:
   uint32_t GlobalU01(int gsite){
 
     uint32_t the_number;
+
+    if ( _counter_based ) { // same on every rank, nothing to share
+      PhiloxStream gen(_counter_key,gsite,_counter_draw++);
+      return gen();
+    }
+
     // who
     int rank,o_idx,i_idx;
     Coordinate gcoor;
@@ -0,0 +1,251 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/lattice/Lattice_rng_philox.h
+
+    Copyright (C) 2015
+
+    Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_LATTICE_RNG_PHILOX_H
+#define GRID_LATTICE_RNG_PHILOX_H
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////
+// Philox4x32-10 counter based generator
+// J. Salmon, M. Moraes, R. Dror, D. Shaw, "Parallel random numbers: as easy as 1, 2, 3", SC11
+//
+// The output is a pure function of a 128 bit counter and a 64 bit key, so there
+// is no state to store, skip or broadcast. Grid uses the counter as
+//
+//   ctr[0] : block number within one draw; bits 16-31 hold bits 32-47 of the site
+//   ctr[1] : global site index, low word (0xFFFFFFFF for the serial stream)
+//   ctr[2] : draw number, low word
+//   ctr[3] : draw number, high word
+//
+// so volumes up to 2^48 sites and up to 2^16 blocks per site and draw are
+// covered, and below 2^32 sites the counter is the plain (block, site) pair.
+// and the key is derived from the seeds. Every fill() is one draw.
+//////////////////////////////////////////////////////////////////////////////
+class Philox4x32 {
+public:
+  static const int      Rounds = 10;
+  static const uint32_t M0 = 0xD2511F53;
+  static const uint32_t M1 = 0xCD9E8D57;
+  static const uint32_t W0 = 0x9E3779B9;
+  static const uint32_t W1 = 0xBB67AE85;
+  static const uint32_t SerialSite = 0xFFFFFFFF;
+  static const int      Batch = 16;      // counters per vectorised call
+
+  static accelerator_inline void Round(uint32_t ctr[4], const uint32_t key[2])
+  {
+    uint64_t p0 = (uint64_t)M0 * (uint64_t)ctr[0];
+    uint64_t p1 = (uint64_t)M1 * (uint64_t)ctr[2];
+    uint32_t hi0 = (uint32_t)(p0 >> 32), lo0 = (uint32_t)p0;
+    uint32_t hi1 = (uint32_t)(p1 >> 32), lo1 = (uint32_t)p1;
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+  }
+
+  // In place: counter in, random bits out
+  static accelerator_inline void Block(uint32_t ctr[4], const uint32_t key_in[2])
+  {
+    uint32_t key[2] = { key_in[0], key_in[1] };
+    for (int r = 0; r < Rounds; r++) {
+      if (r) { key[0] += W0; key[1] += W1; }
+      Round(ctr, key);
+    }
+  }
+
+  // One block for each of N lanes. The rounds are unrolled inside the lane
+  // loop, leaving a straight line body the compiler vectorises across lanes.
+  template<int N> static inline void Blocks(uint32_t ctr[4][N], const uint32_t key_in[2])
+  {
+    for (int l = 0; l < N; l++) {
+      uint32_t c[4] = { ctr[0][l], ctr[1][l], ctr[2][l], ctr[3][l] };
+      Block(c, key_in);
+      ctr[0][l] = c[0];
+      ctr[1][l] = c[1];
+      ctr[2][l] = c[2];
+      ctr[3][l] = c[3];
+    }
+  }
+
+  static accelerator_inline uint32_t BlockWord(uint32_t block, uint64_t site)
+  {
+    return block | ((uint32_t)(site >> 32) << 16);
+  }
+  static accelerator_inline void Counter(uint32_t ctr[4], uint32_t block, uint64_t site, uint64_t draw)
+  {
+    ctr[0] = BlockWord(block, site);
+    ctr[1] = (uint32_t)site;
+    ctr[2] = (uint32_t)draw;
+    ctr[3] = (uint32_t)(draw >> 32);
+  }
+
+  // Uniform in the open interval (0,1), resolution 2^-52; safe to take the log of.
+  // Built by bit manipulation rather than an integer to double conversion, which
+  // has no SIMD form for 64 bit integers before AVX512.
+  static accelerator_inline RealD Uniform(uint32_t hi, uint32_t lo)
+  {
+    uint64_t bits = ((((uint64_t)hi) << 32) | lo) >> 12;
+    bits |= 0x3FF0000000000000ULL;   // [1,2)
+    RealD d;
+    memcpy(&d,&bits,sizeof(d));
+    return (d - 1.0) + 1.0/9007199254740992.0;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Branch free log and sincos for the uniform -> gaussian transform. Only
+// +,*,/, 32 bit integer conversion and bit manipulation are used, so a loop
+// over lanes calling these vectorises without -ffast-math, and every lane
+// gets the same bits whatever the SIMD layout. Accurate to a few ulp on the
+// ranges used.
+//////////////////////////////////////////////////////////////////////////////
+class RandomTransforms {
+public:
+  // log(u) for u in (0,1]
+  static accelerator_inline RealD LogUnit(RealD u)
+  {
+    uint64_t bits;
+    memcpy(&bits,&u,sizeof(bits));
+    // exponent as a double: 2^52 + biased exponent, minus 2^52 + bias
+    uint64_t ebits = (bits >> 52) | 0x4330000000000000ULL;
+    RealD e;
+    memcpy(&e,&ebits,sizeof(e));
+    e = e - (4503599627370496.0 + 1023.0);
+    bits = (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+    RealD m;
+    memcpy(&m,&bits,sizeof(m));
+    // m in [1,2) folded to [1/sqrt2,sqrt2)
+    RealD big = (m > M_SQRT2) ? 1.0 : 0.0;
+    m = m - 0.5*big*m;
+    e = e + big;
+    // log(m) = 2 atanh(s), |s| < 0.172
+    RealD f = m - 1.0;
+    RealD s = f / (2.0 + f);
+    RealD z = s*s;
+    RealD p = 2.0/19.0;
+    p = p*z + 2.0/17.0;
+    p = p*z + 2.0/15.0;
+    p = p*z + 2.0/13.0;
+    p = p*z + 2.0/11.0;
+    p = p*z + 2.0/9.0;
+    p = p*z + 2.0/7.0;
+    p = p*z + 2.0/5.0;
+    p = p*z + 2.0/3.0;
+    p = p*z + 2.0;
+    return e*M_LN2 + s*p;
+  }
+
+  // sin and cos of 2 pi t for t in [0,1]
+  static accelerator_inline void SinCos2Pi(RealD t,RealD &sn,RealD &cs)
+  {
+    int q = (int)(4.0*t + 0.5);           // quadrant, reduction is exact
+    RealD x  = (t - 0.25*q) * (2.0*M_PI); // |x| <= pi/4
+    RealD x2 = x*x;
+    RealD ps = 1.0 - x2/210.0;
+    ps = 1.0 - x2/156.0*ps;
+    ps = 1.0 - x2/110.0*ps;
+    ps = 1.0 - x2/72.0*ps;
+    ps = 1.0 - x2/42.0*ps;
+    ps = 1.0 - x2/20.0*ps;
+    ps = 1.0 - x2/6.0*ps;
+    ps = x*ps;
+    RealD pc = 1.0 - x2/240.0;
+    pc = 1.0 - x2/182.0*pc;
+    pc = 1.0 - x2/132.0*pc;
+    pc = 1.0 - x2/90.0*pc;
+    pc = 1.0 - x2/56.0*pc;
+    pc = 1.0 - x2/30.0*pc;
+    pc = 1.0 - x2/12.0*pc;
+    pc = 1.0 - x2/2.0*pc;
+    bool  odd   = q & 1;
+    bool  s_neg = q & 2;
+    bool  c_neg = (q + 1) & 2;
+    RealD a = odd ? pc : ps;
+    RealD b = odd ? ps : pc;
+    sn = s_neg ? -a : a;
+    cs = c_neg ? -b : b;
+  }
+
+  // N pairs of uniforms in (0,1) replaced by N pairs of unit gaussians. The
+  // sqrt is kept in a loop of its own; with errno semantics it is a call that
+  // would otherwise stop the main loop vectorising.
+  template<int N> static inline void BoxMuller(RealD *x1,RealD *x2)
+  {
+    RealD r[N];
+    for(int j=0;j<N;j++){
+      RealD sn,cs;
+      r[j] = -2.0*LogUnit(x1[j]);
+      SinCos2Pi(x2[j],sn,cs);
+      x1[j] = cs;
+      x2[j] = sn;
+    }
+    for(int j=0;j<N;j++) r[j] = std::sqrt(r[j]);
+    for(int j=0;j<N;j++){
+      x1[j] *= r[j];
+      x2[j] *= r[j];
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// The Philox stream for one (key, site, draw), as a UniformRandomBitGenerator
+// so any std:: distribution can be driven from it.
+//////////////////////////////////////////////////////////////////////////////
+class PhiloxStream {
+public:
+  typedef uint32_t result_type;
+  static constexpr result_type min(void) { return 0; }
+  static constexpr result_type max(void) { return 0xFFFFFFFF; }
+
+  PhiloxStream(const uint32_t key[2], uint64_t site, uint64_t draw)
+    : _site(site), _draw(draw), _block(0), _pos(4)
+  {
+    _key[0] = key[0];
+    _key[1] = key[1];
+  }
+
+  result_type operator()(void) {
+    if (_pos == 4) {
+      Philox4x32::Counter(_buf, _block++, _site, _draw);
+      Philox4x32::Block(_buf, _key);
+      _pos = 0;
+    }
+    return _buf[_pos++];
+  }
+
+private:
+  uint32_t _key[2];
+  uint64_t _site;
+  uint64_t _draw;
+  uint32_t _block;
+  uint32_t _buf[4];
+  int      _pos;
+};
+
+NAMESPACE_END(Grid);
+#endif
@@ -1422,5 +1422,121 @@ void Grid_unsplit(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Sixteen bit storage of a single precision lattice, as IEEE half or bfloat16.
+// Each site is converted word by word, so the packed field lives on the same
+// grid and SIMD layout as the original and conversion is a local streaming
+// operation, unlike the lexicographic remap needed between double and single
+// precision grids. fp16 keeps 11 mantissa bits over a narrow exponent range,
+// bfloat16 8 bits over the range of a float; Scale maps the data into range.
+// This is storage only: arithmetic is done on the unpacked single precision
+// values, in registers where kernels use UnpackSite/PackSite directly.
+////////////////////////////////////////////////////////////////////////////////
+enum HalfPrecisionFormat { HalfPrecisionFP16, HalfPrecisionBF16 };
+
+template<class vobj>
+class HalfPrecisionField {
+public:
+  static_assert(getPrecision<vobj>::value == 1, "half precision storage packs single precision fields");
+
+  static constexpr int Nf = sizeof(vobj)/sizeof(RealF);   // floats per site
+  static constexpr int Nv = sizeof(vobj)/sizeof(vRealF);  // single precision vectors per site
+  static constexpr int Nh = Nv/2;                         // two vRealF pack into one vRealH
+  static_assert((Nv&0x1)==0, "half precision storage packs pairs of single precision vectors");
+  typedef iVector<vRealH,Nh> half_object;
+
+  Lattice<half_object> Storage;
+  HalfPrecisionFormat  Format;
+  RealD                Scale;   // field = Scale * stored
+
+  HalfPrecisionField(GridBase *grid,HalfPrecisionFormat format=HalfPrecisionFP16)
+    : Storage(grid), Format(format), Scale(1.0) {};
+
+  GridBase *Grid(void) const { return Storage.Grid(); }
+  int  Checkerboard(void) const { return Storage.Checkerboard(); }
+  int &Checkerboard(void)       { return Storage.Checkerboard(); }
+
+  // Whole site conversions: the scaling is done on vRealF, and fp16 uses the
+  // vector conversion of precisionChange where the SIMD target has one. The
+  // bfloat16 lane loops are branch free bit operations that vectorise as they
+  // stand; words are stored in the order of the floats, as precisionChange does.
+  // stored = in * rscale
+  static accelerator_inline void PackSite(half_object &out,const vobj &in,HalfPrecisionFormat format,RealF rscale) {
+    const vRealF *f = (const vRealF *)&in;
+    vRealF vs; vsplat(vs,rscale);
+    vRealF tmp[Nv];
+    for(int i=0;i<Nv;i++) tmp[i] = f[i]*vs;
+    const RealF *t = (const RealF *)&tmp[0];
+    uint16_t    *h = (uint16_t *)&out;
+    if ( format == HalfPrecisionBF16 ) {
+      for(int i=0;i<Nf;i++) h[i] = sfw_float_to_bf16(t[i]);
+    } else {
+#ifdef USE_FP16
+      precisionChange((vRealH *)&out,tmp,Nv);
+#else
+      for(int i=0;i<Nf;i++) h[i] = sfw_float_to_half(t[i]).x;
+#endif
+    }
+  }
+  // out = stored * scale
+  static accelerator_inline void UnpackSite(vobj &out,const half_object &in,HalfPrecisionFormat format,RealF scale) {
+    vRealF *f = (vRealF *)&out;
+    if ( format == HalfPrecisionBF16 ) {
+      RealF          *t = (RealF *)&out;
+      const uint16_t *h = (const uint16_t *)&in;
+      for(int i=0;i<Nf;i++) t[i] = sfw_bf16_to_float(h[i]);
+    } else {
+#ifdef USE_FP16
+      precisionChange(f,(vRealH *)&in,Nv);
+#else
+      RealF          *t = (RealF *)&out;
+      const uint16_t *h = (const uint16_t *)&in;
+      for(int i=0;i<Nf;i++) t[i] = sfw_half_to_float(Grid_half(h[i]));
+#endif
+    }
+    vRealF vs; vsplat(vs,scale);
+    for(int i=0;i<Nv;i++) f[i] = f[i]*vs;
+  }
+};
+
+// Pack with the given scale; the default maps the rms word to one
+template<class vobj>
+void precisionChange(HalfPrecisionField<vobj> &out, const Lattice<vobj> &in, RealD scale=0.0)
+{
+  typedef HalfPrecisionField<vobj> HField;
+  conformable(out.Grid(),in.Grid());
+  if ( scale == 0.0 ) {
+    RealD nrm = norm2(in);
+    RealD nw  = (RealD)HField::Nf*in.Grid()->gSites()/in.Grid()->Nsimd();
+    scale = (nrm > 0.0) ? std::sqrt(nrm/nw) : 1.0;
+  }
+  out.Checkerboard() = in.Checkerboard();
+  out.Scale = scale;
+
+  HalfPrecisionFormat format = out.Format;
+  RealF rscale = 1.0/scale;
+  autoView( out_v, out.Storage, AcceleratorWrite);
+  autoView( in_v , in         , AcceleratorRead);
+  accelerator_for(ss,in.Grid()->oSites(),1,{
+    HField::PackSite(out_v[ss],in_v[ss],format,rscale);
+  });
+}
+
+template<class vobj>
+void precisionChange(Lattice<vobj> &out, const HalfPrecisionField<vobj> &in)
+{
+  typedef HalfPrecisionField<vobj> HField;
+  conformable(out.Grid(),in.Grid());
+  out.Checkerboard() = in.Checkerboard();
+
+  HalfPrecisionFormat format = in.Format;
+  RealF scale = in.Scale;
+  autoView( out_v, out       , AcceleratorWrite);
+  autoView( in_v , in.Storage, AcceleratorRead);
+  accelerator_for(ss,out.Grid()->oSites(),1,{
+    HField::UnpackSite(out_v[ss],in_v[ss],format,scale);
+  });
+}
+
 NAMESPACE_END(Grid);
 
@@ -57,6 +57,9 @@ public:
 
   virtual void Instantiatable(void) = 0;
 
+  // Mooee and MooeeInv carry the EOFA shift; use the unfused Schur operator
+  virtual int SchurFusable(void) { return 0; };
+
   // EOFA-specific operations
   // Force user to implement in derived classes
   virtual void  Omega    (const FermionField& in, FermionField& out, int sign, int dag) = 0;
@@ -114,6 +114,24 @@ public:
   void   Meooe5D       (const FermionField &in, FermionField &out);
   void   MeooeDag5D    (const FermionField &in, FermionField &out);
 
+  ///////////////////////////////////////////////////////////////
+  // Fused even-odd Schur operator Mooee - Meooe MooeeInv Meooe and its
+  // adjoint. Each half is the hopping term followed by one pass over the
+  // Ls columns applying all of its s-direction terms, in place of separate
+  // MooeeInv, Meooe5D, Mooee and axpy sweeps over the 5d vector.
+  ///////////////////////////////////////////////////////////////
+  void   MpcFused      (const FermionField &in, FermionField &out);
+  void   MpcDagFused   (const FermionField &in, FermionField &out);
+  virtual void MpcFused    (const FermionField &in, FermionField &out, FermionField &tmp, FermionField &col);
+  virtual void MpcDagFused (const FermionField &in, FermionField &out, FermionField &tmp, FermionField &col);
+
+  // Derived classes replacing the ee/oo blocks must not use the fused path
+  virtual int SchurFusable(void) { return 1; };
+
+  enum { FuseMooeeInvMeooe5D, FuseMooeeMinus, FuseMeooeDag5DMooeeInvDag, FuseMooeeDagMinus };
+  void   DhopFused5D   (const FermionField &in, const FermionField &phi,
+			FermionField &col, FermionField &out, int stage);
+
   //    protected:
   RealD mass_plus, mass_minus;
 
@@ -142,7 +160,7 @@ public:
   Vector<Coeff_t> ueem;
   Vector<Coeff_t> dee;
 
-  // Matrices of 5d ee inverse params
+  // Matrices of 5d ee inverse params, filled on first use when Ls is vectorised
   Vector<iSinglet<Simd> >  MatpInv;
   Vector<iSinglet<Simd> >  MatmInv;
   Vector<iSinglet<Simd> >  MatpInvDag;
@@ -193,7 +211,20 @@ public:
   double MooeeInvCalls;
   double MooeeInvTime;
 
+  double MpcFusedCalls;
+  double MpcFusedTime;
+
 protected:
+  // Tridiagonal s-direction coefficients of Meooe, Mooee and their adjoints
+  void Meooe5DCoeffs   (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MeooeDag5DCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MooeeCoeffs     (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MooeeDagCoeffs  (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+
+  // Dense ee inverse for Ls vectorised implementations (CayleyFermion5Dvec.h)
+  void MooeeInternal       (const FermionField &in, FermionField &out,int dag,int inv);
+  void MooeeInternalCompute(int dag,int inv,Vector<iSinglet<Simd> > &Matp,Vector<iSinglet<Simd> > &Matm);
+
   virtual void SetCoefficientsZolotarev(RealD zolohi,Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsTanh(Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsInternal(RealD zolo_hi,Vector<Coeff_t> & gamma,RealD b,RealD c);
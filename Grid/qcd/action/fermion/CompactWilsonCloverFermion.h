@@ -183,6 +183,11 @@ public:
                      const CloverDiagonalField& diagonal,
                      const CloverTriangleField& triangle);
 
+  // out = hop + clover * in in a single sweep, the tail of M and Mdag
+  void MooeeAddInternal(const FermionField& in,
+                        const FermionField& hop,
+                        FermionField&       out);
+
   /////////////////////////////////////////////
   // Helpers
   /////////////////////////////////////////////
@@ -233,8 +238,6 @@ public:
   CloverTriangleField Triangle,    TriangleEven,    TriangleOdd;
   CloverTriangleField TriangleInv, TriangleInvEven, TriangleInvOdd;
 
-  FermionField Tmp;
-
   MaskField BoundaryMask, BoundaryMaskEven, BoundaryMaskOdd;
 };
 
@@ -0,0 +1,64 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./Grid/qcd/action/fermion/DomainWallLayout.cc
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+NAMESPACE_BEGIN(Grid);
+
+int DomainWallLayout::Layout           = DomainWallLayout::LayoutAuto;
+int DomainWallLayout::MinReducedExtent = 4;
+
+std::string DomainWallLayout::Name(int layout)
+{
+  switch(layout) {
+  case Layout4d: return "4d";
+  case LayoutLs: return "Ls";
+  default:       return "auto";
+  }
+}
+
+int DomainWallLayout::Choose(GridBase *UGrid,int Ls,int nsimd)
+{
+  int fits = (nsimd > 1) && (Ls % nsimd == 0);
+  if ( Layout == LayoutLs ) {
+    if ( !fits ) {
+      std::cout << GridLogError << "DomainWallLayout: Ls=" << Ls
+		<< " is not a multiple of Nsimd=" << nsimd << std::endl;
+      assert(0);
+    }
+    return LayoutLs;
+  }
+  if ( Layout == Layout4d || !fits ) return Layout4d;
+
+  for(int d=0;d<UGrid->Nd();d++){
+    if ( (UGrid->_simd_layout[d] > 1) && (UGrid->_rdimensions[d] < MinReducedExtent) ) return LayoutLs;
+  }
+  return Layout4d;
+}
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,143 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./Grid/qcd/action/fermion/DomainWallLayout.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Choice of SIMD layout for domain wall operators, --dwf-layout auto|4d|ls.
+//
+// The usual layout splits the 4d local volume over SIMD lanes. When the
+// local volume is small the reduced extents in the split directions become
+// short, most sites lie on a face and the lane permutes and halo
+// gather/scatter dominate Dhop. The Ls vectorised layout (DomainWallVec5dImpl)
+// puts the lanes in the fifth dimension instead: the 4d sites and the gauge
+// field stay scalar and the halo is exchanged without any lane permutes.
+//
+// auto picks the Ls layout when Ls is a multiple of Nsimd and some SIMD
+// split 4d direction has fewer than MinReducedExtent reduced sites.
+////////////////////////////////////////////////////////////////////////////////
+class DomainWallLayout {
+public:
+  enum { LayoutAuto, Layout4d, LayoutLs };
+  static int Layout;
+  static int MinReducedExtent;
+
+  static int Choose(GridBase *UGrid,int Ls,int nsimd);
+  static std::string Name(int layout);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Builds Action4d (e.g. DomainWallFermionD) or ActionLs (DomainWallFermionVec5dD)
+// for the layout chosen on UGrid, with the grids the operator needs.
+//
+// Callers work with fields on the usual 5d grid over UGrid, e.g.
+// FermionGrid(), and move them to and from OperatorGrid() with
+// ImportFermion and ExportFermion; in the 4d layout these are site by site
+// copies. Even-odd fields for the operator live on OperatorRedBlackGrid().
+////////////////////////////////////////////////////////////////////////////////
+template<class Action4d,class ActionLs>
+class DomainWallLayoutFactory {
+public:
+  typedef typename Action4d::FermionField FermionField;
+  typedef typename Action4d::GaugeField   GaugeField;
+  typedef CheckerBoardedSparseMatrixBase<FermionField> Operator;
+
+  static_assert(std::is_same<FermionField,typename ActionLs::FermionField>::value,
+		"both layouts must share a fermion field type");
+
+  DomainWallLayoutFactory(GridCartesian *_UGrid,int _Ls) : UGrid(_UGrid), Ls(_Ls)
+  {
+    const int nsimd = ActionLs::Simd::Nsimd();
+    layout = DomainWallLayout::Choose(UGrid,Ls,nsimd);
+
+    FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+    if ( layout == DomainWallLayout::LayoutLs ) {
+      OpUGrid   = SpaceTimeGrid::makeFourDimDWFGrid(UGrid->FullDimensions(),UGrid->ProcessorGrid());
+      OpUrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(OpUGrid);
+      OpFGrid   = SpaceTimeGrid::makeFiveDimDWFGrid(Ls,UGrid);
+      OpFrbGrid = SpaceTimeGrid::makeFiveDimDWFRedBlackGrid(Ls,UGrid);
+    } else {
+      OpUGrid   = UGrid;
+      OpUrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+      OpFGrid   = FGrid;
+      OpFrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+    }
+    std::cout << GridLogMessage << "DomainWallLayoutFactory: Ls " << Ls
+	      << " local volume " << UGrid->LocalDimensions()
+	      << " using the " << DomainWallLayout::Name(layout) << " layout" << std::endl;
+  }
+  ~DomainWallLayoutFactory()
+  {
+    if ( OpUGrid != UGrid ) delete OpUGrid;
+    if ( OpFGrid != FGrid ) delete OpFGrid;
+    delete OpUrbGrid;
+    delete OpFrbGrid;
+    delete FGrid;
+  }
+
+  // Trailing arguments as for the operator constructor after the grids,
+  // e.g. mass,M5 or mass,M5,b,c. The gauge field lives on UGrid.
+  template<class... Args>
+  Operator *Create(GaugeField &Umu,Args&&... args)
+  {
+    if ( layout == DomainWallLayout::LayoutLs )
+      return new ActionLs(Umu,*OpFGrid,*OpFrbGrid,*OpUGrid,*OpUrbGrid,std::forward<Args>(args)...);
+    return new Action4d(Umu,*OpFGrid,*OpFrbGrid,*OpUGrid,*OpUrbGrid,std::forward<Args>(args)...);
+  }
+
+  // localConvert checks the local volumes agree
+  void ImportFermion(const FermionField &in,FermionField &out)
+  {
+    conformable(out.Grid(),OpFGrid);
+    localConvert(in,out);
+  }
+  void ExportFermion(const FermionField &in,FermionField &out)
+  {
+    conformable(in.Grid(),OpFGrid);
+    localConvert(in,out);
+  }
+
+  int Layout(void) { return layout; }
+  GridCartesian         *FermionGrid(void)           { return FGrid; }
+  GridCartesian         *OperatorGrid(void)          { return OpFGrid; }
+  GridRedBlackCartesian *OperatorRedBlackGrid(void)  { return OpFrbGrid; }
+
+private:
+  GridCartesian         *UGrid;
+  int Ls;
+  int layout;
+  GridCartesian         *FGrid;
+  GridCartesian         *OpUGrid;
+  GridRedBlackCartesian *OpUrbGrid;
+  GridCartesian         *OpFGrid;
+  GridRedBlackCartesian *OpFrbGrid;
+};
+
+NAMESPACE_END(Grid);
@@ -40,6 +40,7 @@ public:
   static const int Dimension = Representation::Dimension;
   static const bool isFundamental = Representation::isFundamental;
   static const bool LsVectorised=true;
+  static const bool isGparity=false;
   static const int Nhcs = Options::Nhcs;
       
   typedef typename Options::_Coeff_t Coeff_t;      
@@ -71,7 +72,7 @@ public:
   typedef WilsonCompressor<SiteHalfCommSpinor,SiteHalfSpinor, SiteSpinor> Compressor;
   typedef WilsonImplParams ImplParams;
   typedef WilsonStencil<SiteSpinor, SiteHalfSpinor,ImplParams> StencilImpl;
-  typedef typename StencilImpl::View_type StencilView;
+  typedef const typename StencilImpl::View_type StencilView;
   
   ImplParams Params;
 
@@ -84,9 +85,10 @@ public:
   }
 
   template<class _Spinor>
-  static accelerator_inline void multLink(_Spinor &phi, const SiteDoubledGaugeField &U,
-					  const _Spinor &chi, int mu, StencilEntry *SE,
-					  StencilView &St) 
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu) 
   {
 #ifdef GPU_VEC
     // Gauge link is scalarised
@@ -101,6 +103,37 @@ public:
     mult(&phi(), &UU(), &chi());
 #endif
   }
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu,
+					  StencilEntry *SE,
+					  StencilView &St) 
+  {
+    multLink(phi,U,chi,mu);
+  }
+
+  template<class _SpinorField> 
+  inline void multLinkField(_SpinorField & out,
+			    const DoubledGaugeField &Umu,
+			    const _SpinorField & phi,
+			    int mu)
+  {
+    // The gauge field is scalar and four dimensional; a 5d field carries
+    // LLs outer s-blocks per 4d site, s fastest, as in the Dhop kernels
+    GridBase *grid = out.Grid();
+    int LLs = (grid->Nd() == Umu.Grid()->Nd()) ? 1 : grid->_rdimensions[0];
+    assert(grid->oSites() == LLs*Umu.Grid()->oSites());
+    autoView( out_v, out, CpuWrite);
+    autoView( phi_v, phi, CpuRead);
+    autoView( Umu_v, Umu, CpuRead);
+    thread_for(sss,grid->oSites(),{
+      typename _SpinorField::vector_object tmp;
+      multLink(tmp,Umu_v[sss/LLs],phi_v[sss],mu);
+      out_v[sss] = tmp;
+    });
+  }
 
   inline void DoubleStore(GridBase *GaugeGrid, DoubledGaugeField &Uds,const GaugeField &Umu) 
   {
@@ -167,6 +167,12 @@ NAMESPACE_CHECK(ImplBase);
 /////////////////////////////////////////////////////////////////////////////
 #include <Grid/qcd/action/fermion/WilsonImpl.h> 
 NAMESPACE_CHECK(ImplWilson);  
+
+/////////////////////////////////////////////////////////////////////////////
+// Single flavour four spinors with colour index. 5d vec
+/////////////////////////////////////////////////////////////////////////////
+#include <Grid/qcd/action/fermion/DomainWallVec5dImpl.h> 
+NAMESPACE_CHECK(ImplDomainWallVec5d);  
    
 ////////////////////////////////////////////////////////////////////////////////////////
 // Flavour doubled spinors; is Gparity the only? what about C*?
@@ -51,6 +51,7 @@ class MADWF
  private:
   typedef typename Matrixo::FermionField FermionFieldo;
   typedef typename Matrixi::FermionField FermionFieldi;
+  typedef typename Matrixi::DoubledGaugeField::scalar_object GaugeSumi;
 
   PVinverter  & PauliVillarsSolvero;// For the outer field
   SchurSolver & SchurSolveri;       // For the inner approx field
@@ -65,6 +66,20 @@ class MADWF
   //operator() is called on "callback" at the end of every inner iteration. This allows for example the adjustment of the inner
   //tolerance to speed up subsequent iteration
   MADWFinnerIterCallbackBase* callback;
+
+  // Inner solves of earlier outer iterations, kept as orthonormal sources
+  // Q and solutions Z with Mati Z ~= Q. Each new inner source is projected
+  // on this space and the inner solver starts from the resulting guess.
+  // The space belongs to the inner operator it was built with: it is dropped
+  // when the mass or the (summed) doubled gauge links of Mati differ from
+  // those of the last solve, e.g. after ImportGauge or SetMass.
+  int nrecycle;
+  std::vector<FermionFieldi> Q;
+  std::vector<FermionFieldi> Z;
+  RealD     recycle_mass;
+  GaugeSumi recycle_links;
+
+  GridStopWatch PVTimer, InnerTimer, OuterTimer;
   
  public:
   MADWF(Matrixo &_Mato,
@@ -79,11 +94,24 @@ class MADWF
   Mato(_Mato),Mati(_Mati),
     SchurSolveri(_SchurSolveri),
     PauliVillarsSolvero(_PauliVillarsSolvero),Guesseri(_Guesseri),
-    callback(_callback)
+    callback(_callback), nrecycle(0)
     {
       target_resid=resid;
       maxiter     =_maxiter;
     };
+
+  // Keep up to n inner solutions for reuse by later outer iterations (and later
+  // calls with the same inner operator). Call ResetInnerRecycle after changing
+  // the inner operator in any other way than its gauge field or mass.
+  void SetInnerRecycle(int n) { nrecycle = n; ResetInnerRecycle(); }
+  void ResetInnerRecycle(void) { Q.clear(); Z.clear(); }
+
+  void Report(void)
+  {
+    std::cout << GridLogMessage << "MADWF : PV inverse time    " << PVTimer.Elapsed()    << std::endl;
+    std::cout << GridLogMessage << "MADWF : inner solve time   " << InnerTimer.Elapsed() << std::endl;
+    std::cout << GridLogMessage << "MADWF : outer residual time " << OuterTimer.Elapsed() << std::endl;
+  }
    
   void operator() (const FermionFieldo &src,FermionFieldo &sol5)
   {
@@ -91,6 +119,10 @@ class MADWF
     std::cout << GridLogMessage<< "  MADWF-like algorithm                           " << std::endl;
     std::cout << GridLogMessage<< " ************************************************" << std::endl;
 
+    PVTimer.Reset();
+    InnerTimer.Reset();
+    OuterTimer.Reset();
+
     FermionFieldi    c0i(Mati.GaugeGrid()); // 4d 
     FermionFieldi    y0i(Mati.GaugeGrid()); // 4d
     FermionFieldo    c0 (Mato.GaugeGrid()); // 4d 
@@ -110,6 +142,7 @@ class MADWF
     FermionFieldi   Ai(Mati.FermionGrid()); 
 
     RealD m=Mati.Mass();
+    CheckInnerRecycle();
 
     ///////////////////////////////////////
     //Import source, include Dminus factors
@@ -133,7 +166,9 @@ class MADWF
       ///////////////////////////////////////
       // Set up c0 from current defect
       ///////////////////////////////////////
+      PVTimer.Start();
       PauliVillarsSolvero(Mato,defect,A);
+      PVTimer.Stop();
       Mato.Pdag(A,c);
       ExtractSlice(c0, c, 0 , 0);
 
@@ -145,10 +180,12 @@ class MADWF
       InsertSlice(c0i,ci,0, 0);
 
       // Dwm P y = Dwm x = D(1) P (c0,0,0,0)^T
+      InnerTimer.Start();
       Mati.P(ci,Ai);
       Mati.SetMass(1.0);      Mati.M(Ai,srci);      Mati.SetMass(m);
-      SchurSolveri(Mati,srci,xi,Guesseri); 
+      InnerSolve(srci,xi);
       Mati.Pdag(xi,yi);
+      InnerTimer.Stop();
       ExtractSlice(y0i, yi, 0 , 0);
       convert(y0i,y0); // Possible precision change
 
@@ -164,7 +201,9 @@ class MADWF
       /////////////////////////////
       Mato.P(c,B);
       Mato.M(B,A);
+      PVTimer.Start();
       PauliVillarsSolvero(Mato,A,B);
+      PVTimer.Stop();
       Mato.Pdag(B,A);
 
       //////////////////////////////
@@ -187,8 +226,10 @@ class MADWF
       std::cout << GridLogMessage << " delta    "<<norm2(B)<<std::endl;
 
        // New defect  = b - M sol5
+       OuterTimer.Start();
        Mato.M(sol5,A);
        defect = b - A;
+       OuterTimer.Stop();
 
        std::cout << GridLogMessage << " defect   "<<norm2(defect)<<std::endl;
 
@@ -199,6 +240,7 @@ class MADWF
        if(callback != NULL) (*callback)(resid);       
        
        if (resid < target_resid) {
+	 Report();
 	 return;
        }
     }
@@ -208,6 +250,72 @@ class MADWF
 
   }
 
+ private:
+  // Starts the red-black inner solve from the matching checkerboard of a full field guess
+  class RecycledGuesser: public LinearFunction<FermionFieldi> {
+  public:
+    using LinearFunction<FermionFieldi>::operator();
+    const FermionFieldi &x0;
+    RecycledGuesser(const FermionFieldi &_x0) : x0(_x0) {};
+    virtual void operator()(const FermionFieldi &src, FermionFieldi &guess) { pickCheckerboard(src.Checkerboard(),guess,x0); };
+  };
+
+  void CheckInnerRecycle(void)
+  {
+    if ( nrecycle == 0 ) return;
+    RealD     m     = Mati.Mass();
+    GaugeSumi links = sum(Mati.Umu);
+    if ( !Q.empty() ) {
+      GaugeSumi diff = links - recycle_links;
+      if ( (m != recycle_mass) || (real(TensorRemove(innerProduct(diff,diff))) != 0.0) ) {
+	std::cout << GridLogMessage << "MADWF : inner operator changed, recycled solutions dropped" << std::endl;
+	ResetInnerRecycle();
+      }
+    }
+    recycle_mass  = m;
+    recycle_links = links;
+  }
+
+  void InnerSolve(const FermionFieldi &srci,FermionFieldi &xi)
+  {
+    if ( nrecycle == 0 ) {
+      SchurSolveri(Mati,srci,xi,Guesseri);
+      return;
+    }
+
+    // Guess x0 = Z Q^dag srci; r = (1 - Q Q^dag) srci is the part of the source it misses
+    FermionFieldi r(srci.Grid());
+    FermionFieldi x0(srci.Grid());
+    r  = srci;
+    x0 = Zero();
+    typedef typename FermionFieldi::scalar_type Coeffi;
+    for(size_t k=0;k<Q.size();k++){
+      Coeffi ip = Coeffi(innerProduct(Q[k],r));
+      r  = r  - ip*Q[k];
+      x0 = x0 + ip*Z[k];
+    }
+
+    if ( Q.empty() ) {
+      SchurSolveri(Mati,srci,xi,Guesseri);
+    } else {
+      std::cout << GridLogMessage << "MADWF : inner source reduced to " << std::sqrt(norm2(r)/norm2(srci))
+		<< " by " << Q.size() << " recycled solutions" << std::endl;
+      RecycledGuesser guess(x0);
+      SchurSolveri(Mati,srci,xi,guess);
+    }
+
+    // Mati (xi - x0) ~= r, added to the space normalised
+    RealD nrm = std::sqrt(norm2(r));
+    if ( nrm == 0.0 ) return;
+    if ( (int)Q.size() == nrecycle ) {
+      Q.erase(Q.begin());
+      Z.erase(Z.begin());
+    }
+    Coeffi scale(1.0/nrm);
+    Q.push_back(scale*r);
+    Z.push_back(scale*(xi - x0));
+  }
+
 };
 
 NAMESPACE_END(Grid);
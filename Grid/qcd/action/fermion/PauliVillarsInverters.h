@@ -70,6 +70,64 @@ class PauliVillarsSolverRBprec
   };
 };
 
+////////////////////////////////////////////////////////////////////////////
+// PV inverse by defect correction: the residual is formed in the precision
+// of the calling operator, each correction is a red-black solve on MatrixF,
+// a lower precision copy of the same action, to a loose tolerance.
+////////////////////////////////////////////////////////////////////////////
+template<class MatrixF,class SchurSolverTypeF>
+class PauliVillarsSolverMixedPrec
+{
+ public:
+  typedef typename MatrixF::FermionField FieldF;
+
+  MatrixF          & MatF;
+  SchurSolverTypeF & SchurSolverF;
+  RealD Tolerance;
+  int   MaxOuterIterations;
+
+  PauliVillarsSolverMixedPrec(MatrixF &_MatF,SchurSolverTypeF &_SchurSolverF,RealD _Tolerance,int _MaxOuterIterations=20)
+    : MatF(_MatF), SchurSolverF(_SchurSolverF), Tolerance(_Tolerance), MaxOuterIterations(_MaxOuterIterations) {};
+
+  template<class Matrix,class Field>
+  void operator() (Matrix &_Matrix,const Field &src,Field &sol)
+  {
+    RealD m  = _Matrix.Mass();
+    RealD mf = MatF.Mass();
+    Field  r (_Matrix.FermionGrid());
+    Field  A (_Matrix.FermionGrid());
+    FieldF rf(MatF.FermionGrid());
+    FieldF ef(MatF.FermionGrid());
+
+    _Matrix.SetMass(1.0);
+    MatF.SetMass(1.0);
+
+    RealD ssq = norm2(src);
+    sol = Zero();
+    r   = src;
+    int k;
+    for(k=0;k<MaxOuterIterations;k++){
+      precisionChange(rf,r);
+      ef = Zero();
+      SchurSolverF(MatF,rf,ef);
+      precisionChange(A,ef);
+      sol = sol + A;
+
+      _Matrix.M(sol,A);
+      r = src - A;
+      RealD resid = std::sqrt(norm2(r)/ssq);
+      std::cout << GridLogIterative << "PauliVillarsSolverMixedPrec: outer iteration " << k << " residual " << resid << std::endl;
+      if ( resid < Tolerance ) break;
+    }
+    if ( k==MaxOuterIterations ) {
+      std::cout << GridLogWarning << "PauliVillarsSolverMixedPrec: did not converge in " << k << " outer iterations" << std::endl;
+    }
+
+    _Matrix.SetMass(m);
+    MatF.SetMass(mf);
+  };
+};
+
 template<class Field,class GaugeField>
 class PauliVillarsSolverFourierAccel
 {
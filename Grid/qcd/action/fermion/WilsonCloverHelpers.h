@@ -206,6 +206,23 @@ public:
       coalescedWrite(out_v[sss],tmp);
     });
   }
+
+  // out = hop + C*phi in one sweep; out may alias hop
+  template<class _SpinorField>
+  inline void multCloverAddField(_SpinorField& out, const CloverField& C, const _SpinorField& phi, const _SpinorField& hop) {
+    const int Nsimd = SiteSpinor::Nsimd();
+    autoView(hop_v, hop, AcceleratorRead);
+    autoView(phi_v, phi, AcceleratorRead);
+    autoView(C_v,   C,   AcceleratorRead);
+    autoView(out_v, out, AcceleratorWrite);
+    typedef decltype(coalescedRead(out_v[0])) calcSpinor;
+    accelerator_for(sss,out.Grid()->oSites(),Nsimd,{
+      calcSpinor tmp;
+      multClover(tmp,C_v[sss],phi_v(sss));
+      tmp = tmp + hop_v(sss);
+      coalescedWrite(out_v[sss],tmp);
+    });
+  }
 };
 
 
@@ -250,6 +267,71 @@ public:
       return Nred * (Nred - 1) / 2 - (Nred - j) * (Nred - j - 1) / 2 + i - j - 1;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  // One chiral block of the packed clover term applied to a spinor: the 6x6
+  // hermitian block is held as 6 real-valued diagonal entries and the 15
+  // upper triangle entries, the lower triangle is the conjugate. Straight
+  // line code for either SIMD vectors (cpu) or one lane (gpu).
+  ////////////////////////////////////////////////////////////////////////////
+  template<int block, typename Spinor, typename Diagonal, typename Triangle>
+  static accelerator_inline void MultCloverBlock(Spinor& res, const Spinor& in_t, const Diagonal& diag_t, const Triangle& triangle_t) {
+    const int s0 = 2*block;
+    const int s1 = 2*block+1;
+
+    auto in_cc_0_0 = conjugate(in_t()(s0)(0)); // Nils: reduces number
+    auto in_cc_0_1 = conjugate(in_t()(s0)(1)); // of conjugates from
+    auto in_cc_0_2 = conjugate(in_t()(s0)(2)); // 30 to 20
+    auto in_cc_1_0 = conjugate(in_t()(s1)(0));
+    auto in_cc_1_1 = conjugate(in_t()(s1)(1));
+
+    res()(s0)(0) =              diag_t()(block)( 0) * in_t()(s0)(0)
+                 +          triangle_t()(block)( 0) * in_t()(s0)(1)
+                 +          triangle_t()(block)( 1) * in_t()(s0)(2)
+                 +          triangle_t()(block)( 2) * in_t()(s1)(0)
+                 +          triangle_t()(block)( 3) * in_t()(s1)(1)
+                 +          triangle_t()(block)( 4) * in_t()(s1)(2);
+
+    res()(s0)(1) =          triangle_t()(block)( 0) * in_cc_0_0;
+    res()(s0)(1) =              diag_t()(block)( 1) * in_t()(s0)(1)
+                 +          triangle_t()(block)( 5) * in_t()(s0)(2)
+                 +          triangle_t()(block)( 6) * in_t()(s1)(0)
+                 +          triangle_t()(block)( 7) * in_t()(s1)(1)
+                 +          triangle_t()(block)( 8) * in_t()(s1)(2)
+                 + conjugate(      res()(s0)( 1));
+
+    res()(s0)(2) =          triangle_t()(block)( 1) * in_cc_0_0
+                 +          triangle_t()(block)( 5) * in_cc_0_1;
+    res()(s0)(2) =              diag_t()(block)( 2) * in_t()(s0)(2)
+                 +          triangle_t()(block)( 9) * in_t()(s1)(0)
+                 +          triangle_t()(block)(10) * in_t()(s1)(1)
+                 +          triangle_t()(block)(11) * in_t()(s1)(2)
+                 + conjugate(      res()(s0)( 2));
+
+    res()(s1)(0) =          triangle_t()(block)( 2) * in_cc_0_0
+                 +          triangle_t()(block)( 6) * in_cc_0_1
+                 +          triangle_t()(block)( 9) * in_cc_0_2;
+    res()(s1)(0) =              diag_t()(block)( 3) * in_t()(s1)(0)
+                 +          triangle_t()(block)(12) * in_t()(s1)(1)
+                 +          triangle_t()(block)(13) * in_t()(s1)(2)
+                 + conjugate(      res()(s1)( 0));
+
+    res()(s1)(1) =          triangle_t()(block)( 3) * in_cc_0_0
+                 +          triangle_t()(block)( 7) * in_cc_0_1
+                 +          triangle_t()(block)(10) * in_cc_0_2
+                 +          triangle_t()(block)(12) * in_cc_1_0;
+    res()(s1)(1) =              diag_t()(block)( 4) * in_t()(s1)(1)
+                 +          triangle_t()(block)(14) * in_t()(s1)(2)
+                 + conjugate(      res()(s1)( 1));
+
+    res()(s1)(2) =          triangle_t()(block)( 4) * in_cc_0_0
+                 +          triangle_t()(block)( 8) * in_cc_0_1
+                 +          triangle_t()(block)(11) * in_cc_0_2
+                 +          triangle_t()(block)(13) * in_cc_1_0
+                 +          triangle_t()(block)(14) * in_cc_1_1;
+    res()(s1)(2) =              diag_t()(block)( 5) * in_t()(s1)(2)
+                 + conjugate(      res()(s1)( 2));
+  }
+
   static void MooeeKernel_gpu(int                        Nsite,
                               int                        Ls,
                               const FermionField&        in,
@@ -272,22 +354,11 @@ public:
       CalcSpinor in_t = in_v(sF);
       auto diagonal_t = diagonal_v(sU);
       auto triangle_t = triangle_v(sU);
-      for(int block=0; block<Nhs; block++) {
-        int s_start = block*Nhs;
-        for(int i=0; i<Nred; i++) {
-          int si = s_start + i/Nc, ci = i%Nc;
-          res()(si)(ci) = diagonal_t()(block)(i) * in_t()(si)(ci);
-          for(int j=0; j<Nred; j++) {
-            if (j == i) continue;
-            int sj = s_start + j/Nc, cj = j%Nc;
-            res()(si)(ci) = res()(si)(ci) + triangle_elem(triangle_t, block, i, j) * in_t()(sj)(cj);
-          };
-        };
-      };
+      MultCloverBlock<0>(res, in_t, diagonal_t, triangle_t);
+      MultCloverBlock<1>(res, in_t, diagonal_t, triangle_t);
       coalescedWrite(out_v[sF], res);
     });
   }
-
   static void MooeeKernel_cpu(int                        Nsite,
                               int                        Ls,
                               const FermionField&        in,
@@ -371,59 +442,7 @@ public:
 
       // upper half
       PREFETCH_CLOVER(0);
-
-      auto in_cc_0_0 = conjugate(in_t()(0)(0)); // Nils: reduces number
-      auto in_cc_0_1 = conjugate(in_t()(0)(1)); // of conjugates from
-      auto in_cc_0_2 = conjugate(in_t()(0)(2)); // 30 to 20
-      auto in_cc_1_0 = conjugate(in_t()(1)(0));
-      auto in_cc_1_1 = conjugate(in_t()(1)(1));
-
-      res()(0)(0) =               diag_t()(0)( 0) * in_t()(0)(0)
-                  +           triangle_t()(0)( 0) * in_t()(0)(1)
-                  +           triangle_t()(0)( 1) * in_t()(0)(2)
-                  +           triangle_t()(0)( 2) * in_t()(1)(0)
-                  +           triangle_t()(0)( 3) * in_t()(1)(1)
-                  +           triangle_t()(0)( 4) * in_t()(1)(2);
-
-      res()(0)(1) =           triangle_t()(0)( 0) * in_cc_0_0;
-      res()(0)(1) =               diag_t()(0)( 1) * in_t()(0)(1)
-                  +           triangle_t()(0)( 5) * in_t()(0)(2)
-                  +           triangle_t()(0)( 6) * in_t()(1)(0)
-                  +           triangle_t()(0)( 7) * in_t()(1)(1)
-                  +           triangle_t()(0)( 8) * in_t()(1)(2)
-                  + conjugate(       res()(0)( 1));
-
-      res()(0)(2) =           triangle_t()(0)( 1) * in_cc_0_0
-                  +           triangle_t()(0)( 5) * in_cc_0_1;
-      res()(0)(2) =               diag_t()(0)( 2) * in_t()(0)(2)
-                  +           triangle_t()(0)( 9) * in_t()(1)(0)
-                  +           triangle_t()(0)(10) * in_t()(1)(1)
-                  +           triangle_t()(0)(11) * in_t()(1)(2)
-                  + conjugate(       res()(0)( 2));
-
-      res()(1)(0) =           triangle_t()(0)( 2) * in_cc_0_0
-                  +           triangle_t()(0)( 6) * in_cc_0_1
-                  +           triangle_t()(0)( 9) * in_cc_0_2;
-      res()(1)(0) =               diag_t()(0)( 3) * in_t()(1)(0)
-                  +           triangle_t()(0)(12) * in_t()(1)(1)
-                  +           triangle_t()(0)(13) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 0));
-
-      res()(1)(1) =           triangle_t()(0)( 3) * in_cc_0_0
-                  +           triangle_t()(0)( 7) * in_cc_0_1
-                  +           triangle_t()(0)(10) * in_cc_0_2
-                  +           triangle_t()(0)(12) * in_cc_1_0;
-      res()(1)(1) =               diag_t()(0)( 4) * in_t()(1)(1)
-                  +           triangle_t()(0)(14) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 1));
-
-      res()(1)(2) =           triangle_t()(0)( 4) * in_cc_0_0
-                  +           triangle_t()(0)( 8) * in_cc_0_1
-                  +           triangle_t()(0)(11) * in_cc_0_2
-                  +           triangle_t()(0)(13) * in_cc_1_0
-                  +           triangle_t()(0)(14) * in_cc_1_1;
-      res()(1)(2) =               diag_t()(0)( 5) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 2));
+      MultCloverBlock<0>(res, in_t, diag_t, triangle_t);
 
       vstream(out_v[sF]()(0)(0), res()(0)(0));
       vstream(out_v[sF]()(0)(1), res()(0)(1));
@@ -434,59 +453,7 @@ public:
 
       // lower half
       PREFETCH_CLOVER(1);
-
-      auto in_cc_2_0 = conjugate(in_t()(2)(0));
-      auto in_cc_2_1 = conjugate(in_t()(2)(1));
-      auto in_cc_2_2 = conjugate(in_t()(2)(2));
-      auto in_cc_3_0 = conjugate(in_t()(3)(0));
-      auto in_cc_3_1 = conjugate(in_t()(3)(1));
-
-      res()(2)(0) =               diag_t()(1)( 0) * in_t()(2)(0)
-                  +           triangle_t()(1)( 0) * in_t()(2)(1)
-                  +           triangle_t()(1)( 1) * in_t()(2)(2)
-                  +           triangle_t()(1)( 2) * in_t()(3)(0)
-                  +           triangle_t()(1)( 3) * in_t()(3)(1)
-                  +           triangle_t()(1)( 4) * in_t()(3)(2);
-
-      res()(2)(1) =           triangle_t()(1)( 0) * in_cc_2_0;
-      res()(2)(1) =               diag_t()(1)( 1) * in_t()(2)(1)
-                  +           triangle_t()(1)( 5) * in_t()(2)(2)
-                  +           triangle_t()(1)( 6) * in_t()(3)(0)
-                  +           triangle_t()(1)( 7) * in_t()(3)(1)
-                  +           triangle_t()(1)( 8) * in_t()(3)(2)
-                  + conjugate(       res()(2)( 1));
-
-      res()(2)(2) =           triangle_t()(1)( 1) * in_cc_2_0
-                  +           triangle_t()(1)( 5) * in_cc_2_1;
-      res()(2)(2) =               diag_t()(1)( 2) * in_t()(2)(2)
-                  +           triangle_t()(1)( 9) * in_t()(3)(0)
-                  +           triangle_t()(1)(10) * in_t()(3)(1)
-                  +           triangle_t()(1)(11) * in_t()(3)(2)
-                  + conjugate(       res()(2)( 2));
-
-      res()(3)(0) =           triangle_t()(1)( 2) * in_cc_2_0
-                  +           triangle_t()(1)( 6) * in_cc_2_1
-                  +           triangle_t()(1)( 9) * in_cc_2_2;
-      res()(3)(0) =               diag_t()(1)( 3) * in_t()(3)(0)
-                  +           triangle_t()(1)(12) * in_t()(3)(1)
-                  +           triangle_t()(1)(13) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 0));
-
-      res()(3)(1) =           triangle_t()(1)( 3) * in_cc_2_0
-                  +           triangle_t()(1)( 7) * in_cc_2_1
-                  +           triangle_t()(1)(10) * in_cc_2_2
-                  +           triangle_t()(1)(12) * in_cc_3_0;
-      res()(3)(1) =               diag_t()(1)( 4) * in_t()(3)(1)
-                  +           triangle_t()(1)(14) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 1));
-
-      res()(3)(2) =           triangle_t()(1)( 4) * in_cc_2_0
-                  +           triangle_t()(1)( 8) * in_cc_2_1
-                  +           triangle_t()(1)(11) * in_cc_2_2
-                  +           triangle_t()(1)(13) * in_cc_3_0
-                  +           triangle_t()(1)(14) * in_cc_3_1;
-      res()(3)(2) =               diag_t()(1)( 5) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 2));
+      MultCloverBlock<1>(res, in_t, diag_t, triangle_t);
 
       vstream(out_v[sF]()(2)(0), res()(2)(0));
       vstream(out_v[sF]()(2)(1), res()(2)(1));
@@ -510,6 +477,39 @@ public:
 #endif
   }
 
+  // out = hop + clover * in, one pass over the sites. Used to complete M after the
+  // hopping term so that neither a temporary nor a separate axpy sweep is needed.
+  static void MooeeAddKernel(int                        Nsite,
+                             int                        Ls,
+                             const FermionField&        in,
+                             const FermionField&        hop,
+                             FermionField&              out,
+                             const CloverDiagonalField& diagonal,
+                             const CloverTriangleField& triangle) {
+    autoView(diagonal_v, diagonal, AcceleratorRead);
+    autoView(triangle_v, triangle, AcceleratorRead);
+    autoView(in_v,       in,       AcceleratorRead);
+    autoView(hop_v,      hop,      AcceleratorRead);
+    autoView(out_v,      out,      AcceleratorWrite);
+
+    typedef decltype(coalescedRead(out_v[0])) CalcSpinor;
+
+    const uint64_t NN = Nsite * Ls;
+
+    accelerator_for(ss, NN, Simd::Nsimd(), {
+      int sF = ss;
+      int sU = ss/Ls;
+      CalcSpinor res;
+      CalcSpinor in_t = in_v(sF);
+      auto diagonal_t = diagonal_v(sU);
+      auto triangle_t = triangle_v(sU);
+      MultCloverBlock<0>(res, in_t, diagonal_t, triangle_t);
+      MultCloverBlock<1>(res, in_t, diagonal_t, triangle_t);
+      res = res + hop_v(sF);
+      coalescedWrite(out_v[sF], res);
+    });
+  }
+
   static void Invert(const CloverDiagonalField& diagonal,
                      const CloverTriangleField& triangle,
                      CloverDiagonalField&       diagonalInv,
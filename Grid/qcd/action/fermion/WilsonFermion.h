@@ -144,10 +144,14 @@ public:
                     const FermionField &in, FermionField &out, int dag);
 
   void DhopInternalSerial(StencilImpl &st, LebesgueOrder &lo, DoubledGaugeField &U,
-                    const FermionField &in, FermionField &out, int dag);
+                    const FermionField &in, FermionField &out, int dag, int Opt);
 
   void DhopInternalOverlappedComms(StencilImpl &st, LebesgueOrder &lo, DoubledGaugeField &U,
-                    const FermionField &in, FermionField &out, int dag);
+                    const FermionField &in, FermionField &out, int dag, int Opt);
+
+  // Kernel variant and comms mode for this stencil; autotuned on first use under --dslash-tune
+  WilsonKernelsChoice DhopChoice(StencilImpl &st, LebesgueOrder &lo, DoubledGaugeField &U,
+                                 const FermionField &in, FermionField &out, int dag);
 
   // Constructor
   WilsonFermion(GaugeField &_Umu, GridCartesian &Fgrid,
@@ -185,6 +189,8 @@ public:
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
 
+  std::map<StencilImpl *,WilsonKernelsChoice> DhopTuned;
+
   WilsonAnisotropyCoefficients anisotropyCoeff;
 
   ///////////////////////////////////////////////////////////////
@@ -157,14 +157,24 @@ public:
 				   DoubledGaugeField &U,
 				   const FermionField &in, 
 				   FermionField &out,
-				   int dag);
+				   int dag,
+				   int Opt);
 
   void DhopInternalSerialComms(StencilImpl & st,
 			       LebesgueOrder &lo,
 			       DoubledGaugeField &U,
 			       const FermionField &in, 
 			       FermionField &out,
-			       int dag);
+			       int dag,
+			       int Opt);
+
+  // Kernel variant and comms mode for this stencil; autotuned on first use under --dslash-tune
+  WilsonKernelsChoice DhopChoice(StencilImpl & st,
+				 LebesgueOrder &lo,
+				 DoubledGaugeField &U,
+				 const FermionField &in, 
+				 FermionField &out,
+				 int dag);
     
   // Constructors
   WilsonFermion5D(GaugeField &_Umu,
@@ -213,6 +223,8 @@ public:
     
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
+
+  std::map<StencilImpl *,WilsonKernelsChoice> DhopTuned;
     
   // Comms buffer
   //  std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  comm_buf;
@@ -268,5 +268,157 @@ typedef WilsonImpl<vComplexF, TwoIndexAntiSymmetricRepresentation, CoeffReal > W
 typedef WilsonImpl<vComplexD, TwoIndexAntiSymmetricRepresentation, CoeffReal > WilsonTwoIndexAntiSymmetricImplD;  // Double
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Fundamental SU(3) with compressed doubled links. Each link of the doubled
+// field is stored as its first two rows and one complex number k, 14 reals
+// rather than 18, and the third row is rebuilt where it is used:
+//
+//   row2 = k conj(row0 x row1)
+//
+// This holds for any link proportional to a U(3) matrix, so the boundary
+// phases, twists and normalisation applied in DoubleStore all go into k.
+// Links that are not a multiple of a unitary matrix (e.g. unprojected
+// smeared links) are not representable.
+/////////////////////////////////////////////////////////////////////////////
+template <class S, class Representation = FundamentalRepresentation,class Options = CoeffReal >
+class WilsonCompressedImpl : public WilsonImpl<S,Representation,Options> {
+public:
+
+  typedef WilsonImpl<S,Representation,Options> Base;
+  INHERIT_GIMPL_TYPES(Base);
+
+  static const int Dimension = Base::Dimension;
+  static const int Npacked   = 2*Dimension+1;   // row reconstruction is only valid for SU(3)
+
+  typedef typename Base::StencilView StencilView;
+  typedef typename Base::SiteHalfSpinor SiteHalfSpinor;
+
+  template <typename vtype> using iImplDoubledGaugeField = iVector<iScalar<iVector<vtype, Npacked> >, Nds>;
+
+  typedef iImplDoubledGaugeField<Simd>   SiteDoubledGaugeField;
+  typedef Lattice<SiteDoubledGaugeField> DoubledGaugeField;
+
+  typedef typename Base::SiteDoubledGaugeField SiteFullGaugeField;
+  typedef typename Base::DoubledGaugeField     FullGaugeField;
+
+  WilsonCompressedImpl(const typename Base::ImplParams &p = typename Base::ImplParams()) : Base(p) {};
+
+  // packed -> full colour matrix
+  template<class vtype>
+  static accelerator_inline void unpackLink(iScalar<iMatrix<vtype,Dimension> > &M,
+					    const iScalar<iVector<vtype,Npacked> > &P)
+  {
+    for(int j=0;j<Dimension;j++){
+      int j1 = (j+1)%Dimension;
+      int j2 = (j+2)%Dimension;
+      M()(0,j) = P()(j);
+      M()(1,j) = P()(Dimension+j);
+      M()(2,j) = P()(2*Dimension)*conjugate(P()(j1)*P()(Dimension+j2)-P()(j2)*P()(Dimension+j1));
+    }
+  }
+  // full -> packed; k by projection of row 2 onto conj(row0 x row1)
+  template<class vtype>
+  static accelerator_inline void packLink(iScalar<iVector<vtype,Npacked> > &P,
+					  const iScalar<iMatrix<vtype,Dimension> > &M)
+  {
+    vtype num, den;
+    zeroit(num);
+    zeroit(den);
+    for(int j=0;j<Dimension;j++){
+      int j1 = (j+1)%Dimension;
+      int j2 = (j+2)%Dimension;
+      vtype c = M()(0,j1)*M()(1,j2)-M()(0,j2)*M()(1,j1);
+      num = num + M()(2,j)*c;
+      den = den + c*conjugate(c);
+      P()(j)           = M()(0,j);
+      P()(Dimension+j) = M()(1,j);
+    }
+    P()(2*Dimension) = num/den;
+  }
+
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu) 
+  {
+    auto PP = coalescedRead(U(mu));
+    typedef typename std::remove_reference<decltype(PP()(0))>::type vtype;
+    iScalar<iMatrix<vtype,Dimension> > UU;
+    unpackLink(UU,PP);
+    mult(&phi(), &UU, &chi());
+  }
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu,
+					  StencilEntry *SE,
+					  StencilView &St) 
+  {
+    multLink(phi,U,chi,mu);
+  }
+
+  template<class _SpinorField> 
+  inline void multLinkField(_SpinorField & out,
+			    const DoubledGaugeField &Umu,
+			    const _SpinorField & phi,
+			    int mu)
+  {
+    const int Nsimd = SiteHalfSpinor::Nsimd();
+    autoView( out_v, out, AcceleratorWrite);
+    autoView( phi_v, phi, AcceleratorRead);
+    autoView( Umu_v, Umu, AcceleratorRead);
+    typedef decltype(coalescedRead(out_v[0]))   calcSpinor;
+    accelerator_for(sss,out.Grid()->oSites(),Nsimd,{
+	calcSpinor tmp;
+	multLink(tmp,Umu_v[sss],phi_v(sss),mu);
+	coalescedWrite(out_v[sss],tmp);
+    });
+  }
+
+  inline void DoubleStore(GridBase *GaugeGrid,
+			  DoubledGaugeField &Uds,
+			  const GaugeField &Umu) 
+  {
+    assert(Dimension==3);
+    FullGaugeField Ufull(GaugeGrid);
+    Base::DoubleStore(GaugeGrid,Ufull,Umu);
+
+    conformable(Uds.Grid(), GaugeGrid);
+    autoView( Uds_v  , Uds  , AcceleratorWrite);
+    autoView( Ufull_v, Ufull, AcceleratorRead);
+    accelerator_for(ss,GaugeGrid->oSites(),Simd::Nsimd(),{
+	for(int mu=0;mu<Nds;mu++){
+	  auto M = coalescedRead(Ufull_v[ss](mu));
+	  typedef typename std::remove_reference<decltype(M()(0,0))>::type vtype;
+	  iScalar<iVector<vtype,Npacked> > P;
+	  packLink(P,M);
+	  coalescedWrite(Uds_v[ss](mu),P);
+	}
+    });
+  }
+
+  inline void extractLinkField(std::vector<GaugeLinkField> &mat, DoubledGaugeField &Uds)
+  {
+    for (int mu = 0; mu < Nd; mu++) {
+      autoView( mat_v, mat[mu], AcceleratorWrite);
+      autoView( Uds_v, Uds    , AcceleratorRead);
+      accelerator_for(ss,Uds.Grid()->oSites(),Simd::Nsimd(),{
+	  auto P = coalescedRead(Uds_v[ss](mu));
+	  typedef typename std::remove_reference<decltype(P()(0))>::type vtype;
+	  iScalar<iMatrix<vtype,Dimension> > M;
+	  unpackLink(M,P);
+	  coalescedWrite(mat_v[ss](),M);
+      });
+    }
+  }
+};
+
+typedef WilsonCompressedImpl<vComplex,  FundamentalRepresentation, CoeffReal > WilsonImplCompressedR; // Real.. whichever prec
+typedef WilsonCompressedImpl<vComplexF, FundamentalRepresentation, CoeffReal > WilsonImplCompressedF; // Float
+typedef WilsonCompressedImpl<vComplexD, FundamentalRepresentation, CoeffReal > WilsonImplCompressedD; // Double
+
+
 NAMESPACE_END(Grid);
 
@@ -0,0 +1,96 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/WilsonKernelsTuner.cc
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/qcd/action/fermion/FermionCore.h>
+
+NAMESPACE_BEGIN(Grid);
+
+int WilsonKernelsTuner::Enabled = 0;
+int WilsonKernelsTuner::Calls   = 5;
+
+static std::string DottedCoordinate(const Coordinate &c)
+{
+  std::stringstream ss;
+  for(int d=0;d<c.size();d++) ss << (d ? "." : "") << c[d];
+  return ss.str();
+}
+
+std::string WilsonKernelsTuner::Key(const std::string &op, GridBase *grid, int Ls)
+{
+  // one whitespace free token; the machine is added by the cache
+  std::stringstream ss;
+  ss << op
+     << "/l" << DottedCoordinate(grid->LocalDimensions())
+     << "/p" << DottedCoordinate(grid->ProcessorGrid())
+     << "/s" << DottedCoordinate(grid->_simd_layout)
+     << "/cb" << grid->_isCheckerBoarded
+     << "/Ls" << Ls
+     << "/t" << GridThread::GetThreads();
+  return ss.str();
+}
+
+bool WilsonKernelsTuner::Lookup(const std::string &key, WilsonKernelsChoice &choice)
+{
+  std::string value;
+  if ( !GridTuneCache::Query("WilsonDhop", key, value) ) return false;
+  std::stringstream ss(value);
+  WilsonKernelsChoice c;
+  if ( !(ss >> c.Opt >> c.Comms) ) return false;
+  choice = c;
+  return true;
+}
+
+void WilsonKernelsTuner::Record(const std::string &key, const WilsonKernelsChoice &choice, RealD usec)
+{
+  std::stringstream ss;
+  ss << choice.Opt << " " << choice.Comms << " " << usec;
+  GridTuneCache::Record("WilsonDhop", key, ss.str());
+}
+
+std::vector<WilsonKernelsChoice> WilsonKernelsTuner::Candidates(int handunroll)
+{
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric});
+  if ( handunroll ) opts.push_back(WilsonKernelsStatic::OptHandUnroll);
+  // assembler kernels only exist for some implementations; try them only if requested
+  if ( WilsonKernelsStatic::Opt == WilsonKernelsStatic::OptInlineAsm ) opts.push_back(WilsonKernelsStatic::OptInlineAsm);
+
+  std::vector<int> comms({WilsonKernelsStatic::CommsThenCompute});
+#ifdef GRID_OMP
+  comms.push_back(WilsonKernelsStatic::CommsAndCompute);
+#endif
+
+  std::vector<WilsonKernelsChoice> candidates;
+  for(auto o : opts) {
+    for(auto c : comms) {
+      candidates.push_back({o,c});
+    }
+  }
+  return candidates;
+}
+
+NAMESPACE_END(Grid);
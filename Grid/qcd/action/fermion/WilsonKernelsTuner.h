@@ -0,0 +1,93 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/WilsonKernelsTuner.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Dhop autotuning, enabled with --dslash-tune.
+//
+// The first Dhop of an operator on a given stencil times every candidate
+// kernel variant (WilsonKernelsStatic::Opt) and comms mode
+// (WilsonKernelsStatic::Comms) for a few calls and keeps the fastest for the
+// rest of the run. Winners are recorded in the GridTuneCache under the
+// kernel id "WilsonDhop", keyed by operator and geometry; with --tune-cache
+// later runs on the same machine start from them without --dslash-tune.
+//
+// Lebesgue ordering and cache blocking fix the stencil loop order when the
+// operator is constructed and so remain global settings.
+////////////////////////////////////////////////////////////////////////////////
+struct WilsonKernelsChoice {
+  int Opt;
+  int Comms;
+};
+
+class WilsonKernelsTuner {
+public:
+  static int Enabled;
+  static int Calls;   // timed calls per candidate
+
+  static std::string Key(const std::string &op, GridBase *grid, int Ls);
+  static bool Lookup(const std::string &key, WilsonKernelsChoice &choice);
+  static void Record(const std::string &key, const WilsonKernelsChoice &choice, RealD usec);
+  static std::vector<WilsonKernelsChoice> Candidates(int handunroll);
+
+  // dhop(choice) applies the operator once with the given settings
+  template<class DhopCall>
+  static WilsonKernelsChoice Tune(const std::string &op, GridBase *grid, int Ls, int handunroll, DhopCall dhop)
+  {
+    std::string key = Key(op, grid, Ls);
+    WilsonKernelsChoice best = {WilsonKernelsStatic::Opt, WilsonKernelsStatic::Comms};
+    if ( Lookup(key, best) ) return best;
+    if ( !Enabled ) return best;
+
+    std::vector<WilsonKernelsChoice> candidates = Candidates(handunroll);
+    RealD best_usec = 0.0;
+    for(size_t c=0;c<candidates.size();c++){
+      dhop(candidates[c]); // warm up
+      RealD t0 = usecond();
+      for(int i=0;i<Calls;i++) dhop(candidates[c]);
+      RealD usec = (usecond()-t0)/Calls;
+      grid->GlobalMax(usec); // same decision on every rank
+      std::cout << GridLogPerformance << "WilsonKernelsTuner: " << key
+		<< " Opt " << candidates[c].Opt << " Comms " << candidates[c].Comms
+		<< " : " << usec << " us" << std::endl;
+      if ( (c==0) || (usec < best_usec) ) {
+	best      = candidates[c];
+	best_usec = usec;
+      }
+    }
+    std::cout << GridLogMessage << "WilsonKernelsTuner: " << key
+	      << " selected Opt " << best.Opt << " Comms " << best.Comms << std::endl;
+    Record(key, best, best_usec);
+    return best;
+  }
+};
+
+NAMESPACE_END(Grid);
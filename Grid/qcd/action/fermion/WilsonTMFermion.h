@@ -58,6 +58,11 @@ public:
   }
 
 
+  // Unpreconditioned operator; the twisted mass term is added in the sweep
+  // that finishes the hopping term
+  virtual void M(const FermionField &in, FermionField &out) ;
+  virtual void Mdag(const FermionField &in, FermionField &out) ;
+
   // allow override for twisted mass and clover
   virtual void Mooee(const FermionField &in, FermionField &out) ;
   virtual void MooeeDag(const FermionField &in, FermionField &out) ;
@@ -49,6 +49,7 @@ CayleyFermion5D<Impl>::CayleyFermion5D(GaugeField &_Umu,
 			FourDimRedBlackGrid,_M5,p),
   mass_plus(_mass), mass_minus(_mass)
 { 
+  CayleyZeroCounters();
 }
 
 ///////////////////////////////////////////////////////////////
@@ -192,6 +193,16 @@ template<class Impl> void CayleyFermion5D<Impl>::CayleyReport(void)
 #endif
   }
 
+  if ( MpcFusedCalls > 0 ) {
+    std::cout << GridLogMessage << "#### MpcFused calls report " << std::endl;
+    std::cout << GridLogMessage << "CayleyFermion5D Number of MpcFused Calls     : " << MpcFusedCalls   << std::endl;
+    std::cout << GridLogMessage << "CayleyFermion5D ComputeTime/Calls            : " << MpcFusedTime / MpcFusedCalls << " us" << std::endl;
+    // Bytes = sizeof(Real) * (Nc*Ns*Nreim) * Ls * vol * 7 /2 for red black; halo and gauge field not counted
+    // Meooe5D (r+w), two hopping passes (r+w), Mooee input (r)
+    RealD Gbytes = sizeof(Real) * (Nc*Ns*2) * volume * 7 /2. * 1.e-9;
+    std::cout << GridLogMessage << "Average fermion bandwidth (GB/s)         : " << Gbytes/MpcFusedTime*MpcFusedCalls*1.e6 << std::endl;
+  }
+
 }
 template<class Impl> void CayleyFermion5D<Impl>::CayleyZeroCounters(void)
 {
@@ -202,6 +213,8 @@ template<class Impl> void CayleyFermion5D<Impl>::CayleyZeroCounters(void)
   MooeeInvFlops=0;
   MooeeInvCalls=0;
   MooeeInvTime=0;
+  MpcFusedCalls=0;
+  MpcFusedTime=0;
 }
 
 template<class Impl>  
@@ -214,14 +227,20 @@ void CayleyFermion5D<Impl>::M5D   (const FermionField &psi, FermionField &chi)
   M5D(psi,chi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
+void CayleyFermion5D<Impl>::Meooe5DCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bs;
-  Vector<Coeff_t> upper= cs;
-  Vector<Coeff_t> lower= cs; 
+  diag = bs;
+  upper= cs;
+  lower= cs; 
   upper[Ls-1]=-mass_minus*upper[Ls-1];
   lower[0]   =-mass_plus*lower[0];
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  Meooe5DCoeffs(lower,diag,upper);
   M5D(psi,psi,Din,lower,diag,upper);
 }
 // FIXME Redunant with the above routine; check this and eliminate
@@ -239,28 +258,57 @@ template<class Impl> void CayleyFermion5D<Impl>::Meo5D     (const FermionField &
   lower[0]   =-mass_plus*lower[0];
   M5D(psi,psi,chi,lower,diag,upper);
 }
+// Fused Schur operator on its own work fields
 template<class Impl>
-void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
+void CayleyFermion5D<Impl>::MpcFused(const FermionField &in, FermionField &out)
+{
+  FermionField tmp(in.Grid());
+  FermionField col(in.Grid());
+  MpcFused(in,out,tmp,col);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcDagFused(const FermionField &in, FermionField &out)
+{
+  FermionField tmp(in.Grid());
+  FermionField col(in.Grid());
+  MpcDagFused(in,out,tmp,col);
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
+  diag = bee;
+  upper.resize(Ls);
+  lower.resize(Ls);
   for(int i=0;i<Ls;i++) {
     upper[i]=-cee[i];
     lower[i]=-cee[i];
   }
   upper[Ls-1]=-mass_minus*upper[Ls-1];
   lower[0]   =-mass_plus*lower[0];
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeCoeffs(lower,diag,upper);
   M5D(psi,psi,chi,lower,diag,upper);
 }
 template<class Impl>
 void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeDagCoeffs(lower,diag,upper);
+  M5Ddag(psi,psi,chi,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeDagCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
+  diag = bee;
+  upper.resize(Ls);
+  lower.resize(Ls);
 
   for (int s=0;s<Ls;s++){
     // Assemble the 5d matrix
@@ -281,7 +329,6 @@ void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &
     upper[s]=conjugate(upper[s]);
     lower[s]=conjugate(lower[s]);
   }
-  M5Ddag(psi,psi,chi,lower,diag,upper);
 }
 
 template<class Impl>
@@ -298,11 +345,18 @@ void CayleyFermion5D<Impl>::M5Ddag (const FermionField &psi, FermionField &chi)
 
 template<class Impl>
 void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MeooeDag5DCoeffs(lower,diag,upper);
+  M5Ddag(psi,psi,Din,lower,diag,upper);
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MeooeDag5DCoeffs(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag =bs;
-  Vector<Coeff_t> upper=cs;
-  Vector<Coeff_t> lower=cs; 
+  diag =bs;
+  upper=cs;
+  lower=cs; 
 
   for (int s=0;s<Ls;s++){
     if ( s== 0 ) {
@@ -319,7 +373,6 @@ void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField
     lower[s] = conjugate(lower[s]);
     diag[s]  = conjugate(diag[s]);
   }
-  M5Ddag(psi,psi,Din,lower,diag,upper);
 }
 
 template<class Impl>
@@ -581,9 +634,11 @@ void CayleyFermion5D<Impl>::SetCoefficientsInternal(RealD zolo_hi,Vector<Coeff_t
     dee[Ls-1] += delta_d;
   }  
 
-  //  int inv=1;
-  //  this->MooeeInternalCompute(0,inv,MatpInv,MatmInv);
-  //  this->MooeeInternalCompute(1,inv,MatpInvDag,MatmInvDag);
+  // Ls vectorised dense inverses are rebuilt from the new factors on next use
+  MatpInv.resize(0);
+  MatmInv.resize(0);
+  MatpInvDag.resize(0);
+  MatmInvDag.resize(0);
 }
 
 
@@ -961,86 +1016,6 @@ void CayleyFermion5D<Impl>::SeqConservedCurrent(PropagatorField &q_in,
 
 
 
-#if 0
-template<class Impl>
-void CayleyFermion5D<Impl>::MooeeInternalCompute(int dag, int inv,
-						 Vector<iSinglet<Simd> > & Matp,
-						 Vector<iSinglet<Simd> > & Matm)
-{
-  int Ls=this->Ls;
-
-  GridBase *grid = this->FermionRedBlackGrid();
-  int LLs = grid->_rdimensions[0];
-
-  if ( LLs == Ls ) {
-    return; // Not vectorised in 5th direction
-  }
-
-  Eigen::MatrixXcd Pplus  = Eigen::MatrixXcd::Zero(Ls,Ls);
-  Eigen::MatrixXcd Pminus = Eigen::MatrixXcd::Zero(Ls,Ls);
-  
-  for(int s=0;s<Ls;s++){
-    Pplus(s,s) = bee[s];
-    Pminus(s,s)= bee[s];
-  }
-  
-  for(int s=0;s<Ls-1;s++){
-    Pminus(s,s+1) = -cee[s];
-  }
-  
-  for(int s=0;s<Ls-1;s++){
-    Pplus(s+1,s) = -cee[s+1];
-  }
-  Pplus (0,Ls-1) = mass*cee[0];
-  Pminus(Ls-1,0) = mass*cee[Ls-1];
-  
-  Eigen::MatrixXcd PplusMat ;
-  Eigen::MatrixXcd PminusMat;
-  
-  if ( inv ) {
-    PplusMat =Pplus.inverse();
-    PminusMat=Pminus.inverse();
-  } else { 
-    PplusMat =Pplus;
-    PminusMat=Pminus;
-  }
-  
-  if(dag){
-    PplusMat.adjointInPlace();
-    PminusMat.adjointInPlace();
-  }
-  
-  typedef typename SiteHalfSpinor::scalar_type scalar_type;
-  const int Nsimd=Simd::Nsimd();
-  Matp.resize(Ls*LLs);
-  Matm.resize(Ls*LLs);
-
-  for(int s2=0;s2<Ls;s2++){
-    for(int s1=0;s1<LLs;s1++){
-      int istride = LLs;
-      int ostride = 1;
-      Simd Vp;
-      Simd Vm;
-      scalar_type *sp = (scalar_type *)&Vp;
-      scalar_type *sm = (scalar_type *)&Vm;
-      for(int l=0;l<Nsimd;l++){
-	if ( switcheroo<Coeff_t>::iscomplex() ) {
-	  sp[l] = PplusMat (l*istride+s1*ostride,s2);
-	  sm[l] = PminusMat(l*istride+s1*ostride,s2);
-	} else { 
-	  // if real
-	  scalar_type tmp;
-	  tmp = PplusMat (l*istride+s1*ostride,s2);
-	  sp[l] = scalar_type(tmp.real(),tmp.real());
-	  tmp = PminusMat(l*istride+s1*ostride,s2);
-	  sm[l] = scalar_type(tmp.real(),tmp.real());
-	}
-      }
-      Matp[LLs*s2+s1] = Vp;
-      Matm[LLs*s2+s1] = Vm;
-    }}
-}
-#endif
 
 NAMESPACE_END(Grid);
 
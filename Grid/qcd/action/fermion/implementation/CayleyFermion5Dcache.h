@@ -248,4 +248,201 @@ CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Fused Schur operator. Each stage is the 4d hopping term into col, through
+// DhopEO/DhopOE so the kernel and comms choice (and any tuning) is the one Dhop
+// uses, followed by a single pass over the Ls columns applying all of the
+// s-direction work of the stage.
+//
+//  Mpc    = Mooee - Dhop M5eo MooeeInv Dhop M5eo
+//           M5eo(in) ; [Dhop, MooeeInv, M5eo] ; [Dhop, Mooee(in) - col]
+//  MpcDag = MooeeDag - M5eo^dag Dhop^dag MooeeInvDag M5eo^dag Dhop^dag
+//           [Dhop^dag, M5eo^dag, MooeeInvDag] ; [Dhop^dag, MooeeDag(in) - M5eo^dag col]
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcFused(const FermionField &in, FermionField &out,
+				     FermionField &tmp, FermionField &col)
+{
+  if ( !SchurFusable() ) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MpcFused(in,out,tmp,col);
+    return;
+  }
+
+  MpcFusedCalls++;
+  MpcFusedTime-=usecond();
+  Meooe5D(in,out);
+  DhopFused5D(out,in,col,tmp,FuseMooeeInvMeooe5D);
+  DhopFused5D(tmp,in,out,out,FuseMooeeMinus);   // col may alias out here
+  MpcFusedTime+=usecond();
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcDagFused(const FermionField &in, FermionField &out,
+					FermionField &tmp, FermionField &col)
+{
+  if ( !SchurFusable() ) {
+    CheckerBoardedSparseMatrixBase<FermionField>::MpcDagFused(in,out,tmp,col);
+    return;
+  }
+
+  MpcFusedCalls++;
+  MpcFusedTime-=usecond();
+  DhopFused5D(in,in,col,tmp,FuseMeooeDag5DMooeeInvDag);
+  DhopFused5D(tmp,in,col,out,FuseMooeeDagMinus);
+  MpcFusedTime+=usecond();
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::DhopFused5D(const FermionField &in_i, const FermionField &phi_i,
+					FermionField &col_i, FermionField &out_i, int stage)
+{
+  GridBase *grid=in_i.Grid();
+  conformable(grid,this->FermionRedBlackGrid());
+  conformable(grid,out_i.Grid());
+
+  int Ls  = this->Ls;
+  int dag = (stage==FuseMeooeDag5DMooeeInvDag) || (stage==FuseMooeeDagMinus);
+  int cb  = in_i.Checkerboard();
+  col_i.Checkerboard() = !cb;
+  out_i.Checkerboard() = !cb;
+  if ( (stage==FuseMooeeMinus) || (stage==FuseMooeeDagMinus) ) {
+    assert(phi_i.Checkerboard() == out_i.Checkerboard());
+  }
+
+  // 4d hopping term, with the same kernel, comms and overlap choice as Dhop
+  if ( cb == Odd ) this->DhopEO(in_i,col_i,dag);
+  else             this->DhopOE(in_i,col_i,dag);
+
+  // s-direction coefficients for the stage; m* for the 5d part of Meooe,
+  // e* for Mooee
+  Vector<Coeff_t> mlower, mdiag, mupper;
+  Vector<Coeff_t> elower, ediag, eupper;
+  if ( dag ) MeooeDag5DCoeffs(mlower,mdiag,mupper);
+  else       Meooe5DCoeffs   (mlower,mdiag,mupper);
+  if ( dag ) MooeeDagCoeffs  (elower,ediag,eupper);
+  else       MooeeCoeffs     (elower,ediag,eupper);
+
+  {
+    autoView(phi  , phi_i,AcceleratorRead);
+    autoView(col  , col_i,AcceleratorWrite);
+    autoView(chi  , out_i,AcceleratorWrite);
+
+    auto pmdiag  = &mdiag[0];
+    auto pmupper = &mupper[0];
+    auto pmlower = &mlower[0];
+    auto pediag  = &ediag[0];
+    auto peupper = &eupper[0];
+    auto pelower = &elower[0];
+    auto plee  = & lee [0];
+    auto pdee  = & dee [0];
+    auto puee  = & uee [0];
+    auto pleem = & leem[0];
+    auto pueem = & ueem[0];
+
+    uint64_t nloop = grid->oSites()/Ls;
+    accelerator_for(sss,nloop,Simd::Nsimd(),{
+      uint64_t ss=sss*Ls;
+      typedef decltype(coalescedRead(col[0])) spinor;
+      spinor tmp, tmp1, tmp2, acc, res;
+
+      if ( stage == FuseMooeeInvMeooe5D ) {
+	// MooeeInv in place on the column, as in MooeeInv
+	res = col(ss);
+	spProj5m(tmp,res);
+	acc = pleem[0]*tmp;
+	spProj5p(tmp,res);
+	coalescedWrite(col[ss],res);
+	for(int s=1;s<Ls-1;s++){
+	  res = col(ss+s);
+	  res -= plee[s-1]*tmp;
+	  spProj5m(tmp,res);
+	  acc += pleem[s]*tmp;
+	  spProj5p(tmp,res);
+	  coalescedWrite(col[ss+s],res);
+	}
+	res = col(ss+Ls-1) - plee[Ls-2]*tmp - acc;
+	res = (1.0/pdee[Ls-1])*res;
+	coalescedWrite(col[ss+Ls-1],res);
+	spProj5p(acc,res);
+	spProj5m(tmp,res);
+	for (int s=Ls-2;s>=0;s--){
+	  res = (1.0/pdee[s])*col(ss+s) - puee[s]*tmp - pueem[s]*acc;
+	  spProj5m(tmp,res);
+	  coalescedWrite(col[ss+s],res);
+	}
+	// then the 5d part of the next Meooe
+	for(int s=0;s<Ls;s++){
+	  uint64_t idx_u = ss+((s+1)%Ls);
+	  uint64_t idx_l = ss+((s+Ls-1)%Ls);
+	  spProj5m(tmp1,col(idx_u));
+	  spProj5p(tmp2,col(idx_l));
+	  coalescedWrite(chi[ss+s],pmdiag[s]*col(ss+s)+pmupper[s]*tmp1+pmlower[s]*tmp2);
+	}
+      }
+
+      if ( stage == FuseMooeeMinus ) {
+	// Mooee(phi) - col; each col element is read before the same element is written
+	for(int s=0;s<Ls;s++){
+	  uint64_t idx_u = ss+((s+1)%Ls);
+	  uint64_t idx_l = ss+((s+Ls-1)%Ls);
+	  spProj5m(tmp1,phi(idx_u));
+	  spProj5p(tmp2,phi(idx_l));
+	  res = col(ss+s);
+	  coalescedWrite(chi[ss+s],pediag[s]*phi(ss+s)+peupper[s]*tmp1+pelower[s]*tmp2-res);
+	}
+      }
+
+      if ( stage == FuseMeooeDag5DMooeeInvDag ) {
+	// 5d part of MeooeDag
+	for(int s=0;s<Ls;s++){
+	  uint64_t idx_u = ss+((s+1)%Ls);
+	  uint64_t idx_l = ss+((s+Ls-1)%Ls);
+	  spProj5p(tmp1,col(idx_u));
+	  spProj5m(tmp2,col(idx_l));
+	  coalescedWrite(chi[ss+s],pmdiag[s]*col(ss+s)+pmupper[s]*tmp1+pmlower[s]*tmp2);
+	}
+	// then MooeeInvDag in place, as in MooeeInvDag
+	res = chi(ss);
+	spProj5p(tmp,res);
+	acc = conjugate(pueem[0])*tmp;
+	spProj5m(tmp,res);
+	coalescedWrite(chi[ss],res);
+	for(int s=1;s<Ls-1;s++){
+	  res = chi(ss+s);
+	  res -= conjugate(puee[s-1])*tmp;
+	  spProj5p(tmp,res);
+	  acc += conjugate(pueem[s])*tmp;
+	  spProj5m(tmp,res);
+	  coalescedWrite(chi[ss+s],res);
+	}
+	res = chi(ss+Ls-1) - conjugate(puee[Ls-2])*tmp - acc;
+	res = conjugate(1.0/pdee[Ls-1])*res;
+	coalescedWrite(chi[ss+Ls-1],res);
+	spProj5m(acc,res);
+	spProj5p(tmp,res);
+	for (int s=Ls-2;s>=0;s--){
+	  res = conjugate(1.0/pdee[s])*chi(ss+s) - conjugate(plee[s])*tmp - conjugate(pleem[s])*acc;
+	  spProj5p(tmp,res);
+	  coalescedWrite(chi[ss+s],res);
+	}
+      }
+
+      if ( stage == FuseMooeeDagMinus ) {
+	// MooeeDag(phi) - 5d part of MeooeDag on the column
+	for(int s=0;s<Ls;s++){
+	  uint64_t idx_u = ss+((s+1)%Ls);
+	  uint64_t idx_l = ss+((s+Ls-1)%Ls);
+	  spProj5p(tmp1,phi(idx_u));
+	  spProj5m(tmp2,phi(idx_l));
+	  res = pediag[s]*phi(ss+s)+peupper[s]*tmp1+pelower[s]*tmp2;
+	  spProj5p(tmp1,col(idx_u));
+	  spProj5m(tmp2,col(idx_l));
+	  res = res - (pmdiag[s]*col(ss+s)+pmupper[s]*tmp1+pmlower[s]*tmp2);
+	  coalescedWrite(chi[ss+s],res);
+	}
+      }
+    });
+  }
+}
+
 NAMESPACE_END(Grid);
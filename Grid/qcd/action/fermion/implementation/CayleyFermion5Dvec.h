@@ -2,7 +2,7 @@
 
     Grid physics library, www.github.com/paboyle/Grid 
 
-    Source file: ./lib/qcd/action/fermion/CayleyFermion5D.cc
+    Source file: ./Grid/qcd/action/fermion/implementation/CayleyFermion5Dvec.h
 
     Copyright (C) 2015
 
@@ -35,24 +35,64 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 
 NAMESPACE_BEGIN(Grid);
 
-/*
- * Dense matrix versions of routines
- */
-template<class Impl>
-void
-CayleyFermion5D<Impl>::MooeeInvDag(const FermionField &psi, FermionField &chi)
+////////////////////////////////////////////////////////////////////////////////
+// s-direction routines for Ls vectorised implementations (DomainWallVec5dImpl).
+//
+// The fifth dimension is split over SIMD lanes: outer index o < LLs=Ls/Nsimd,
+// lane l, s = o + l*LLs, and the LLs outer sites of one 4d site are
+// consecutive. Neighbours in s stay in the same lane except across the block
+// boundary, where the vector is rotated by one lane. s dependent coefficients
+// become per lane vectors.
+//
+// The ee inverse is a dense Ls x Ls matrix per chirality, built from the LDU
+// factors and applied as Ls vector multiply-adds per output vector.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class Simd,class Coeff_t>
+static void CayleyLaneCoefficients(Vector<iSinglet<Simd> > &out,Vector<Coeff_t> &in,int LLs)
 {
-  EnableIf<Impl::LsVectorised&&EnableBool,int> sfinae=0;
-  this->MooeeInternal(psi,chi,DaggerYes,InverseYes);
+  typedef typename Simd::scalar_type scalar_type;
+  const int nsimd = Simd::Nsimd();
+  out.resize(LLs);
+  scalar_type *o_p = (scalar_type *)&out[0];
+  for(int o=0;o<LLs;o++){
+    for(int l=0;l<nsimd;l++){
+      o_p[o*nsimd+l] = in[o+l*LLs];
+    }
+  }
 }
-  
-template<class Impl>
-void
-CayleyFermion5D<Impl>::MooeeInv(const FermionField &psi, FermionField &chi)
+
+template<class Impl,class View,class Coeffs>
+static void CayleyM5DLs(const View &psi,const View &phi,View &chi,Coeffs &lower,Coeffs &diag,Coeffs &upper,
+			uint64_t nsite,int LLs,int dag)
 {
-  EnableIf<Impl::LsVectorised&&EnableBool,int> sfinae=0;
-  this->MooeeInternal(psi,chi,DaggerNo,InverseYes);
+  typedef typename Impl::SiteSpinor SiteSpinor;
+  const int nsimd = Impl::Simd::Nsimd();
+  auto pl = &lower[0];
+  auto pd = &diag[0];
+  auto pu = &upper[0];
+  thread_for(sss,nsite,{
+    uint64_t ss=sss*LLs;
+    SiteSpinor hp, hm, tmp1, tmp2;
+    for(int v=0;v<LLs;v++){
+      int vp=(v+1)%LLs;
+      int vm=(v+LLs-1)%LLs;
+      hp = psi[ss+vp];
+      hm = psi[ss+vm];
+      if ( vp<=v ) rotate(hp,hp,1);        // s+1 crosses into the next lane
+      if ( vm>=v ) rotate(hm,hm,nsimd-1);  // s-1 crosses into the previous lane
+      if ( dag ) {
+	spProj5p(tmp1,hp);
+	spProj5m(tmp2,hm);
+      } else {
+	spProj5m(tmp1,hp);
+	spProj5p(tmp2,hm);
+      }
+      chi[ss+v] = pd[v]*phi[ss+v] + pu[v]*tmp1 + pl[v]*tmp2;
+    }
+  });
 }
+
 template<class Impl>  
 void
 CayleyFermion5D<Impl>::M5D(const FermionField &psi_i,
@@ -62,142 +102,23 @@ CayleyFermion5D<Impl>::M5D(const FermionField &psi_i,
 			   Vector<Coeff_t> &diag,
 			   Vector<Coeff_t> &upper)
 {
-  EnableIf<Impl::LsVectorised&&EnableBool,int> sfinae=0;
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
-  autoView(psi, psi_i,CpuRead);
-  autoView(phi, phi_i,CpuRead);
-  autoView(chi, chi_i,CpuWrite);
-  int Ls   = this->Ls;
-  int LLs  = grid->_rdimensions[0];
-  const int nsimd= Simd::Nsimd();
-
-  Vector<iSinglet<Simd> > u(LLs);
-  Vector<iSinglet<Simd> > l(LLs);
-  Vector<iSinglet<Simd> > d(LLs);
+  int LLs = grid->_rdimensions[0];
+  assert(phi_i.Checkerboard() == psi_i.Checkerboard());
 
-  assert(Ls/LLs==nsimd);
-  assert(phi.Checkerboard() == psi.Checkerboard());
-
-  // just directly address via type pun
-  typedef typename Simd::scalar_type scalar_type;
-  scalar_type * u_p = (scalar_type *)&u[0];
-  scalar_type * l_p = (scalar_type *)&l[0];
-  scalar_type * d_p = (scalar_type *)&d[0];
-
-  for(int o=0;o<LLs;o++){ // outer
-    for(int i=0;i<nsimd;i++){ //inner
-      int s  = o+i*LLs;
-      int ss = o*nsimd+i;
-      u_p[ss] = upper[s];
-      l_p[ss] = lower[s];
-      d_p[ss] = diag[s];
-    }}
+  Vector<iSinglet<Simd> > u, l, d;
+  CayleyLaneCoefficients(u,upper,LLs);
+  CayleyLaneCoefficients(l,lower,LLs);
+  CayleyLaneCoefficients(d,diag,LLs);
 
+  autoView(psi , psi_i,CpuRead);
+  autoView(phi , phi_i,CpuRead);
+  autoView(chi , chi_i,CpuWrite);
 
   M5Dcalls++;
   M5Dtime-=usecond();
-
-  assert(Nc==3);
-
-  thread_loop( (int ss=0;ss<grid->oSites();ss+=LLs),{ // adds LLs
-#if 0
-    alignas(64) SiteHalfSpinor hp;
-    alignas(64) SiteHalfSpinor hm;
-    alignas(64) SiteSpinor fp;
-    alignas(64) SiteSpinor fm;
-
-    for(int v=0;v<LLs;v++){
-
-      int vp=(v+1)%LLs;
-      int vm=(v+LLs-1)%LLs;
-
-      spProj5m(hp,psi[ss+vp]);
-      spProj5p(hm,psi[ss+vm]);
-
-      if ( vp<=v ) rotate(hp,hp,1);
-      if ( vm>=v ) rotate(hm,hm,nsimd-1);
-	
-      hp=0.5*hp;
-      hm=0.5*hm;
-
-      spRecon5m(fp,hp);
-      spRecon5p(fm,hm);
-
-      chi[ss+v] = d[v]*phi[ss+v];
-      chi[ss+v] = chi[ss+v]     +u[v]*fp;
-      chi[ss+v] = chi[ss+v]     +l[v]*fm;
-
-    }
-#else
-    for(int v=0;v<LLs;v++){
-      
-      vprefetch(psi[ss+v+LLs]);
-
-      int vp= (v==LLs-1) ? 0     : v+1;
-      int vm= (v==0    ) ? LLs-1 : v-1;
-	
-      Simd hp_00 = psi[ss+vp]()(2)(0); 
-      Simd hp_01 = psi[ss+vp]()(2)(1); 
-      Simd hp_02 = psi[ss+vp]()(2)(2); 
-      Simd hp_10 = psi[ss+vp]()(3)(0); 
-      Simd hp_11 = psi[ss+vp]()(3)(1); 
-      Simd hp_12 = psi[ss+vp]()(3)(2); 
-	
-      Simd hm_00 = psi[ss+vm]()(0)(0); 
-      Simd hm_01 = psi[ss+vm]()(0)(1); 
-      Simd hm_02 = psi[ss+vm]()(0)(2); 
-      Simd hm_10 = psi[ss+vm]()(1)(0); 
-      Simd hm_11 = psi[ss+vm]()(1)(1); 
-      Simd hm_12 = psi[ss+vm]()(1)(2); 
-
-      if ( vp<=v ) {
-	hp_00.v = Optimization::Rotate::tRotate<2>(hp_00.v);
-	hp_01.v = Optimization::Rotate::tRotate<2>(hp_01.v);
-	hp_02.v = Optimization::Rotate::tRotate<2>(hp_02.v);
-	hp_10.v = Optimization::Rotate::tRotate<2>(hp_10.v);
-	hp_11.v = Optimization::Rotate::tRotate<2>(hp_11.v);
-	hp_12.v = Optimization::Rotate::tRotate<2>(hp_12.v);
-      }
-      if ( vm>=v ) {
-	hm_00.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_00.v);
-	hm_01.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_01.v);
-	hm_02.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_02.v);
-	hm_10.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_10.v);
-	hm_11.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_11.v);
-	hm_12.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_12.v);
-      }
-
-      // Can force these to real arithmetic and save 2x.
-      Simd p_00  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(0))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_00); 
-      Simd p_01  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(1))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_01); 
-      Simd p_02  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(2))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_02); 
-      Simd p_10  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(0))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_10); 
-      Simd p_11  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(1))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_11); 
-      Simd p_12  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(2))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_12); 
-      Simd p_20  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(0))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_00); 
-      Simd p_21  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(1))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_01); 
-      Simd p_22  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(2))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_02);  
-      Simd p_30  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(0))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_10); 
-      Simd p_31  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(1))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_11); 
-      Simd p_32  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(2))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_12); 
-
-      vstream(chi[ss+v]()(0)(0),p_00);
-      vstream(chi[ss+v]()(0)(1),p_01);
-      vstream(chi[ss+v]()(0)(2),p_02);
-      vstream(chi[ss+v]()(1)(0),p_10);
-      vstream(chi[ss+v]()(1)(1),p_11);
-      vstream(chi[ss+v]()(1)(2),p_12);
-      vstream(chi[ss+v]()(2)(0),p_20);
-      vstream(chi[ss+v]()(2)(1),p_21);
-      vstream(chi[ss+v]()(2)(2),p_22);
-      vstream(chi[ss+v]()(3)(0),p_30);
-      vstream(chi[ss+v]()(3)(1),p_31);
-      vstream(chi[ss+v]()(3)(2),p_32);
-
-    }
-#endif
-  });
+  CayleyM5DLs<Impl>(psi,phi,chi,l,d,u,grid->oSites()/LLs,LLs,0);
   M5Dtime+=usecond();
 }
 
@@ -210,622 +131,193 @@ CayleyFermion5D<Impl>::M5Ddag(const FermionField &psi_i,
 			      Vector<Coeff_t> &diag,
 			      Vector<Coeff_t> &upper)
 {
-  EnableIf<Impl::LsVectorised&&EnableBool,int> sfinae=0;
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
-  autoView(psi,psi_i,CpuRead);
-  autoView(phi,phi_i,CpuRead);
-  autoView(chi,chi_i,CpuWrite);
-  int Ls   = this->Ls;
-  int LLs  = grid->_rdimensions[0];
-  int nsimd= Simd::Nsimd();
-
-  Vector<iSinglet<Simd> > u(LLs);
-  Vector<iSinglet<Simd> > l(LLs);
-  Vector<iSinglet<Simd> > d(LLs);
+  int LLs = grid->_rdimensions[0];
+  assert(phi_i.Checkerboard() == psi_i.Checkerboard());
 
-  assert(Ls/LLs==nsimd);
-  assert(phi.Checkerboard() == psi.Checkerboard());
+  Vector<iSinglet<Simd> > u, l, d;
+  CayleyLaneCoefficients(u,upper,LLs);
+  CayleyLaneCoefficients(l,lower,LLs);
+  CayleyLaneCoefficients(d,diag,LLs);
 
-  // just directly address via type pun
-  typedef typename Simd::scalar_type scalar_type;
-  scalar_type * u_p = (scalar_type *)&u[0];
-  scalar_type * l_p = (scalar_type *)&l[0];
-  scalar_type * d_p = (scalar_type *)&d[0];
-
-  for(int o=0;o<LLs;o++){ // outer
-    for(int i=0;i<nsimd;i++){ //inner
-      int s  = o+i*LLs;
-      int ss = o*nsimd+i;
-      u_p[ss] = upper[s];
-      l_p[ss] = lower[s];
-      d_p[ss] = diag[s];
-    }}
+  autoView(psi , psi_i,CpuRead);
+  autoView(phi , phi_i,CpuRead);
+  autoView(chi , chi_i,CpuWrite);
 
   M5Dcalls++;
   M5Dtime-=usecond();
-  thread_loop( (int ss=0;ss<grid->oSites();ss+=LLs),{ // adds LLs
-#if 0
-    alignas(64) SiteHalfSpinor hp;
-    alignas(64) SiteHalfSpinor hm;
-    alignas(64) SiteSpinor fp;
-    alignas(64) SiteSpinor fm;
-
-    for(int v=0;v<LLs;v++){
-
-      int vp=(v+1)%LLs;
-      int vm=(v+LLs-1)%LLs;
-
-      spProj5p(hp,psi[ss+vp]);
-      spProj5m(hm,psi[ss+vm]);
-
-      if ( vp<=v ) rotate(hp,hp,1);
-      if ( vm>=v ) rotate(hm,hm,nsimd-1);
-      
-      hp=hp*0.5;
-      hm=hm*0.5;
-      spRecon5p(fp,hp);
-      spRecon5m(fm,hm);
-
-      chi[ss+v] = d[v]*phi[ss+v]+u[v]*fp;
-      chi[ss+v] = chi[ss+v]     +l[v]*fm;
-
-    }
-#else
-    for(int v=0;v<LLs;v++){
+  CayleyM5DLs<Impl>(psi,phi,chi,l,d,u,grid->oSites()/LLs,LLs,1);
+  M5Dtime+=usecond();
+}
 
-      vprefetch(psi[ss+v+LLs]);
-
-      int vp= (v==LLs-1) ? 0     : v+1;
-      int vm= (v==0    ) ? LLs-1 : v-1;
-	
-      Simd hp_00 = psi[ss+vp]()(0)(0); 
-      Simd hp_01 = psi[ss+vp]()(0)(1); 
-      Simd hp_02 = psi[ss+vp]()(0)(2); 
-      Simd hp_10 = psi[ss+vp]()(1)(0); 
-      Simd hp_11 = psi[ss+vp]()(1)(1); 
-      Simd hp_12 = psi[ss+vp]()(1)(2); 
-	
-      Simd hm_00 = psi[ss+vm]()(2)(0); 
-      Simd hm_01 = psi[ss+vm]()(2)(1); 
-      Simd hm_02 = psi[ss+vm]()(2)(2); 
-      Simd hm_10 = psi[ss+vm]()(3)(0); 
-      Simd hm_11 = psi[ss+vm]()(3)(1); 
-      Simd hm_12 = psi[ss+vm]()(3)(2); 
-
-      if ( vp<=v ) {
-	hp_00.v = Optimization::Rotate::tRotate<2>(hp_00.v);
-	hp_01.v = Optimization::Rotate::tRotate<2>(hp_01.v);
-	hp_02.v = Optimization::Rotate::tRotate<2>(hp_02.v);
-	hp_10.v = Optimization::Rotate::tRotate<2>(hp_10.v);
-	hp_11.v = Optimization::Rotate::tRotate<2>(hp_11.v);
-	hp_12.v = Optimization::Rotate::tRotate<2>(hp_12.v);
+////////////////////////////////////////////////////////////////////////////////
+// Dense ee inverse. Chirality is preserved by every step of the LDU solve in
+// CayleyFermion5Dcache.h, so running it on a unit vector of one chirality
+// gives a column of the inverse for that chirality.
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeInternalCompute(int dag, int inv,
+						 Vector<iSinglet<Simd> > & Matp,
+						 Vector<iSinglet<Simd> > & Matm)
+{
+  assert(inv);
+  typedef typename Simd::scalar_type scalar_type;
+  int Ls = this->Ls;
+  const int nsimd = Simd::Nsimd();
+  int LLs = Ls/nsimd;
+
+  // (P+ part, P- part) of one s component
+  struct Chiral { Coeff_t p, m; };
+  auto Pp = [](const Chiral &x) { Chiral r; r.p=x.p; r.m=0.0; return r; };
+  auto Pm = [](const Chiral &x) { Chiral r; r.p=0.0; r.m=x.m; return r; };
+  auto axpy = [](Coeff_t a,const Chiral &x,const Chiral &y) { Chiral r; r.p=a*x.p+y.p; r.m=a*x.m+y.m; return r; };
+
+  // lower and upper factors, swapped and conjugated for the adjoint
+  std::vector<Coeff_t> l(Ls), lm(Ls), u(Ls), um(Ls), dinv(Ls);
+  for(int s=0;s<Ls;s++){
+    l[s]   = dag ? conjugate(uee[s])  : lee[s];
+    lm[s]  = dag ? conjugate(ueem[s]) : leem[s];
+    u[s]   = dag ? conjugate(lee[s])  : uee[s];
+    um[s]  = dag ? conjugate(leem[s]) : ueem[s];
+    dinv[s]= dag ? conjugate(Coeff_t(1.0)/dee[s]) : Coeff_t(1.0)/dee[s];
+  }
+  // The forward sweep projects onto P- (P+ for the adjoint) for the corner term
+  auto Pfwd = [&](const Chiral &x) { return dag ? Pp(x) : Pm(x); };
+  auto Pbwd = [&](const Chiral &x) { return dag ? Pm(x) : Pp(x); };
+
+  std::vector<Coeff_t> Mp(Ls*Ls), Mm(Ls*Ls);
+  for(int t=0;t<Ls;t++){
+    for(int chirality=0;chirality<2;chirality++){
+      std::vector<Chiral> psi(Ls), chi(Ls);
+      for(int s=0;s<Ls;s++){ psi[s].p=0.0; psi[s].m=0.0; }
+      if ( chirality==0 ) psi[t].p = 1.0;
+      else                psi[t].m = 1.0;
+
+      Chiral res, tmp, acc;
+      res = psi[0];
+      acc = Pfwd(res); acc.p*=lm[0]; acc.m*=lm[0];
+      tmp = Pbwd(res);
+      chi[0] = res;
+      for(int s=1;s<Ls-1;s++){
+	res = axpy(-l[s-1],tmp,psi[s]);
+	acc = axpy(lm[s],Pfwd(res),acc);
+	tmp = Pbwd(res);
+	chi[s] = res;
       }
-      if ( vm>=v ) {
-	hm_00.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_00.v);
-	hm_01.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_01.v);
-	hm_02.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_02.v);
-	hm_10.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_10.v);
-	hm_11.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_11.v);
-	hm_12.v = Optimization::Rotate::tRotate<2*Simd::Nsimd()-2>(hm_12.v);
+      res = axpy(-l[Ls-2],tmp,psi[Ls-1]);
+      res = axpy(-1.0,acc,res);
+
+      res.p*=dinv[Ls-1]; res.m*=dinv[Ls-1];
+      chi[Ls-1] = res;
+      acc = Pbwd(res);
+      tmp = Pfwd(res);
+      for(int s=Ls-2;s>=0;s--){
+	Chiral d = chi[s]; d.p*=dinv[s]; d.m*=dinv[s];
+	res = axpy(-u[s],tmp,d);
+	res = axpy(-um[s],acc,res);
+	tmp = Pfwd(res);
+	chi[s] = res;
       }
+      for(int s=0;s<Ls;s++){
+	if ( chirality==0 ) Mp[s*Ls+t] = chi[s].p;
+	else                Mm[s*Ls+t] = chi[s].m;
+      }
+    }
+  }
 
-      Simd p_00  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(0))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_00); 
-      Simd p_01  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(1))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_01); 
-      Simd p_02  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(0)(2))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_02); 
-      Simd p_10  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(0))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_10); 
-      Simd p_11  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(1))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_11); 
-      Simd p_12  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(1)(2))  + switcheroo<Coeff_t>::mult(u[v]()()(),hp_12); 
-
-      Simd p_20  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(0))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_00); 
-      Simd p_21  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(1))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_01); 
-      Simd p_22  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(2)(2))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_02);  
-      Simd p_30  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(0))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_10); 
-      Simd p_31  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(1))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_11); 
-      Simd p_32  = switcheroo<Coeff_t>::mult(d[v]()()(), phi[ss+v]()(3)(2))  + switcheroo<Coeff_t>::mult(l[v]()()(),hm_12); 
-
-      vstream(chi[ss+v]()(0)(0),p_00);
-      vstream(chi[ss+v]()(0)(1),p_01);
-      vstream(chi[ss+v]()(0)(2),p_02);
-      vstream(chi[ss+v]()(1)(0),p_10);
-      vstream(chi[ss+v]()(1)(1),p_11);
-      vstream(chi[ss+v]()(1)(2),p_12);
-      vstream(chi[ss+v]()(2)(0),p_20);
-      vstream(chi[ss+v]()(2)(1),p_21);
-      vstream(chi[ss+v]()(2)(2),p_22);
-      vstream(chi[ss+v]()(3)(0),p_30);
-      vstream(chi[ss+v]()(3)(1),p_31);
-      vstream(chi[ss+v]()(3)(2),p_32);
+  // Output vector o, input vector o2, lane rotation r:
+  // lane l of the coefficient multiplies input lane (l+r)%nsimd
+  Matp.resize(LLs*LLs*nsimd);
+  Matm.resize(LLs*LLs*nsimd);
+  for(int o=0;o<LLs;o++){
+  for(int o2=0;o2<LLs;o2++){
+  for(int r=0;r<nsimd;r++){
+    int idx = (o*LLs+o2)*nsimd+r;
+    scalar_type *sp = (scalar_type *)&Matp[idx];
+    scalar_type *sm = (scalar_type *)&Matm[idx];
+    for(int ll=0;ll<nsimd;ll++){
+      int s = o +ll*LLs;
+      int t = o2+((ll+r)%nsimd)*LLs;
+      sp[ll] = Mp[s*Ls+t];
+      sm[ll] = Mm[s*Ls+t];
     }
-#endif
-  });
-  M5Dtime+=usecond();
+  }}}
 }
 
-
-#ifdef AVX512 
-#include <simd/Intel512common.h>
-#include <simd/Intel512avx.h>
-#include <simd/Intel512single.h>
-#endif 
-
 template<class Impl>
-void
-CayleyFermion5D<Impl>::MooeeInternalAsm(const FermionField &psi_i, FermionField &chi_i,
-					int LLs, int site,
-					Vector<iSinglet<Simd> > &Matp,
-					Vector<iSinglet<Simd> > &Matm)
+void CayleyFermion5D<Impl>::MooeeInternal(const FermionField &psi_i, FermionField &chi_i,int dag, int inv)
 {
-  EnableIf<Impl::LsVectorised&&EnableBool,int> sfinae=0;
+  assert(inv);
+  chi_i.Checkerboard()=psi_i.Checkerboard();
+  GridBase *grid=psi_i.Grid();
+  int LLs = grid->_rdimensions[0];
+  const int nsimd = Simd::Nsimd();
+
+  Vector<iSinglet<Simd> > &Matp = dag ? MatpInvDag : MatpInv;
+  Vector<iSinglet<Simd> > &Matm = dag ? MatmInvDag : MatmInv;
+  if ( Matp.size()==0 ) MooeeInternalCompute(dag,inv,Matp,Matm);
+  auto pMatp = &Matp[0];
+  auto pMatm = &Matm[0];
+
   autoView(psi , psi_i,CpuRead);
   autoView(chi , chi_i,CpuWrite);
-#ifndef AVX512
-  {
-    SiteHalfSpinor BcastP;
-    SiteHalfSpinor BcastM;
-    SiteHalfSpinor SiteChiP;
-    SiteHalfSpinor SiteChiM;
-
-    // Ls*Ls * 2 * 12 * vol flops
-    for(int s1=0;s1<LLs;s1++){ 
-      for(int s2=0;s2<LLs;s2++){ 
-	for(int  l=0; l<Simd::Nsimd();l++){ // simd lane
-
-	  int s=s2+l*LLs;
-	  int lex=s2+LLs*site;
-	
-	  if ( s2==0 && l==0) {
-	    SiteChiP=Zero();
-	    SiteChiM=Zero();
-	  }
-	
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      vbroadcast(BcastP()(sp  )(co),psi[lex]()(sp)(co),l);
-	    }}
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      vbroadcast(BcastM()(sp  )(co),psi[lex]()(sp+2)(co),l);
-	    }}
-
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      SiteChiP()(sp)(co)=real_madd(Matp[LLs*s+s1]()()(),BcastP()(sp)(co),SiteChiP()(sp)(co)); // 1100 us.
-	      SiteChiM()(sp)(co)=real_madd(Matm[LLs*s+s1]()()(),BcastM()(sp)(co),SiteChiM()(sp)(co)); // each found by commenting out
-	    }}
-
-	}}
-      {
-	int lex = s1+LLs*site;
-	for(int sp=0;sp<2;sp++){
-	  for(int co=0;co<Nc;co++){
-	    vstream(chi[lex]()(sp)(co), SiteChiP()(sp)(co));
-	    vstream(chi[lex]()(sp+2)(co), SiteChiM()(sp)(co));
-	  }}
-      }
-    }
 
-  }
-#else
-  {
-    // pointers
-    //  MASK_REGS;
-#define Chi_00 %%zmm1
-#define Chi_01 %%zmm2
-#define Chi_02 %%zmm3
-#define Chi_10 %%zmm4
-#define Chi_11 %%zmm5
-#define Chi_12 %%zmm6
-#define Chi_20 %%zmm7
-#define Chi_21 %%zmm8
-#define Chi_22 %%zmm9
-#define Chi_30 %%zmm10
-#define Chi_31 %%zmm11
-#define Chi_32 %%zmm12
-
-#define BCAST0   %%zmm13
-#define BCAST1   %%zmm14
-#define BCAST2   %%zmm15
-#define BCAST3   %%zmm16
-#define BCAST4   %%zmm17
-#define BCAST5   %%zmm18
-#define BCAST6   %%zmm19
-#define BCAST7   %%zmm20
-#define BCAST8   %%zmm21
-#define BCAST9   %%zmm22
-#define BCAST10  %%zmm23
-#define BCAST11  %%zmm24
-
-    int incr=LLs*LLs*sizeof(iSinglet<Simd>);
-    for(int s1=0;s1<LLs;s1++){ 
-      for(int s2=0;s2<LLs;s2++){ 
-	int lex=s2+LLs*site;
-	uint64_t a0 = (uint64_t)&Matp[LLs*s2+s1]; // should be cacheable
-	uint64_t a1 = (uint64_t)&Matm[LLs*s2+s1];
-	uint64_t a2 = (uint64_t)&psi[lex];
-	for(int  l=0; l<Simd::Nsimd();l++){ // simd lane
-	  if ( (s2+l)==0 ) {
-	    asm (
-		 VPREFETCH1(0,%2)  	     VPREFETCH1(0,%1)
-		 VPREFETCH1(12,%2)  	     VPREFETCH1(13,%2)
-		 VPREFETCH1(14,%2)  	     VPREFETCH1(15,%2)         
-		 VBCASTCDUP(0,%2,BCAST0)   
-		 VBCASTCDUP(1,%2,BCAST1)   
-		 VBCASTCDUP(2,%2,BCAST2)   
-		 VBCASTCDUP(3,%2,BCAST3)   
-		 VBCASTCDUP(4,%2,BCAST4)     VMULMEM (0,%0,BCAST0,Chi_00)
-		 VBCASTCDUP(5,%2,BCAST5)     VMULMEM (0,%0,BCAST1,Chi_01)
-		 VBCASTCDUP(6,%2,BCAST6)     VMULMEM (0,%0,BCAST2,Chi_02)
-		 VBCASTCDUP(7,%2,BCAST7)     VMULMEM (0,%0,BCAST3,Chi_10)
-		 VBCASTCDUP(8,%2,BCAST8)     VMULMEM (0,%0,BCAST4,Chi_11)
-		 VBCASTCDUP(9,%2,BCAST9)     VMULMEM (0,%0,BCAST5,Chi_12)
-		 VBCASTCDUP(10,%2,BCAST10)   VMULMEM (0,%1,BCAST6,Chi_20)
-		 VBCASTCDUP(11,%2,BCAST11)   VMULMEM (0,%1,BCAST7,Chi_21)
-		 VMULMEM (0,%1,BCAST8,Chi_22)         
-		 VMULMEM (0,%1,BCAST9,Chi_30)
-		 VMULMEM (0,%1,BCAST10,Chi_31)       
-		 VMULMEM (0,%1,BCAST11,Chi_32)
-		 : : "r" (a0), "r" (a1), "r" (a2)  );
-	  } else { 
-	    asm (
-		 VBCASTCDUP(0,%2,BCAST0)   VMADDMEM (0,%0,BCAST0,Chi_00)
-		 VBCASTCDUP(1,%2,BCAST1)   VMADDMEM (0,%0,BCAST1,Chi_01)
-		 VBCASTCDUP(2,%2,BCAST2)   VMADDMEM (0,%0,BCAST2,Chi_02)
-		 VBCASTCDUP(3,%2,BCAST3)   VMADDMEM (0,%0,BCAST3,Chi_10)
-		 VBCASTCDUP(4,%2,BCAST4)   VMADDMEM (0,%0,BCAST4,Chi_11)
-		 VBCASTCDUP(5,%2,BCAST5)   VMADDMEM (0,%0,BCAST5,Chi_12)
-		 VBCASTCDUP(6,%2,BCAST6)   VMADDMEM (0,%1,BCAST6,Chi_20)
-		 VBCASTCDUP(7,%2,BCAST7)   VMADDMEM (0,%1,BCAST7,Chi_21)
-		 VBCASTCDUP(8,%2,BCAST8)   VMADDMEM (0,%1,BCAST8,Chi_22)
-		 VBCASTCDUP(9,%2,BCAST9)   VMADDMEM (0,%1,BCAST9,Chi_30)
-		 VBCASTCDUP(10,%2,BCAST10)  VMADDMEM (0,%1,BCAST10,Chi_31)
-		 VBCASTCDUP(11,%2,BCAST11)  VMADDMEM (0,%1,BCAST11,Chi_32) 
-		 : : "r" (a0), "r" (a1), "r" (a2)  );
+  MooeeInvCalls++;
+  MooeeInvTime-=usecond();
+  thread_for(sss,grid->oSites()/LLs,{
+    uint64_t ss=sss*LLs;
+    SiteSpinor in;
+    for(int o=0;o<LLs;o++){
+      SiteSpinor res = Zero();
+      for(int o2=0;o2<LLs;o2++){
+	for(int r=0;r<nsimd;r++){
+	  rotate(in,psi[ss+o2],r);
+	  auto &cp = pMatp[(o*LLs+o2)*nsimd+r]()()();
+	  auto &cm = pMatm[(o*LLs+o2)*nsimd+r]()()();
+	  // chiral basis: spins 0,1 are P+, 2,3 are P-
+	  for(int sp=0;sp<Ns;sp++){
+	    for(int c=0;c<Impl::Dimension;c++){
+	      res()(sp)(c) = res()(sp)(c) + ((sp<Ns/2) ? cp : cm)*in()(sp)(c);
+	    }
 	  }
-	  a0 = a0+incr;
-	  a1 = a1+incr;
-	a2 = a2+sizeof(typename Simd::scalar_type);
-	}}
-      {
-	int lexa = s1+LLs*site;
-	asm (
-	     VSTORE(0,%0,Chi_00) VSTORE(1 ,%0,Chi_01)  VSTORE(2 ,%0,Chi_02)		
-	     VSTORE(3,%0,Chi_10) VSTORE(4 ,%0,Chi_11)  VSTORE(5 ,%0,Chi_12)		
-	     VSTORE(6,%0,Chi_20) VSTORE(7 ,%0,Chi_21)  VSTORE(8 ,%0,Chi_22)		
-	     VSTORE(9,%0,Chi_30) VSTORE(10,%0,Chi_31)  VSTORE(11,%0,Chi_32)		
-	     : : "r" ((uint64_t)&chi[lexa]) : "memory" );
-
+	}
       }
+      chi[ss+o] = res;
     }
-  }
-#undef Chi_00
-#undef Chi_01
-#undef Chi_02
-#undef Chi_10
-#undef Chi_11
-#undef Chi_12
-#undef Chi_20
-#undef Chi_21
-#undef Chi_22
-#undef Chi_30
-#undef Chi_31
-#undef Chi_32
-
-#undef BCAST0
-#undef BCAST1
-#undef BCAST2
-#undef BCAST3
-#undef BCAST4
-#undef BCAST5
-#undef BCAST6
-#undef BCAST7
-#undef BCAST8
-#undef BCAST9
-#undef BCAST10
-#undef BCAST11
-#endif
-};
-
-// Z-mobius version
+  });
+  MooeeInvTime+=usecond();
+}
+
 template<class Impl>
 void
-CayleyFermion5D<Impl>::MooeeInternalZAsm(const FermionField &psi_i, FermionField &chi_i,
-					 int LLs, int site, Vector<iSinglet<Simd> > &Matp, Vector<iSinglet<Simd> > &Matm)
+CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi, FermionField &chi)
 {
-  EnableIf<Impl::LsVectorised,int> sfinae=0;
-#ifndef AVX512
-  {
-    autoView(psi , psi_i,CpuRead);
-    autoView(chi , chi_i,CpuWrite);
-
-    SiteHalfSpinor BcastP;
-    SiteHalfSpinor BcastM;
-    SiteHalfSpinor SiteChiP;
-    SiteHalfSpinor SiteChiM;
-
-    // Ls*Ls * 2 * 12 * vol flops
-    for(int s1=0;s1<LLs;s1++){ 
-      for(int s2=0;s2<LLs;s2++){ 
-	for(int  l=0; l<Simd::Nsimd();l++){ // simd lane
-
-	  int s=s2+l*LLs;
-	  int lex=s2+LLs*site;
-	
-	  if ( s2==0 && l==0) {
-	    SiteChiP=Zero();
-	    SiteChiM=Zero();
-	  }
-	
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      vbroadcast(BcastP()(sp  )(co),psi[lex]()(sp)(co),l);
-	    }}
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      vbroadcast(BcastM()(sp  )(co),psi[lex]()(sp+2)(co),l);
-	    }}
-
-	  for(int sp=0;sp<2;sp++){
-	    for(int co=0;co<Nc;co++){
-	      SiteChiP()(sp)(co)=SiteChiP()(sp)(co)+ Matp[LLs*s+s1]()()()*BcastP()(sp)(co); 
-	      SiteChiM()(sp)(co)=SiteChiM()(sp)(co)+ Matm[LLs*s+s1]()()()*BcastM()(sp)(co); 
-	    }}
-
-
-	}}
-      {
-	int lex = s1+LLs*site;
-	for(int sp=0;sp<2;sp++){
-	  for(int co=0;co<Nc;co++){
-	    vstream(chi[lex]()(sp)(co), SiteChiP()(sp)(co));
-	    vstream(chi[lex]()(sp+2)(co), SiteChiM()(sp)(co));
-	  }}
-      }
-    }
-
-  }
-#else
-  {
-    autoView(psi , psi_i,CpuRead);
-    autoView(chi , chi_i,CpuWrite);
-    // pointers
-    //  MASK_REGS;
-#define Chi_00 %zmm0
-#define Chi_01 %zmm1
-#define Chi_02 %zmm2
-#define Chi_10 %zmm3
-#define Chi_11 %zmm4
-#define Chi_12 %zmm5
-#define Chi_20 %zmm6
-#define Chi_21 %zmm7
-#define Chi_22 %zmm8
-#define Chi_30 %zmm9
-#define Chi_31 %zmm10
-#define Chi_32 %zmm11
-#define pChi_00 %%zmm0
-#define pChi_01 %%zmm1
-#define pChi_02 %%zmm2
-#define pChi_10 %%zmm3
-#define pChi_11 %%zmm4
-#define pChi_12 %%zmm5
-#define pChi_20 %%zmm6
-#define pChi_21 %%zmm7
-#define pChi_22 %%zmm8
-#define pChi_30 %%zmm9
-#define pChi_31 %%zmm10
-#define pChi_32 %%zmm11
-
-#define BCAST_00   %zmm12
-#define  SHUF_00   %zmm13
-#define BCAST_01   %zmm14
-#define  SHUF_01   %zmm15
-#define BCAST_02   %zmm16
-#define  SHUF_02   %zmm17
-#define BCAST_10   %zmm18
-#define  SHUF_10   %zmm19
-#define BCAST_11   %zmm20
-#define  SHUF_11   %zmm21
-#define BCAST_12   %zmm22
-#define  SHUF_12   %zmm23
-
-#define Mp  %zmm24
-#define Mps %zmm25
-#define Mm  %zmm26
-#define Mms %zmm27
-#define N 8
-    int incr=LLs*LLs*sizeof(iSinglet<Simd>);
-    for(int s1=0;s1<LLs;s1++){ 
-      for(int s2=0;s2<LLs;s2++){ 
-	int lex=s2+LLs*site;
-	uint64_t a0 = (uint64_t)&Matp[LLs*s2+s1]; // should be cacheable
-	uint64_t a1 = (uint64_t)&Matm[LLs*s2+s1];
-	uint64_t a2 = (uint64_t)&psi[lex];
-	for(int  l=0; l<Simd::Nsimd();l++){ // simd lane
-	  if ( (s2+l)==0 ) {
-	    LOAD64(%r8,a0);
-	    LOAD64(%r9,a1);
-	    LOAD64(%r10,a2);
-	    asm (
-		 VLOAD(0,%r8,Mp)// i r
-		 VLOAD(0,%r9,Mm)
-		 VSHUF(Mp,Mps)  // r i 
-		 VSHUF(Mm,Mms)
-		 VPREFETCH1(12,%r10)  	     VPREFETCH1(13,%r10)
-		 VPREFETCH1(14,%r10)  	     VPREFETCH1(15,%r10)         
-
-		 VMULIDUP(0*N,%r10,Mps,Chi_00)
-		 VMULIDUP(1*N,%r10,Mps,Chi_01)
-		 VMULIDUP(2*N,%r10,Mps,Chi_02)
-		 VMULIDUP(3*N,%r10,Mps,Chi_10)
-		 VMULIDUP(4*N,%r10,Mps,Chi_11)
-		 VMULIDUP(5*N,%r10,Mps,Chi_12)
-
-		 VMULIDUP(6*N ,%r10,Mms,Chi_20)
-		 VMULIDUP(7*N ,%r10,Mms,Chi_21)
-		 VMULIDUP(8*N ,%r10,Mms,Chi_22)
-		 VMULIDUP(9*N ,%r10,Mms,Chi_30)
-		 VMULIDUP(10*N,%r10,Mms,Chi_31)
-		 VMULIDUP(11*N,%r10,Mms,Chi_32)
-
-		 VMADDSUBRDUP(0*N,%r10,Mp,Chi_00)
-		 VMADDSUBRDUP(1*N,%r10,Mp,Chi_01)
-		 VMADDSUBRDUP(2*N,%r10,Mp,Chi_02)
-		 VMADDSUBRDUP(3*N,%r10,Mp,Chi_10)
-		 VMADDSUBRDUP(4*N,%r10,Mp,Chi_11)
-		 VMADDSUBRDUP(5*N,%r10,Mp,Chi_12)
-
-		 VMADDSUBRDUP(6*N ,%r10,Mm,Chi_20)
-		 VMADDSUBRDUP(7*N ,%r10,Mm,Chi_21)
-		 VMADDSUBRDUP(8*N ,%r10,Mm,Chi_22)
-		 VMADDSUBRDUP(9*N ,%r10,Mm,Chi_30)
-		 VMADDSUBRDUP(10*N,%r10,Mm,Chi_31)
-		 VMADDSUBRDUP(11*N,%r10,Mm,Chi_32)
-		 );
-	  } else { 
-	    LOAD64(%r8,a0);
-	    LOAD64(%r9,a1);
-	    LOAD64(%r10,a2);
-	    asm (
-		 VLOAD(0,%r8,Mp)
-		 VSHUF(Mp,Mps)
-
-		 VLOAD(0,%r9,Mm)
-		 VSHUF(Mm,Mms)
-
-		 VMADDSUBIDUP(0*N,%r10,Mps,Chi_00) //  Mri * Pii +- Cir
-		 VMADDSUBIDUP(1*N,%r10,Mps,Chi_01)
-		 VMADDSUBIDUP(2*N,%r10,Mps,Chi_02)
-		 VMADDSUBIDUP(3*N,%r10,Mps,Chi_10)
-		 VMADDSUBIDUP(4*N,%r10,Mps,Chi_11)
-		 VMADDSUBIDUP(5*N,%r10,Mps,Chi_12)
-
-		 VMADDSUBIDUP(6 *N,%r10,Mms,Chi_20)
-		 VMADDSUBIDUP(7 *N,%r10,Mms,Chi_21)
-		 VMADDSUBIDUP(8 *N,%r10,Mms,Chi_22)
-		 VMADDSUBIDUP(9 *N,%r10,Mms,Chi_30)
-		 VMADDSUBIDUP(10*N,%r10,Mms,Chi_31)
-		 VMADDSUBIDUP(11*N,%r10,Mms,Chi_32)
-
-		 VMADDSUBRDUP(0*N,%r10,Mp,Chi_00) //  Cir = Mir * Prr +- ( Mri * Pii +- Cir) 
-		 VMADDSUBRDUP(1*N,%r10,Mp,Chi_01) //  Ci = MiPr + Ci + MrPi ;    Cr = MrPr - ( MiPi - Cr)
-		 VMADDSUBRDUP(2*N,%r10,Mp,Chi_02)
-		 VMADDSUBRDUP(3*N,%r10,Mp,Chi_10)
-		 VMADDSUBRDUP(4*N,%r10,Mp,Chi_11)
-		 VMADDSUBRDUP(5*N,%r10,Mp,Chi_12)
-
-		 VMADDSUBRDUP(6 *N,%r10,Mm,Chi_20)
-		 VMADDSUBRDUP(7 *N,%r10,Mm,Chi_21)
-		 VMADDSUBRDUP(8 *N,%r10,Mm,Chi_22)
-		 VMADDSUBRDUP(9 *N,%r10,Mm,Chi_30)
-		 VMADDSUBRDUP(10*N,%r10,Mm,Chi_31)
-		 VMADDSUBRDUP(11*N,%r10,Mm,Chi_32)
-		 );
-	  }
-	  a0 = a0+incr;
-	  a1 = a1+incr;
-	a2 = a2+sizeof(typename Simd::scalar_type);
-	}}
-      {
-	int lexa = s1+LLs*site;
-	/*
-	  SiteSpinor tmp;
-	  asm (
-	  VSTORE(0,%0,pChi_00) VSTORE(1 ,%0,pChi_01)  VSTORE(2 ,%0,pChi_02)		
-	  VSTORE(3,%0,pChi_10) VSTORE(4 ,%0,pChi_11)  VSTORE(5 ,%0,pChi_12)		
-	  VSTORE(6,%0,pChi_20) VSTORE(7 ,%0,pChi_21)  VSTORE(8 ,%0,pChi_22)		
-	  VSTORE(9,%0,pChi_30) VSTORE(10,%0,pChi_31)  VSTORE(11,%0,pChi_32)		
-	  : : "r" ((uint64_t)&tmp) : "memory" );
-	*/
-
-	asm (
-	     VSTORE(0,%0,pChi_00) VSTORE(1 ,%0,pChi_01)  VSTORE(2 ,%0,pChi_02)		
-	     VSTORE(3,%0,pChi_10) VSTORE(4 ,%0,pChi_11)  VSTORE(5 ,%0,pChi_12)		
-	     VSTORE(6,%0,pChi_20) VSTORE(7 ,%0,pChi_21)  VSTORE(8 ,%0,pChi_22)		
-	     VSTORE(9,%0,pChi_30) VSTORE(10,%0,pChi_31)  VSTORE(11,%0,pChi_32)		
-	     : : "r" ((uint64_t)&chi[lexa]) : "memory" );
-
-	//      if ( 1 || (site==0) ) { 
-	//	std::cout<<site << " s1 "<<s1<<"\n\t"<<tmp << "\n't" << chi[lexa] <<"\n\t"<<tmp-chi[lexa]<<std::endl;
-	//      }
-      }
-    }
-  }
-#undef Chi_00
-#undef Chi_01
-#undef Chi_02
-#undef Chi_10
-#undef Chi_11
-#undef Chi_12
-#undef Chi_20
-#undef Chi_21
-#undef Chi_22
-#undef Chi_30
-#undef Chi_31
-#undef Chi_32
-
-#undef BCAST0
-#undef BCAST1
-#undef BCAST2
-#undef BCAST3
-#undef BCAST4
-#undef BCAST5
-#undef BCAST6
-#undef BCAST7
-#undef BCAST8
-#undef BCAST9
-#undef BCAST10
-#undef BCAST11
-
-#endif
-};
-
+  MooeeInternal(psi,chi,DaggerNo,InverseYes);
+}
 
 template<class Impl>
 void
-CayleyFermion5D<Impl>::MooeeInternal(const FermionField &psi, FermionField &chi,int dag, int inv)
+CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi, FermionField &chi)
 {
-  EnableIf<Impl::LsVectorised,int> sfinae=0;
-  chi.Checkerboard()=psi.Checkerboard();
-
-  int Ls=this->Ls;
-  int LLs = psi.Grid()->_rdimensions[0];
-  int vol = psi.Grid()->oSites()/LLs;
-
-  
-  Vector<iSinglet<Simd> >  Matp;
-  Vector<iSinglet<Simd> >  Matm;
-  Vector<iSinglet<Simd> >  *_Matp;
-  Vector<iSinglet<Simd> >  *_Matm;
-  
-  //  MooeeInternalCompute(dag,inv,Matp,Matm);
-  if ( inv && dag ) { 
-    _Matp = &MatpInvDag;
-    _Matm = &MatmInvDag;
-  }
-  if ( inv && (!dag) ) { 
-    _Matp = &MatpInv;
-    _Matm = &MatmInv;
-  } 
-  if ( !inv ) {
-    MooeeInternalCompute(dag,inv,Matp,Matm);
-    _Matp = &Matp;
-    _Matm = &Matm;
-  }
-  assert(_Matp->size()==Ls*LLs);
+  MooeeInternal(psi,chi,DaggerYes,InverseYes);
+}
 
-  MooeeInvCalls++;
-  MooeeInvTime-=usecond();
+////////////////////////////////////////////////////////////////////////////////
+// The fused Schur operator assumes s is the fastest outer index; compose it.
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcFused(const FermionField &in, FermionField &out,
+				     FermionField &tmp, FermionField &col)
+{
+  CheckerBoardedSparseMatrixBase<FermionField>::MpcFused(in,out,tmp,col);
+}
 
-  if ( switcheroo<Coeff_t>::iscomplex() ) {
-    thread_loop( (auto site=0;site<vol;site++),{
-      MooeeInternalZAsm(psi,chi,LLs,site,*_Matp,*_Matm);
-    });
-  } else { 
-    thread_loop( (auto site=0;site<vol;site++),{
-      MooeeInternalAsm(psi,chi,LLs,site,*_Matp,*_Matm);
-    });
-  }
-  MooeeInvTime+=usecond();
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcDagFused(const FermionField &in, FermionField &out,
+					FermionField &tmp, FermionField &col)
+{
+  CheckerBoardedSparseMatrixBase<FermionField>::MpcDagFused(in,out,tmp,col);
 }
 
 NAMESPACE_END(Grid);
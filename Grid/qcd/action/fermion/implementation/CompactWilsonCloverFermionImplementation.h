@@ -55,7 +55,6 @@ CompactWilsonCloverFermion<Impl, CloverHelpers>::CompactWilsonCloverFermion(Gaug
   , DiagonalInv(&Fgrid),     TriangleInv(&Fgrid)
   , DiagonalInvEven(&Hgrid), TriangleInvEven(&Hgrid)
   , DiagonalInvOdd(&Hgrid),  TriangleInvOdd(&Hgrid)
-  , Tmp(&Fgrid)
   , BoundaryMask(&Fgrid)
   , BoundaryMaskEven(&Hgrid), BoundaryMaskOdd(&Hgrid)
 {
@@ -110,8 +109,7 @@ template<class Impl, class CloverHelpers>
 void CompactWilsonCloverFermion<Impl, CloverHelpers>::M(const FermionField& in, FermionField& out) {
   out.Checkerboard() = in.Checkerboard();
   WilsonBase::Dhop(in, out, DaggerNo); // call base to save applying bc
-  Mooee(in, Tmp);
-  axpy(out, 1.0, out, Tmp);
+  MooeeAddInternal(in, out, out);
   if(fixedBoundaries) ApplyBoundaryMask(out);
 }
 
@@ -119,8 +117,7 @@ template<class Impl, class CloverHelpers>
 void CompactWilsonCloverFermion<Impl, CloverHelpers>::Mdag(const FermionField& in, FermionField& out) {
   out.Checkerboard() = in.Checkerboard();
   WilsonBase::Dhop(in, out, DaggerYes);  // call base to save applying bc
-  MooeeDag(in, Tmp);
-  axpy(out, 1.0, out, Tmp);
+  MooeeAddInternal(in, out, out); // blocks are hermitian
   if(fixedBoundaries) ApplyBoundaryMask(out);
 }
 
@@ -291,6 +288,25 @@ void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeInternal(const Fermio
   CompactHelpers::MooeeKernel(diagonal.oSites(), 1, in, out, diagonal, triangle);
 }
 
+template<class Impl, class CloverHelpers>
+void CompactWilsonCloverFermion<Impl, CloverHelpers>::MooeeAddInternal(const FermionField& in,
+                                                                      const FermionField& hop,
+                                                                      FermionField&       out) {
+  conformable(in, hop);
+  conformable(in, out);
+  out.Checkerboard() = in.Checkerboard();
+
+  const CloverDiagonalField* diagonal = &Diagonal;
+  const CloverTriangleField* triangle = &Triangle;
+  if(in.Grid()->_isCheckerBoarded) {
+    diagonal = (in.Checkerboard() == Odd) ? &DiagonalOdd : &DiagonalEven;
+    triangle = (in.Checkerboard() == Odd) ? &TriangleOdd : &TriangleEven;
+  }
+  conformable(in, *diagonal);
+
+  CompactHelpers::MooeeAddKernel(diagonal->oSites(), 1, in, hop, out, *diagonal, *triangle);
+}
+
 template<class Impl, class CloverHelpers>
 void CompactWilsonCloverFermion<Impl, CloverHelpers>::ImportGauge(const GaugeField& _Umu) {
   // NOTE: parts copied from original implementation
@@ -74,34 +74,27 @@ WilsonCloverFermion<Impl, CloverHelpers>::WilsonCloverFermion(GaugeField&
 }
 
 // *NOT* EO
+// The clover term is applied in the sweep that completes the hopping term
 template<class Impl, class CloverHelpers>
 void WilsonCloverFermion<Impl, CloverHelpers>::M(const FermionField &in, FermionField &out)
 {
-  FermionField temp(out.Grid());
-
   // Wilson term
   out.Checkerboard() = in.Checkerboard();
   this->Dhop(in, out, DaggerNo);
 
   // Clover term
-  Mooee(in, temp);
-
-  out += temp;
+  Helpers::multCloverAddField(out, CloverTerm, in, out);
 }
 
 template<class Impl, class CloverHelpers>
 void WilsonCloverFermion<Impl, CloverHelpers>::Mdag(const FermionField &in, FermionField &out)
 {
-  FermionField temp(out.Grid());
-
   // Wilson term
   out.Checkerboard() = in.Checkerboard();
   this->Dhop(in, out, DaggerYes);
 
-  // Clover term
-  MooeeDag(in, temp);
-
-  out += temp;
+  // Clover term, hermitian
+  Helpers::multCloverAddField(out, CloverTerm, in, out);
 }
 
 template<class Impl, class CloverHelpers>
@@ -360,19 +360,47 @@ void WilsonFermion5D<Impl>::DhopInternal(StencilImpl & st, LebesgueOrder &lo,
                                          DoubledGaugeField & U,
                                          const FermionField &in, FermionField &out,int dag)
 {
+  WilsonKernelsChoice choice = DhopChoice(st,lo,U,in,out,dag); // not timed: may run the tuning sweeps
   DhopTotalTime-=usecond();
-  if ( WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute )
-    DhopInternalOverlappedComms(st,lo,U,in,out,dag);
+  if ( choice.Comms == WilsonKernelsStatic::CommsAndCompute )
+    DhopInternalOverlappedComms(st,lo,U,in,out,dag,choice.Opt);
   else 
-    DhopInternalSerialComms(st,lo,U,in,out,dag);
+    DhopInternalSerialComms(st,lo,U,in,out,dag,choice.Opt);
   DhopTotalTime+=usecond();
 }
 
+template<class Impl>
+WilsonKernelsChoice WilsonFermion5D<Impl>::DhopChoice(StencilImpl & st, LebesgueOrder &lo,
+						      DoubledGaugeField & U,
+						      const FermionField &in, FermionField &out,int dag)
+{
+  WilsonKernelsChoice choice = {WilsonKernelsStatic::Opt, WilsonKernelsStatic::Comms};
+  if ( !WilsonKernelsTuner::Enabled && !GridTuneCache::Persistent() ) return choice;
+
+  auto tuned = DhopTuned.find(&st);
+  if ( tuned != DhopTuned.end() ) return tuned->second;
+
+  std::string op = std::string("WilsonFermion5D.") + typeid(Impl).name();
+  int handunroll = (Impl::Dimension == 3);
+  // the sweeps run the timed internals: keep them out of the Dhop counters
+  double comm = DhopCommTime, face = DhopFaceTime, compute = DhopComputeTime, compute2 = DhopComputeTime2;
+  choice = WilsonKernelsTuner::Tune(op, in.Grid(), Ls, handunroll,
+				    [&](const WilsonKernelsChoice &c) {
+				      if ( c.Comms == WilsonKernelsStatic::CommsAndCompute )
+					DhopInternalOverlappedComms(st,lo,U,in,out,dag,c.Opt);
+				      else
+					DhopInternalSerialComms(st,lo,U,in,out,dag,c.Opt);
+				    });
+  DhopCommTime = comm; DhopFaceTime = face; DhopComputeTime = compute; DhopComputeTime2 = compute2;
+  DhopTuned[&st] = choice;
+  return choice;
+}
+
 
 template<class Impl>
 void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, LebesgueOrder &lo,
 							DoubledGaugeField & U,
-							const FermionField &in, FermionField &out,int dag)
+							const FermionField &in, FermionField &out,int dag,int Opt)
 {
   Compressor compressor(dag);
 
@@ -400,7 +428,6 @@ void WilsonFermion5D<Impl>::DhopInternalOverlappedComms(StencilImpl & st, Lebesg
   /////////////////////////////
   // do the compute interior
   /////////////////////////////
-  int Opt = WilsonKernelsStatic::Opt; // Why pass this. Kernels should know
   DhopComputeTime-=usecond();
   if (dag == DaggerYes) {
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out,1,0);
@@ -436,7 +463,7 @@ template<class Impl>
 void WilsonFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st, LebesgueOrder &lo,
 						    DoubledGaugeField & U,
 						    const FermionField &in, 
-						    FermionField &out,int dag)
+						    FermionField &out,int dag,int Opt)
 {
   Compressor compressor(dag);
 
@@ -447,7 +474,6 @@ void WilsonFermion5D<Impl>::DhopInternalSerialComms(StencilImpl & st, LebesgueOr
   DhopCommTime+=usecond();
   
   DhopComputeTime-=usecond();
-  int Opt = WilsonKernelsStatic::Opt;
   if (dag == DaggerYes) {
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),LLs,U.oSites(),in,out);
   } else {
@@ -488,21 +488,52 @@ void WilsonFermion<Impl>::DhopInternal(StencilImpl &st, LebesgueOrder &lo,
                                        const FermionField &in,
                                        FermionField &out, int dag)
 {
+  WilsonKernelsChoice choice = DhopChoice(st,lo,U,in,out,dag); // not timed: may run the tuning sweeps
   DhopTotalTime-=usecond();
 #ifdef GRID_OMP
-  if ( WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute )
-    DhopInternalOverlappedComms(st,lo,U,in,out,dag);
+  if ( choice.Comms == WilsonKernelsStatic::CommsAndCompute )
+    DhopInternalOverlappedComms(st,lo,U,in,out,dag,choice.Opt);
   else
 #endif
-    DhopInternalSerial(st,lo,U,in,out,dag);
+    DhopInternalSerial(st,lo,U,in,out,dag,choice.Opt);
   DhopTotalTime+=usecond();
 }
 
+template <class Impl>
+WilsonKernelsChoice WilsonFermion<Impl>::DhopChoice(StencilImpl &st, LebesgueOrder &lo,
+                                                    DoubledGaugeField &U,
+                                                    const FermionField &in,
+                                                    FermionField &out, int dag)
+{
+  WilsonKernelsChoice choice = {WilsonKernelsStatic::Opt, WilsonKernelsStatic::Comms};
+  if ( !WilsonKernelsTuner::Enabled && !GridTuneCache::Persistent() ) return choice;
+
+  auto tuned = DhopTuned.find(&st);
+  if ( tuned != DhopTuned.end() ) return tuned->second;
+
+  std::string op = std::string("WilsonFermion.") + typeid(Impl).name();
+  int handunroll = (Impl::Dimension == 3);
+  // the sweeps run the timed internals: keep them out of the Dhop counters
+  double comm = DhopCommTime, face = DhopFaceTime, compute = DhopComputeTime, compute2 = DhopComputeTime2;
+  choice = WilsonKernelsTuner::Tune(op, in.Grid(), 1, handunroll,
+                                    [&](const WilsonKernelsChoice &c) {
+#ifdef GRID_OMP
+                                      if ( c.Comms == WilsonKernelsStatic::CommsAndCompute )
+                                        DhopInternalOverlappedComms(st,lo,U,in,out,dag,c.Opt);
+                                      else
+#endif
+                                        DhopInternalSerial(st,lo,U,in,out,dag,c.Opt);
+                                    });
+  DhopCommTime = comm; DhopFaceTime = face; DhopComputeTime = compute; DhopComputeTime2 = compute2;
+  DhopTuned[&st] = choice;
+  return choice;
+}
+
 template <class Impl>
 void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueOrder &lo,
 						      DoubledGaugeField &U,
 						      const FermionField &in,
-						      FermionField &out, int dag)
+						      FermionField &out, int dag, int Opt)
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
 
@@ -531,7 +562,6 @@ void WilsonFermion<Impl>::DhopInternalOverlappedComms(StencilImpl &st, LebesgueO
   /////////////////////////////
   // do the compute interior
   /////////////////////////////
-  int Opt = WilsonKernelsStatic::Opt;
   DhopComputeTime-=usecond();
   if (dag == DaggerYes) {
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),1,U.oSites(),in,out,1,0);
@@ -568,7 +598,7 @@ template <class Impl>
 void WilsonFermion<Impl>::DhopInternalSerial(StencilImpl &st, LebesgueOrder &lo,
                                        DoubledGaugeField &U,
                                        const FermionField &in,
-                                       FermionField &out, int dag)
+                                       FermionField &out, int dag, int Opt)
 {
   assert((dag == DaggerNo) || (dag == DaggerYes));
   Compressor compressor(dag);
@@ -577,7 +607,6 @@ void WilsonFermion<Impl>::DhopInternalSerial(StencilImpl &st, LebesgueOrder &lo,
   DhopCommTime+=usecond();
 
   DhopComputeTime-=usecond();
-  int Opt = WilsonKernelsStatic::Opt;
   if (dag == DaggerYes) {
     Kernels::DhopDagKernel(Opt,st,U,st.CommBuf(),1,U.oSites(),in,out);
   } else {
@@ -120,12 +120,8 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 
 #define MULT_2SPIN(A)\
   {auto & ref(U[sU](A));						\
-    U_00=coalescedRead(ref()(0,0),lane);				\
-    U_10=coalescedRead(ref()(1,0),lane);				\
-    U_20=coalescedRead(ref()(2,0),lane);				\
-    U_01=coalescedRead(ref()(0,1),lane);				\
-    U_11=coalescedRead(ref()(1,1),lane);				\
-    U_21=coalescedRead(ref()(2,1),lane);				\
+    loadLinkColumn(U_00,U_10,U_20,ref,0,lane);				\
+    loadLinkColumn(U_01,U_11,U_21,ref,1,lane);				\
     UChi_00 = U_00*Chi_00;						\
     UChi_10 = U_00*Chi_10;						\
     UChi_01 = U_10*Chi_00;						\
@@ -138,9 +134,7 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
     UChi_11+= U_11*Chi_11;						\
     UChi_02+= U_21*Chi_01;						\
     UChi_12+= U_21*Chi_11;						\
-    U_00=coalescedRead(ref()(0,2),lane);				\
-    U_10=coalescedRead(ref()(1,2),lane);				\
-    U_20=coalescedRead(ref()(2,2),lane);				\
+    loadLinkColumn(U_00,U_10,U_20,ref,2,lane);				\
     UChi_00+= U_00*Chi_02;						\
     UChi_10+= U_00*Chi_12;						\
     UChi_01+= U_10*Chi_02;						\
@@ -548,6 +542,31 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 
 NAMESPACE_BEGIN(Grid);
 
+////////////////////////////////////////////////////////////////////////
+// Column c of a doubled link into three registers. Full colour matrices
+// are read directly; compressed links (WilsonCompressedImpl) rebuild
+// row 2 from the two stored rows and the phase in registers.
+////////////////////////////////////////////////////////////////////////
+template<class reg,class vtype,int N> accelerator_inline void
+loadLinkColumn(reg &U0,reg &U1,reg &U2,const iScalar<iMatrix<vtype,N> > &ref,int c,int lane)
+{
+  U0=coalescedRead(ref()(0,c),lane);
+  U1=coalescedRead(ref()(1,c),lane);
+  U2=coalescedRead(ref()(2,c),lane);
+}
+template<class reg,class vtype,int N> accelerator_inline void
+loadLinkColumn(reg &U0,reg &U1,reg &U2,const iScalar<iVector<vtype,N> > &ref,int c,int lane)
+{
+  const int nc = (N-1)/2;
+  int c1 = (c+1)%nc;
+  int c2 = (c+2)%nc;
+  U0=coalescedRead(ref()(c),lane);
+  U1=coalescedRead(ref()(nc+c),lane);
+  U2=coalescedRead(ref()(2*nc),lane)
+    *conjugate(coalescedRead(ref()(c1),lane)*coalescedRead(ref()(nc+c2),lane)
+	      -coalescedRead(ref()(c2),lane)*coalescedRead(ref()(nc+c1),lane));
+}
+
 
 #ifdef SYCL_HACK
 template<class Impl> accelerator_inline void 
@@ -59,6 +59,22 @@ NAMESPACE_BEGIN(Grid);
  axpibg5x(chi,psi,a,b);
 */
 
+template<class Impl>
+void WilsonTMFermion<Impl>::M(const FermionField &in, FermionField &out) {
+  RealD a = 4.0+this->mass;
+  RealD b = this->mu;
+  out.Checkerboard() = in.Checkerboard();
+  this->Dhop(in,out,DaggerNo);
+  axpibg5xpy(out,in,a,b,out);
+}
+template<class Impl>
+void WilsonTMFermion<Impl>::Mdag(const FermionField &in, FermionField &out) {
+  RealD a = 4.0+this->mass;
+  RealD b = -this->mu;
+  out.Checkerboard() = in.Checkerboard();
+  this->Dhop(in,out,DaggerYes);
+  axpibg5xpy(out,in,a,b,out);
+}
 template<class Impl>
 void WilsonTMFermion<Impl>::Mooee(const FermionField &in, FermionField &out) {
   RealD a = 4.0+this->mass;
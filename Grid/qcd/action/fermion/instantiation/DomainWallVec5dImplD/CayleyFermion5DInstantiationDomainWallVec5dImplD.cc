@@ -0,0 +1 @@
+../CayleyFermion5DInstantiationVec5d.cc.master
\ No newline at end of file
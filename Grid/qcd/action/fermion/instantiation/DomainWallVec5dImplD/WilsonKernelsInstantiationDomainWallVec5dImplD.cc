@@ -0,0 +1 @@
+../WilsonKernelsInstantiation.cc.master
\ No newline at end of file
@@ -0,0 +1 @@
+#define IMPLEMENTATION DomainWallVec5dImplD
@@ -18,6 +18,10 @@ WILSON_IMPL_LIST=" \
 	   GparityWilsonImplF \
 	   GparityWilsonImplD "
 
+COMPRESSED_WILSON_IMPL_LIST=" \
+	   WilsonImplCompressedF \
+	   WilsonImplCompressedD "
+
 COMPACT_WILSON_IMPL_LIST=" \
 	   WilsonImplF \
 	   WilsonImplD "
@@ -32,7 +36,11 @@ GDWF_IMPL_LIST=" \
 	   GparityWilsonImplF \
 	   GparityWilsonImplD "
 
-IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST"
+VEC5D_IMPL_LIST=" \
+	   DomainWallVec5dImplF \
+	   DomainWallVec5dImplD "
+
+IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $COMPRESSED_WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST $VEC5D_IMPL_LIST"
 
 for impl in $IMPL_LIST
 do
@@ -54,6 +62,16 @@ do
 done
 done
 
+CC_LIST="WilsonFermionInstantiation WilsonKernelsInstantiation"
+
+for impl in $COMPRESSED_WILSON_IMPL_LIST
+do
+for f in $CC_LIST
+do
+  ln -f -s ../$f.cc.master $impl/$f$impl.cc
+done
+done
+
 CC_LIST="CompactWilsonCloverFermionInstantiation"
 
 for impl in $COMPACT_WILSON_IMPL_LIST
@@ -87,6 +105,20 @@ do
   ln -f -s ../WilsonKernelsInstantiationGparity.cc.master $impl/WilsonKernelsInstantiation$impl.cc
 done
 
+# Ls vectorised domain wall: Cayley operators only, with the s-vectorised 5d routines
+CC_LIST=" \
+  WilsonFermion5DInstantiation \
+  WilsonKernelsInstantiation "
+
+for impl in $VEC5D_IMPL_LIST
+do
+for f in $CC_LIST
+do
+  ln -f -s ../$f.cc.master $impl/$f$impl.cc
+done
+  ln -f -s ../CayleyFermion5DInstantiationVec5d.cc.master $impl/CayleyFermion5DInstantiation$impl.cc
+done
+
 
 CC_LIST=" \
   ImprovedStaggeredFermion5DInstantiation \
@@ -54,6 +54,7 @@ public:
 
   HMCparameters Parameters;
   std::string ParameterFile;
+  std::string StatisticsFile;
   HMCResourceManager<Implementation> Resources;
 
   // The set of actions (keep here for lower level users, for now)
@@ -116,6 +117,10 @@ public:
       arg = GridCmdOptionPayload(argv, argv + argc, "--ParameterFile");
       ParameterFile = arg;
     }
+    if (GridCmdOptionExists(argv, argv + argc, "--IntegratorStatistics")) {
+      arg = GridCmdOptionPayload(argv, argv + argc, "--IntegratorStatistics");
+      StatisticsFile = arg;
+    }
   }
 
 
@@ -174,6 +179,7 @@ private:
                                         Resources.GetSerialRNG(),
                                         Resources.GetParallelRNG(), 
                                         Resources.GetObservables(), U);
+    HMC.setStatisticsFile(StatisticsFile);
 
     // Run it
     HMC.evolve();
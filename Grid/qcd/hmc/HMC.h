@@ -105,6 +105,9 @@ private:
   IntegratorType &TheIntegrator;
   ObsListType Observables;
 
+  // Integrator statistics file stem; empty disables collection
+  std::string StatisticsFile;
+
   /////////////////////////////////////////////////////////
   // Metropolis step
   /////////////////////////////////////////////////////////
@@ -185,6 +188,26 @@ public:
     : Params(_Pams), TheIntegrator(_Int), sRNG(_sRNG), pRNG(_pRNG), Observables(_Obs), Ucur(_U) {}
   ~HybridMonteCarlo(){};
 
+  /////////////////////////////////////////
+  // Per-trajectory integrator statistics, written as
+  // <stem>.<traj>.xml or <stem>.<traj>.json
+  /////////////////////////////////////////
+  void setStatisticsFile(const std::string &file) {
+    StatisticsFile = file;
+    TheIntegrator.setCollectStatistics(!file.empty());
+  }
+
+  std::string statisticsFileName(int traj) const {
+    std::string stem = StatisticsFile;
+    std::string ext  = "xml";
+    std::size_t dot  = stem.rfind('.');
+    if ((dot != std::string::npos) && (stem.substr(dot + 1) == "xml" || stem.substr(dot + 1) == "json")) {
+      ext  = stem.substr(dot + 1);
+      stem = stem.substr(0, dot);
+    }
+    return stem + "." + std::to_string(traj) + "." + ext;
+  }
+
   void evolve(void) {
     Real DeltaH;
 
@@ -204,6 +227,10 @@ public:
       double t0=usecond();
       Ucopy = Ucur;
 
+      // Labels the statistics the integrator prints at the end of the trajectory
+      IntegratorStatistics &Stats = TheIntegrator.getStatistics();
+      Stats.trajectory = traj;
+
       DeltaH = evolve_hmc_step(Ucopy);
       // Metropolis-Hastings test
       bool accept = true;
@@ -221,6 +248,10 @@ public:
       double t1=usecond();
       std::cout << GridLogMessage << "Total time for trajectory (s): " << (t1-t0)/1e6 << std::endl;
 
+      if (!StatisticsFile.empty()) {
+        Stats.save(statisticsFileName(traj), Ucur.Grid());
+      }
+
 
       for (int obs = 0; obs < Observables.size(); obs++) {
       	std::cout << GridLogDebug << "Observables # " << obs << std::endl;
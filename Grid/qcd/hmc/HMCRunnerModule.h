@@ -121,6 +121,28 @@ class HMCForceGradient: public HMCModule< GenericHMCRunnerTemplate<Implementatio
   }
 };
 
+template < class ImplementationPolicy, class RepresentationPolicy, class ReaderClass >
+class HMCOmelyanForceGradient: public HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OmelyanForceGradient>, ReaderClass  >{
+  typedef HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OmelyanForceGradient>, ReaderClass   > HMCBaseMod;
+  using HMCBaseMod::HMCBaseMod;
+
+  // aquire resource
+  virtual void initialize(){
+    this->HMCPtr.reset(new GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, OmelyanForceGradient>(this->Par_) );
+  }
+};
+
+template < class ImplementationPolicy, class RepresentationPolicy, class ReaderClass >
+class HMCMinimumNorm4: public HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, MinimumNorm4>, ReaderClass  >{
+  typedef HMCModule< GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, MinimumNorm4>, ReaderClass  > HMCBaseMod;
+  using HMCBaseMod::HMCBaseMod;
+
+  // aquire resource
+  virtual void initialize(){
+    this->HMCPtr.reset(new GenericHMCRunnerTemplate<ImplementationPolicy, RepresentationPolicy, MinimumNorm4>(this->Par_));
+  }
+};
+
 extern char hmc_string[];
 
 //////////////////////////////////////////////////////////////
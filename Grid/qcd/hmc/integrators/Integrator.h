@@ -34,6 +34,7 @@ directory
 
 #include <memory>
 #include "MomentumFilter.h"
+#include "IntegratorStatistics.h"
 
 NAMESPACE_BEGIN(Grid);
 
@@ -86,6 +87,11 @@ protected:
 
   const ActionSet<Field, RepresentationPolicy> as;
 
+  // Per-monomial timing, solver iteration and force norm records for the
+  // current trajectory; the site max norm is only computed when enabled
+  IntegratorStatistics Stats;
+  bool CollectStatistics;
+
   //Get a pointer to a shared static instance of the "do-nothing" momentum filter to serve as a default
   static MomentumFilterBase<MomentaField> const* getDefaultMomFilter(){ 
     static MomentumFilterNone<MomentaField> filter;
@@ -130,12 +136,14 @@ protected:
 
       Field& Us = Smearer.get_U(as[level].actions.at(a)->is_smeared);
       double start_force = usecond();
+      uint64_t start_iter = SolverIterationCounter::Total();
       as[level].actions.at(a)->deriv(Us, force);  // deriv should NOT include Ta
 
       std::cout << GridLogIntegrator << "Smearing (on/off): " << as[level].actions.at(a)->is_smeared << std::endl;
       if (as[level].actions.at(a)->is_smeared) Smearer.smeared_force(force);
       force = FieldImplementation::projectForce(force); // Ta for gauge fields
       double end_force = usecond();
+      uint64_t iter = SolverIterationCounter::Total() - start_iter;
       Real force_abs = std::sqrt(norm2(force)/U.Grid()->gSites());
       std::cout << GridLogIntegrator << "["<<level<<"]["<<a<<"] Force average: " << force_abs << std::endl;
       Mom -= force * ep* HMC_MOMENTUM_DENOMINATOR;; 
@@ -143,6 +151,12 @@ protected:
       double time_full  = (end_full - start_full) / 1e3;
       double time_force = (end_force - start_force) / 1e3;
       std::cout << GridLogMessage << "["<<level<<"]["<<a<<"] P update elapsed time: " << time_full << " ms (force: " << time_force << " ms)"  << std::endl;
+      if (CollectStatistics) {
+        // outside the timed region; the force belongs to the gauge field at t_U
+        Real force_max = std::sqrt(maxLocalNorm2(force));
+        std::cout << GridLogIntegrator << "["<<level<<"]["<<a<<"] Force max    : " << force_max << std::endl;
+        Stats.monomials[statisticsIndex(level, a)].record(t_U, time_full, time_force, iter, force_abs, force_max);
+      }
     }
 
     // Force from the other representations
@@ -174,6 +188,12 @@ protected:
 
   virtual void step(Field& U, int level, int first, int last) = 0;
 
+  int statisticsIndex(int level, int a) {
+    int idx = a;
+    for (int l = 0; l < level; ++l) idx += as[l].actions.size();
+    return idx;
+  }
+
 public:
   Integrator(GridBase* grid, IntegratorParameters Par,
              ActionSet<Field, RepresentationPolicy>& Aset,
@@ -183,7 +203,8 @@ public:
       P(grid),
       levels(Aset.size()),
       Smearer(Sm),
-      Representations(grid) 
+      Representations(grid),
+      CollectStatistics(false)
   {
     t_P.resize(levels, 0.0);
     t_U = 0.0;
@@ -191,6 +212,12 @@ public:
 
     //Default the momentum filter to "do-nothing"
     MomFilter = getDefaultMomFilter();
+
+    for (int level = 0; level < as.size(); ++level) {
+      for (int actionID = 0; actionID < as[level].actions.size(); ++actionID) {
+        Stats.monomials.push_back(MonomialStatistics(as[level].actions.at(actionID)->action_name(), level, actionID));
+      }
+    }
   };
 
   virtual ~Integrator() {}
@@ -204,6 +231,11 @@ public:
 
   //Access the conjugate momentum
   const MomentaField & getMomentum() const{ return P; }
+
+  //Enable per-monomial force/cost statistics, reset at the start of every integrate()
+  void setCollectStatistics(bool collect) { CollectStatistics = collect; }
+  bool collectingStatistics(void) const { return CollectStatistics; }
+  IntegratorStatistics & getStatistics(void) { return Stats; }
   
 
   void print_parameters()
@@ -328,6 +360,10 @@ public:
       t_P[level] = 0;
     }
 
+    Stats.reset(Params.trajL, Params.MDsteps);
+    Stats.integrator = integrator_name();
+    double start_traj = usecond();
+
     for (int stp = 0; stp < Params.MDsteps; ++stp) {  // MD step
       int first_step = (stp == 0);
       int last_step = (stp == Params.MDsteps - 1);
@@ -345,6 +381,9 @@ public:
     // and that we indeed got to the end of the trajectory
     assert(fabs(t_U - Params.trajL) < 1.0e-6);
 
+    Stats.time_trajectory_ms = (usecond() - start_traj) / 1e3;
+    if (CollectStatistics) Stats.print();
+
   }
 
 };
@@ -0,0 +1,151 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/hmc/integrators/IntegratorStatistics.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+//--------------------------------------------------------------------
+#ifndef INTEGRATOR_STATISTICS
+#define INTEGRATOR_STATISTICS
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////
+// Per-monomial cost and force record, accumulated over one trajectory.
+// The md_hist_* histograms bin the force evaluations by MD time, one bin
+// per outer integrator step; the md_time/force vectors keep every single
+// evaluation for finer offline binning.
+////////////////////////////////////////////////////////////////////////
+class MonomialStatistics: Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(MonomialStatistics,
+				  std::string, name,
+				  int, level,
+				  int, id,
+				  Integer, force_evaluations,
+				  Integer, solver_iterations,
+				  RealD, time_total_ms,    // deriv + smearing + projection + momentum update
+				  RealD, time_force_ms,    // deriv + smearing + projection
+				  RealD, force_max,        // max over evaluations of the largest site norm
+				  RealD, force_average,    // mean over evaluations of the rms site norm
+				  RealD, md_length,        // histogram range [0,md_length)
+				  std::vector<Integer>, md_hist_evaluations,
+				  std::vector<RealD>, md_hist_force_average,
+				  std::vector<RealD>, md_hist_force_max,
+				  std::vector<RealD>, md_time,
+				  std::vector<RealD>, md_force_average,
+				  std::vector<RealD>, md_force_max);
+
+  MonomialStatistics(std::string _name = "", int _level = 0, int _id = 0)
+    : name(_name), level(_level), id(_id) { reset(); }
+
+  void reset(RealD length = 1.0, int bins = 1) {
+    force_evaluations = 0;
+    solver_iterations = 0;
+    time_total_ms = 0.0;
+    time_force_ms = 0.0;
+    force_max     = 0.0;
+    force_average = 0.0;
+    md_length     = length;
+    md_hist_evaluations.assign(bins, 0);
+    md_hist_force_average.assign(bins, 0.0);
+    md_hist_force_max.assign(bins, 0.0);
+    md_time.resize(0);
+    md_force_average.resize(0);
+    md_force_max.resize(0);
+  }
+
+  // Evaluations on a bin boundary go to the bin that starts there
+  int bin(RealD t) const {
+    int bins = md_hist_evaluations.size();
+    int b = (int)std::floor(t/md_length*bins + 1.0e-6);
+    return std::min(std::max(b, 0), bins - 1);
+  }
+
+  void record(RealD t, RealD total_ms, RealD force_ms, uint64_t iter, RealD f_avg, RealD f_max) {
+    force_average = (force_average * force_evaluations + f_avg) / (force_evaluations + 1);
+    force_evaluations++;
+    solver_iterations += iter;
+    time_total_ms += total_ms;
+    time_force_ms += force_ms;
+    force_max = std::max(force_max, f_max);
+
+    int b = bin(t);
+    Integer n = md_hist_evaluations[b];
+    md_hist_force_average[b] = (md_hist_force_average[b] * n + f_avg) / (n + 1);
+    md_hist_force_max[b]     = std::max(md_hist_force_max[b], f_max);
+    md_hist_evaluations[b]   = n + 1;
+
+    md_time.push_back(t);
+    md_force_average.push_back(f_avg);
+    md_force_max.push_back(f_max);
+  }
+};
+
+class IntegratorStatistics: Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(IntegratorStatistics,
+				  std::string, integrator,
+				  Integer, trajectory,
+				  RealD, time_trajectory_ms,
+				  std::vector<MonomialStatistics>, monomials);
+
+  IntegratorStatistics() : trajectory(0), time_trajectory_ms(0.0) {}
+
+  // Histograms over [0,length) with one bin per outer MD step
+  void reset(RealD length = 1.0, int bins = 1) {
+    time_trajectory_ms = 0.0;
+    for (auto &m : monomials) m.reset(length, bins);
+  }
+
+  void print(void) const {
+    std::cout << GridLogMessage << ":::::::::::::::::::::::::::::::::::::::::" << std::endl;
+    std::cout << GridLogMessage << "[Integrator] Force statistics for trajectory " << trajectory << std::endl;
+    for (auto &m : monomials) {
+      std::cout << GridLogMessage << "[" << m.level << "][" << m.id << "] " << m.name
+		<< " : evals " << m.force_evaluations
+		<< " solver iters " << m.solver_iterations
+		<< " time " << m.time_total_ms << " ms (force " << m.time_force_ms << " ms)"
+		<< " |F| avg " << m.force_average << " max " << m.force_max << std::endl;
+    }
+    std::cout << GridLogMessage << ":::::::::::::::::::::::::::::::::::::::::" << std::endl;
+  }
+
+  // Written by the boss node only; the format follows the file extension
+  void save(const std::string &file, GridBase *grid) const {
+    if (!grid->IsBoss()) return;
+    if ((file.size() > 5) && (file.substr(file.size() - 5) == ".json")) {
+      JSONWriter WR(file);
+      write(WR, "IntegratorStatistics", *this);
+    } else {
+      XmlWriter WR(file);
+      write(WR, "IntegratorStatistics", *this);
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -271,6 +271,172 @@ public:
   }
 };
 
+/*
+ * Force gradient only where it is cheap.
+ *
+ * The force gradient step costs an extra force evaluation at the displaced
+ * field. On the outer (fermion) levels that is a full set of solves, so apply
+ * the force gradient step only on the selected levels (by default the innermost,
+ * usually the gauge action) and use the Omelyan minimum norm splitting elsewhere.
+ * Both are symmetric, so the composition remains reversible and area preserving.
+ */
+template <class FieldImplementation, class SmearingPolicy, class RepresentationPolicy = Representations<FundamentalRepresentation> >
+class OmelyanForceGradient : public ForceGradient<FieldImplementation, SmearingPolicy, RepresentationPolicy> 
+{
+private:
+  const RealD lambda_fg = 1.0 / 6.0;
+  const RealD chi       = 1.0 / 72.0;
+  const RealD lambda_mn = 0.1931833275037836;
+
+  std::vector<int> fg_levels;
+
+public:
+  INHERIT_FIELD_TYPES(FieldImplementation);
+
+  OmelyanForceGradient(GridBase* grid, IntegratorParameters Par,
+		       ActionSet<Field, RepresentationPolicy>& Aset,
+		       SmearingPolicy& Sm)
+    : ForceGradient<FieldImplementation, SmearingPolicy, RepresentationPolicy>(grid, Par, Aset, Sm)
+  {
+    fg_levels.resize(Aset.size(), 0);
+    fg_levels[Aset.size() - 1] = 1;
+  };
+
+  std::string integrator_name(){return "OmelyanForceGradient";}
+
+  // Select the levels which take the force gradient step
+  void setForceGradientLevels(const std::vector<int> &levels) {
+    assert(levels.size() == fg_levels.size());
+    fg_levels = levels;
+  }
+
+  void step(Field& U, int level, int _first, int _last) {
+    RealD eps = this->Params.trajL/this->Params.MDsteps * 2.0;
+    for (int l = 0; l <= level; ++l) eps /= 2.0 * this->as[l].multiplier;
+
+    int fg = fg_levels[level];
+    RealD lambda = fg ? lambda_fg : lambda_mn;
+    RealD Chi = chi * eps * eps * eps;
+
+    int fl = this->as.size() - 1;
+
+    int multiplier = this->as[level].multiplier;
+
+    for (int e = 0; e < multiplier; ++e) {  // steps per step
+
+      int first_step = _first && (e == 0);
+      int last_step = _last && (e == multiplier - 1);
+
+      if (first_step) {  // initial half step
+        this->update_P(U, level, lambda * eps);
+      }
+
+      if (level == fl) {  // lowest level
+        this->update_U(U, 0.5 * eps);
+      } else {  // recursive function call
+        this->step(U, level + 1, first_step, 0);
+      }
+
+      if (fg) {
+	this->FG_update_P(U, level, 2 * Chi / ((1.0 - 2.0 * lambda) * eps), (1.0 - 2.0 * lambda) * eps);
+      } else {
+	this->update_P(U, level, (1.0 - 2.0 * lambda) * eps);
+      }
+
+      if (level == fl) {  // lowest level
+        this->update_U(U, 0.5 * eps);
+      } else {  // recursive function call
+        this->step(U, level + 1, 0, last_step);
+      }
+
+      int mm = (last_step) ? 1 : 2;
+      this->update_P(U, level, lambda * eps * mm);
+    }
+  }
+};
+
+/* 
+ * Fourth order minimum norm integrator with five force evaluations per step
+ * (Omelyan, Mryglod, Folk, Comput. Phys. Commun. 151 (2003) 272; the OMF4 of openQCD)
+ *
+ *  P r1 | U r2 | P r3 | U r4 | P (1/2-r1-r3) | U (1-2(r2+r4)) | P (1/2-r1-r3) | U r4 | P r3 | U r2 | P r1
+ *
+ * The U sub-steps are unequal (r4 is negative), so nested levels are integrated
+ * over an explicit time interval. The trailing P r1 of one step is carried over
+ * and merged with the leading P r1 of the next step on the same level; nothing
+ * changes U between them so the merge is exact even when the intervals differ.
+ */
+template <class FieldImplementation, class SmearingPolicy, class RepresentationPolicy = Representations<FundamentalRepresentation> >
+class MinimumNorm4 : public Integrator<FieldImplementation, SmearingPolicy, RepresentationPolicy> 
+{
+private:
+  const RealD r1 =  0.08398315262876693;
+  const RealD r2 =  0.2539785108410595;
+  const RealD r3 =  0.6822365335719091;
+  const RealD r4 = -0.03230286765269967;
+
+  std::vector<RealD> carry_P;  // deferred trailing momentum step per level
+
+public:
+  INHERIT_FIELD_TYPES(FieldImplementation);
+
+  MinimumNorm4(GridBase* grid, IntegratorParameters Par, ActionSet<Field, RepresentationPolicy>& Aset, SmearingPolicy& Sm)
+    : Integrator<FieldImplementation, SmearingPolicy, RepresentationPolicy>(grid, Par, Aset, Sm)
+  {
+    carry_P.resize(Aset.size(), 0.0);
+  };
+
+  std::string integrator_name(){return "MinimumNorm4";}
+
+  void step(Field& U, int level, int _first, int _last) {
+    RealD eps = this->Params.trajL/this->Params.MDsteps;
+    for (int l = 0; l < level; ++l) eps /= this->as[l].multiplier;
+    step(U, level, eps, _first, _last);
+  }
+
+  void step(Field& U, int level, RealD dt, int _first, int _last) {
+    int fl = this->as.size() - 1;
+
+    int multiplier = this->as[level].multiplier;
+    RealD eps = dt / multiplier;
+
+    for (int e = 0; e < multiplier; ++e) {  // steps per step
+
+      int first_step = _first && (e == 0);
+      int last_step = _last && (e == multiplier - 1);
+
+      if (first_step) carry_P[level] = 0.0;
+      this->update_P(U, level, carry_P[level] + r1 * eps);
+      carry_P[level] = 0.0;
+
+      evolve_U(U, level, r2 * eps, first_step, 0);
+      this->update_P(U, level, r3 * eps);
+      evolve_U(U, level, r4 * eps, 0, 0);
+      this->update_P(U, level, (0.5 - r1 - r3) * eps);
+      evolve_U(U, level, (1.0 - 2.0 * (r2 + r4)) * eps, 0, 0);
+      this->update_P(U, level, (0.5 - r1 - r3) * eps);
+      evolve_U(U, level, r4 * eps, 0, 0);
+      this->update_P(U, level, r3 * eps);
+      evolve_U(U, level, r2 * eps, 0, last_step);
+
+      if (last_step) {
+        this->update_P(U, level, r1 * eps);
+      } else {
+        carry_P[level] = r1 * eps;
+      }
+    }
+  }
+
+private:
+  void evolve_U(Field& U, int level, RealD dt, int first, int last) {
+    if (level == this->as.size() - 1) {  // lowest level
+      this->update_U(U, dt);
+    } else {  // recursive function call
+      this->step(U, level + 1, dt, first, last);
+    }
+  }
+};
+
 NAMESPACE_END(Grid);
 
 #endif  // INTEGRATOR_INCLUDED
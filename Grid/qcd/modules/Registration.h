@@ -124,6 +124,8 @@ static Registrar<ILDGCPModule<ImplementationPolicy>  , HMC_CPModuleFactory<cp_st
 static Registrar< HMCLeapFrog<ImplementationPolicy, RepresentationPolicy, Serialiser>      , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCLFmodXMLInit("LeapFrog");
 static Registrar< HMCMinimumNorm2<ImplementationPolicy, RepresentationPolicy, Serialiser>  , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCMN2modXMLInit("MinimumNorm2");
 static Registrar< HMCForceGradient<ImplementationPolicy, RepresentationPolicy, Serialiser> , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCFGmodXMLInit("ForceGradient");
+static Registrar< HMCOmelyanForceGradient<ImplementationPolicy, RepresentationPolicy, Serialiser> , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCOFGmodXMLInit("OmelyanForceGradient");
+static Registrar< HMCMinimumNorm4<ImplementationPolicy, RepresentationPolicy, Serialiser>  , HMCRunnerModuleFactory<hmc_string, Serialiser> > __HMCMN4modXMLInit("MinimumNorm4");
 
 typedef HMCRunnerModuleFactory<hmc_string, Serialiser > HMCModuleFactory;
 
@@ -0,0 +1,246 @@
+/*************************************************************************************
+
+ Grid physics library, www.github.com/paboyle/Grid
+
+ Source file: ./lib/qcd/utils/A2AMesonFieldIO.h
+
+ Copyright (C) 2015
+
+ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along
+ with this program; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+ See the full license in the file "LICENSE" in the top level distribution directory
+ *************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Streaming meson field output.
+//
+// A2AMesonFieldStream computes a Nl x Nr meson field tile by tile, each tile
+// an Lblock x Rblock block of A2Autils::MesonField stored row major as
+// (mom, gamma, t, i, j), and hands every finished tile to a writer:
+//
+//   writer.write(std::vector<ComplexD> &&tile, int i0, int j0, int ni, int nj);
+//
+// A2AMesonFieldHdf5Writer appends the tiles to one chunked HDF5 dataset of
+// shape (Nmom, Ngamma, Nt, Nl, Nr) from a background thread, so the I/O of a
+// tile overlaps the computation of the next ones. At most MaxPending tiles
+// are queued or being written; write() blocks beyond that, which bounds the
+// memory to MaxPending+1 tiles whatever the number of modes. The file carries
+// the root attribute expected by Hdf5Reader, which can read the dataset back.
+// An HDF5 error in the background thread is rethrown by the next write() or
+// by flush(). The destructor does not throw and only reports an error nobody
+// collected, so call flush() before the writer goes out of scope.
+//
+// The meson field is globally summed, so only world rank 0 opens the file and
+// writes; write() discards the tile on the other ranks. While a writer is
+// alive it is the only user of the HDF5 library on rank 0 (serial HDF5 is
+// not thread safe), so other HDF5 output must wait until it is destroyed.
+////////////////////////////////////////////////////////////////////////////////
+template <typename FImpl, typename TileWriter>
+void A2AMesonFieldStream(TileWriter &writer,
+			 const typename FImpl::FermionField *lhs_wi, int Nl,
+			 const typename FImpl::FermionField *rhs_vj, int Nr,
+			 int Lblock, int Rblock,
+			 const std::vector<Gamma::Algebra> &gammas,
+			 const std::vector<typename FImpl::ComplexField> &mom,
+			 int orthogdim)
+{
+  typedef Eigen::TensorMap<Eigen::Tensor<ComplexD,5,Eigen::RowMajor> > TileMap;
+
+  GridBase *grid = lhs_wi[0].Grid();
+  int Nt     = grid->GlobalDimensions()[orthogdim];
+  int Ngamma = gammas.size();
+  int Nmom   = mom.size();
+
+  for(int i0=0;i0<Nl;i0+=Lblock){
+    for(int j0=0;j0<Nr;j0+=Rblock){
+      int ni = std::min(Lblock,Nl-i0);
+      int nj = std::min(Rblock,Nr-j0);
+      std::vector<ComplexD> tile((size_t)Nmom*Ngamma*Nt*ni*nj);
+      TileMap mat(tile.data(),Nmom,Ngamma,Nt,ni,nj);
+      A2Autils<FImpl>::MesonField(mat,&lhs_wi[i0],&rhs_vj[j0],gammas,mom,orthogdim);
+      writer.write(std::move(tile),i0,j0,ni,nj);
+    }
+  }
+}
+
+#ifdef HAVE_HDF5
+class A2AMesonFieldHdf5Writer
+{
+public:
+  A2AMesonFieldHdf5Writer(const std::string &fileName, const std::string &dataSetName,
+			  int Nmom, int Ngamma, int Nt, int Nl, int Nr,
+			  int Lblock, int Rblock, int MaxPending = 2)
+    : ioRank_(CartesianCommunicator::RankWorld() == 0), maxPending_(MaxPending),
+      done_(false), ioTime_(0.0), bytes_(0.0)
+  {
+    assert(MaxPending >= 1);
+    dim_ = {(hsize_t)Nmom,(hsize_t)Ngamma,(hsize_t)Nt,(hsize_t)Nl,(hsize_t)Nr};
+    if ( !ioRank_ ) return;
+
+    // chunks are aligned on the tiles, (1,1,Nt,Lblock,Rblock), so a tile
+    // covers Nmom*Ngamma whole chunks and no chunk is shared between tiles
+    hsize_t chunk[5] = {1,1,(hsize_t)Nt,(hsize_t)std::min(Lblock,Nl),(hsize_t)std::min(Rblock,Nr)};
+    H5NS::DSetCreatPropList plist;
+    plist.setChunk(5,chunk);
+
+    type_    = Hdf5Type<ComplexD>::type();
+    file_    = H5NS::H5File(fileName,H5F_ACC_TRUNC);
+
+    // same root attribute as Hdf5Writer, required by Hdf5Reader
+    unsigned int    thres   = HDF5_DEF_DATASET_THRES;
+    hsize_t         attrDim = 1;
+    H5NS::Attribute attr    = file_.openGroup("/").createAttribute(HDF5_GRID_GUARD "dataset_threshold",
+								   Hdf5Type<unsigned int>::type(),
+								   H5NS::DataSpace(1,&attrDim));
+    attr.write(Hdf5Type<unsigned int>::type(),&thres);
+
+    dataSet_ = file_.createDataSet(dataSetName,type_,H5NS::DataSpace(5,dim_.data()),plist);
+    thread_  = std::thread([this]{ this->ioLoop(); });
+  }
+
+  // reports, but does not throw, an I/O error that flush() did not surface
+  ~A2AMesonFieldHdf5Writer(void)
+  {
+    if ( !ioRank_ ) return;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+    notEmpty_.notify_one();
+    thread_.join();
+    std::cout << GridLogMessage << "A2AMesonFieldHdf5Writer: " << bytes_/1024./1024. << " MB in "
+	      << ioTime_/1.0e6 << " s of background I/O" << std::endl;
+    if ( error_ ) {
+      try {
+	rethrowError();
+      } catch (H5NS::Exception &e) {
+	std::cout << GridLogError << "A2AMesonFieldHdf5Writer: unreported I/O error: " << e.getDetailMsg() << std::endl;
+      } catch (std::exception &e) {
+	std::cout << GridLogError << "A2AMesonFieldHdf5Writer: unreported I/O error: " << e.what() << std::endl;
+      } catch (...) {
+	std::cout << GridLogError << "A2AMesonFieldHdf5Writer: unreported I/O error" << std::endl;
+      }
+    }
+  }
+
+  void write(std::vector<ComplexD> &&data, int i0, int j0, int ni, int nj)
+  {
+    if ( !ioRank_ ) return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock,[this]{ return queue_.size()+(busy_ ? 1 : 0) < maxPending_; });
+    if ( error_ ) rethrowError();
+    queue_.push_back(Tile{std::move(data),i0,j0,ni,nj});
+    lock.unlock();
+    notEmpty_.notify_one();
+  }
+
+  // wait until every queued tile is on disk; rethrows a background I/O error
+  void flush(void)
+  {
+    if ( !ioRank_ ) return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock,[this]{ return queue_.empty() && !busy_; });
+    if ( error_ ) rethrowError();
+    file_.flush(H5F_SCOPE_LOCAL);
+  }
+
+private:
+  struct Tile {
+    std::vector<ComplexD> data;
+    int i0, j0, ni, nj;
+  };
+
+  void ioLoop(void)
+  {
+    while ( 1 ) {
+      Tile tile;
+      {
+	std::unique_lock<std::mutex> lock(mutex_);
+	notEmpty_.wait(lock,[this]{ return !queue_.empty() || done_; });
+	if ( queue_.empty() ) return;
+	tile  = std::move(queue_.front());
+	queue_.pop_front();
+	busy_ = true;
+      }
+      notFull_.notify_one();
+
+      // after an error the remaining tiles are dropped, so write() never blocks
+      std::exception_ptr error;
+      if ( !failed_ ) {
+	try {
+	  double t0 = usecond();
+	  hsize_t offset[5] = {0,0,0,(hsize_t)tile.i0,(hsize_t)tile.j0};
+	  hsize_t count [5] = {dim_[0],dim_[1],dim_[2],(hsize_t)tile.ni,(hsize_t)tile.nj};
+	  H5NS::DataSpace memSpace(5,count);
+	  H5NS::DataSpace fileSpace = dataSet_.getSpace();
+	  fileSpace.selectHyperslab(H5S_SELECT_SET,count,offset);
+	  dataSet_.write(tile.data.data(),type_,memSpace,fileSpace);
+	  ioTime_ += usecond()-t0;
+	  bytes_  += tile.data.size()*sizeof(ComplexD);
+	} catch (...) {
+	  error   = std::current_exception();
+	  failed_ = true;
+	}
+      }
+
+      {
+	std::unique_lock<std::mutex> lock(mutex_);
+	if ( error ) error_ = error;
+	busy_ = false;
+      }
+      notFull_.notify_all();
+    }
+  }
+
+  // the error is reported once; called with mutex_ held or after the join
+  void rethrowError(void)
+  {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+
+  bool                    ioRank_;
+  size_t                  maxPending_;
+  bool                    done_;
+  bool                    busy_{false};
+  bool                    failed_{false};   // owned by the I/O thread
+  std::exception_ptr      error_;
+  double                  ioTime_;
+  double                  bytes_;
+  std::vector<hsize_t>    dim_;
+  H5NS::DataType          type_;
+  H5NS::H5File            file_;
+  H5NS::DataSet           dataSet_;
+  std::deque<Tile>        queue_;
+  std::mutex              mutex_;
+  std::condition_variable notEmpty_, notFull_;
+  std::thread             thread_;
+};
+#endif
+
+NAMESPACE_END(Grid);
@@ -112,167 +112,209 @@ public:
 			int orthogdim);
 #endif
 private:
+  static void MesonFieldGemmLocal(std::vector<Eigen::MatrixXcd> &C,
+				  const FermionField *lhs_wi, int Lblock,
+				  const FermionField *rhs_vj, int Rblock,
+				  const std::vector<ComplexField > &mom,
+				  const std::vector<RealD> &spin_weight,
+				  int orthogdim);
+
   inline static void OuterProductWWVV(PropagatorField &WWVV,
                                const vobj &lhs,
                                const vobj &rhs,
                                const int Ns, const int ss);
 };
 
-template <class FImpl>
-template <typename TensorType>
-void A2Autils<FImpl>::MesonField(TensorType &mat, 
-				 const FermionField *lhs_wi,
-				 const FermionField *rhs_vj,
-				 std::vector<Gamma::Algebra> gammas,
-				 const std::vector<ComplexField > &mom,
-				 int orthogdim, double *t_kernel, double *t_gsum) 
+////////////////////////////////////////////////////////////////////////////////
+// Meson field engine
+//
+// On each local timeslice the W and V blocks are packed from the SIMD layout
+// into dense matrices, rows (i,s) of conj(w) and columns (j,s') of v, with
+// colour (and, if spin is contracted, spin) along the summed index. The
+// slice product is then a cache blocked complex GEMM
+//
+//   C[lt,m]((i,s),(j,s')) = sum_{x in lt,c} conj(w_i(x)_{s c}) mom_m(x) v_j(x)_{s' c}
+//
+// Work is split over timeslices and over site chunks within a timeslice so
+// that every thread is busy however small the local time extent is; the
+// partial products of the chunks are summed afterwards. Gamma and g5
+// insertions act on the spin indices of C after the GEMM.
+//
+// spin_weight empty: spin resolved, C is (Lblock*Ns) x (Rblock*Ns)
+// otherwise:         sum_s spin_weight[s] conj(w_s) v_s, C is Lblock x Rblock
+////////////////////////////////////////////////////////////////////////////////
+template<class FImpl>
+void A2Autils<FImpl>::MesonFieldGemmLocal(std::vector<Eigen::MatrixXcd> &C,
+					  const FermionField *lhs_wi, int Lblock,
+					  const FermionField *rhs_vj, int Rblock,
+					  const std::vector<ComplexField > &mom,
+					  const std::vector<RealD> &spin_weight,
+					  int orthogdim)
 {
-  typedef typename FImpl::SiteSpinor vobj;
-
-  typedef typename vobj::scalar_object sobj;
-  typedef typename vobj::scalar_type scalar_type;
-  typedef typename vobj::vector_type vector_type;
-
-  typedef iSpinMatrix<vector_type> SpinMatrix_v;
-  typedef iSpinMatrix<scalar_type> SpinMatrix_s;
-  
-  int Lblock = mat.dimension(3); 
-  int Rblock = mat.dimension(4);
-
   GridBase *grid = lhs_wi[0].Grid();
-  
-  const int    Nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
-
-  int Nt     = grid->GlobalDimensions()[orthogdim];
-  int Ngamma = gammas.size();
-  int Nmom   = mom.size();
-
-  int fd=grid->_fdimensions[orthogdim];
-  int ld=grid->_ldimensions[orthogdim];
-  int rd=grid->_rdimensions[orthogdim];
 
-  // will locally sum vectors first
-  // sum across these down to scalars
-  // splitting the SIMD
-  int MFrvol = rd*Lblock*Rblock*Nmom;
-  int MFlvol = ld*Lblock*Rblock*Nmom;
+  const int    nd = grid->_ndimension;
+  const int    ld = grid->_ldimensions[orthogdim];
+  const int lsites = grid->lSites();
+  const int    Vs = lsites/ld;         // local sites per timeslice
+  const int  Nmom = std::max((int)mom.size(),1);
+
+  const int    ns = spin_weight.empty() ? Ns : 1;      // spin rows/columns per vector
+  const int    nk = spin_weight.empty() ? Nc : Ns*Nc;  // summed components per site
+  const int  Nrow = Lblock*ns;
+  const int  Ncol = Rblock*ns;
+  const int    Nx = 64;                                // sites per packed panel
+
+  // (outer site, lane) of the sites of each local timeslice
+  std::vector<int> osite(lsites), lane(lsites), count(ld,0);
+  Coordinate lcoor(nd);
+  for(int idx=0;idx<lsites;idx++){
+    grid->LocalIndexToLocalCoor(idx,lcoor);
+    int lt = lcoor[orthogdim];
+    int x  = lt*Vs + count[lt]++;
+    osite[x] = grid->oIndex(lcoor);
+    lane[x]  = grid->iIndex(lcoor);
+  }
 
-  Vector<SpinMatrix_v > lvSum(MFrvol);
-  thread_for( r, MFrvol,{
-    lvSum[r] = Zero();
-  });
+  int nchunk = (GridThread::GetThreads()+ld-1)/ld;
+  nchunk = std::max(std::min(nchunk,(Vs+Nx-1)/Nx),1);
+  const int chunk = (Vs+nchunk-1)/nchunk;
 
-  Vector<SpinMatrix_s > lsSum(MFlvol);             
-  thread_for(r,MFlvol,{
-    lsSum[r]=scalar_type(0.0);
-  });
+  std::vector<Eigen::MatrixXcd> Cpart(ld*nchunk*Nmom);
+  thread_for(item,ld*nchunk,{
 
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
+    int lt = item/nchunk;
+    int ck = item%nchunk;
+    int x0 = lt*Vs + std::min(Vs,ck*chunk);
+    int x1 = lt*Vs + std::min(Vs,(ck+1)*chunk);
 
-  // potentially wasting cores here if local time extent too small
-  if (t_kernel) *t_kernel = -usecond();
-  thread_for(r,rd,{
+    Eigen::MatrixXcd A(Nrow,Nx*nk);
+    Eigen::MatrixXcd B(Nx*nk,Ncol);
+    Eigen::MatrixXcd Bm(Nx*nk,Ncol);
+    Eigen::VectorXcd phase(Nx*nk);
 
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
+    for(int m=0;m<Nmom;m++) Cpart[item*Nmom+m] = Eigen::MatrixXcd::Zero(Nrow,Ncol);
 
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
+    for(int xb=x0;xb<x1;xb+=Nx){
 
-	int ss= so+n*stride+b;
+      int nx = std::min(Nx,x1-xb);
+      int K  = nx*nk;
 
-	for(int i=0;i<Lblock;i++){
+      for(int i=0;i<Lblock;i++){
+	autoView(w_v,lhs_wi[i],CpuRead);
+	for(int x=0;x<nx;x++){
+	  sobj w = extractLane(lane[xb+x],w_v[osite[xb+x]]);
+	  for(int s=0;s<Ns;s++){
+	  for(int c=0;c<Nc;c++){
+	    std::complex<double> z(real(w()(s)(c)),-imag(w()(s)(c)));
+	    if ( ns==1 ) A(i,(x*Ns+s)*Nc+c) = spin_weight[s]*z;
+	    else         A(i*Ns+s,x*Nc+c)   = z;
+	  }}
+	}
+      }
+      for(int j=0;j<Rblock;j++){
+	autoView(v_v,rhs_vj[j],CpuRead);
+	for(int x=0;x<nx;x++){
+	  sobj v = extractLane(lane[xb+x],v_v[osite[xb+x]]);
+	  for(int s=0;s<Ns;s++){
+	  for(int c=0;c<Nc;c++){
+	    std::complex<double> z(real(v()(s)(c)),imag(v()(s)(c)));
+	    if ( ns==1 ) B((x*Ns+s)*Nc+c,j) = z;
+	    else         B(x*Nc+c,j*Ns+s)   = z;
+	  }}
+	}
+      }
 
-	  // Recreate view potentially expensive outside fo UVM mode
-	  autoView(lhs_v,lhs_wi[i],CpuRead);
-	  auto left = conjugate(lhs_v[ss]);
-	  for(int j=0;j<Rblock;j++){
-
-	    SpinMatrix_v vv;
-	    // Recreate view potentially expensive outside fo UVM mode
-	    autoView(rhs_v,rhs_vj[j],CpuRead);
-	    auto right = rhs_v[ss];
-	    for(int s1=0;s1<Ns;s1++){
-	    for(int s2=0;s2<Ns;s2++){
-	      vv()(s1,s2)() = left()(s2)(0) * right()(s1)(0)
-		+             left()(s2)(1) * right()(s1)(1)
-		+             left()(s2)(2) * right()(s1)(2);
-	    }}
-	    
-	    // After getting the sitewise product do the mom phase loop
-	    int base = Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*r;
-	    for ( int m=0;m<Nmom;m++){
-	      int idx = m+base;
-	      autoView(mom_v,mom[m],CpuRead);
-	      auto phase = mom_v[ss];
-	      mac(&lvSum[idx],&vv,&phase);
-	    }
+      if ( mom.empty() ) {
+	Cpart[item*Nmom].noalias() += A.leftCols(K) * B.topRows(K);
+      } else {
+	for(int m=0;m<Nmom;m++){
+	  autoView(mom_v,mom[m],CpuRead);
+	  for(int x=0;x<nx;x++){
+	    auto p = extractLane(lane[xb+x],mom_v[osite[xb+x]]);
+	    phase.segment(x*nk,nk).setConstant(std::complex<double>(real(p()()()),imag(p()()())));
 	  }
+	  Bm.topRows(K).noalias() = phase.head(K).asDiagonal() * B.topRows(K);
+	  Cpart[item*Nmom+m].noalias() += A.leftCols(K) * Bm.topRows(K);
 	}
       }
     }
   });
 
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  thread_for(rt,rd,{
-
-    Coordinate icoor(Nd);
-    ExtractBuffer<SpinMatrix_s> extracted(Nsimd);               
-
-    for(int i=0;i<Lblock;i++){
-    for(int j=0;j<Rblock;j++){
-    for(int m=0;m<Nmom;m++){
-
-      int ij_rdx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*rt;
-
-      extract(lvSum[ij_rdx],extracted);
-
-      for(int idx=0;idx<Nsimd;idx++){
-
-	grid->iCoorFromIindex(icoor,idx);
+  C.resize(ld*Nmom);
+  thread_for(tm,ld*Nmom,{
+    int lt = tm/Nmom;
+    int m  = tm%Nmom;
+    C[tm].swap(Cpart[(lt*nchunk)*Nmom+m]);
+    for(int ck=1;ck<nchunk;ck++){
+      C[tm] += Cpart[(lt*nchunk+ck)*Nmom+m];
+    }
+  });
+}
 
-	int ldx    = rt+icoor[orthogdim]*rd;
+template <class FImpl>
+template <typename TensorType>
+void A2Autils<FImpl>::MesonField(TensorType &mat, 
+				 const FermionField *lhs_wi,
+				 const FermionField *rhs_vj,
+				 std::vector<Gamma::Algebra> gammas,
+				 const std::vector<ComplexField > &mom,
+				 int orthogdim, double *t_kernel, double *t_gsum) 
+{
+  int Lblock = mat.dimension(3); 
+  int Rblock = mat.dimension(4);
 
-	int ij_ldx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*ldx;
+  GridBase *grid = lhs_wi[0].Grid();
+  
+  int Nt     = grid->GlobalDimensions()[orthogdim];
+  int Ngamma = gammas.size();
+  int Nmom   = mom.size();
 
-	lsSum[ij_ldx]=lsSum[ij_ldx]+extracted[idx];
+  int fd=grid->_fdimensions[orthogdim];
+  int ld=grid->_ldimensions[orthogdim];
 
-      }
-    }}}
-  });
-  if (t_kernel) *t_kernel += usecond();
   assert(mat.dimension(0) == Nmom);
   assert(mat.dimension(1) == Ngamma);
   assert(mat.dimension(2) == Nt);
 
-  // ld loop and local only??
-  int pd = grid->_processors[orthogdim];
+  if (t_kernel) *t_kernel = -usecond();
+  std::vector<Eigen::MatrixXcd> C;
+  MesonFieldGemmLocal(C,lhs_wi,Lblock,rhs_vj,Rblock,mom,std::vector<RealD>(),orthogdim);
+  if (t_kernel) *t_kernel += usecond();
+
+  // Gamma insertion: trace over spin of C(i,j) with the gamma matrix
+  std::vector<SpinMatrix_s> G(Ngamma);
+  SpinMatrix_s unit;
+  unit = scalar_type(1.0);
+  for(int mu=0;mu<Ngamma;mu++){
+    G[mu] = Gamma(gammas[mu])*unit;
+  }
+
   int pc = grid->_processor_coor[orthogdim];
-  thread_for_collapse(2,lt,ld,{
-    for(int pt=0;pt<pd;pt++){
-      int t = lt + pt*ld;
-      if (pt == pc){
-	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    for(int m=0;m<Nmom;m++){
-	      int ij_dx = m+Nmom*i + Nmom*Lblock * j + Nmom*Lblock * Rblock * lt;
-	      for(int mu=0;mu<Ngamma;mu++){
-		// this is a bit slow
-		mat(m,mu,t,i,j) = trace(lsSum[ij_dx]*Gamma(gammas[mu]))()()();
-	      }
+  thread_for_collapse(2,t,fd,{
+    for(int j=0;j<Rblock;j++){
+      int lt = (int)t - pc*ld;
+      if ( (lt>=0) && (lt<ld) ) {
+	for(int m=0;m<Nmom;m++){
+	  const Eigen::MatrixXcd &Ctm = C[lt*Nmom+m];
+	  for(int i=0;i<Lblock;i++){
+	    for(int mu=0;mu<Ngamma;mu++){
+	      std::complex<double> z(0.0);
+	      for(int s1=0;s1<Ns;s1++){
+	      for(int s2=0;s2<Ns;s2++){
+		scalar_type g = G[mu]()(s1,s2)();
+		z += Ctm(i*Ns+s1,j*Ns+s2)*std::complex<double>(real(g),imag(g));
+	      }}
+	      mat(m,mu,t,i,j) = ComplexD(z.real(),z.imag());
 	    }
 	  }
 	}
       } else { 
-	const scalar_type zz(0.0);
+	const ComplexD zz(0.0);
 	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    for(int mu=0;mu<Ngamma;mu++){
-	      for(int m=0;m<Nmom;m++){
-		mat(m,mu,t,i,j) =zz;
-	      }
+	  for(int mu=0;mu<Ngamma;mu++){
+	    for(int m=0;m<Nmom;m++){
+	      mat(m,mu,t,i,j) =zz;
 	    }
 	  }
 	}
@@ -331,133 +373,30 @@ void A2Autils<FImpl>::PionFieldXX(Eigen::Tensor<ComplexD,3> &mat,
 
   GridBase *grid = wi[0].Grid();
   
-  const int    nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
-
   int Nt     = grid->GlobalDimensions()[orthogdim];
 
   int fd=grid->_fdimensions[orthogdim];
   int ld=grid->_ldimensions[orthogdim];
-  int rd=grid->_rdimensions[orthogdim];
-
-  // will locally sum vectors first
-  // sum across these down to scalars
-  // splitting the SIMD
-  int MFrvol = rd*Lblock*Rblock;
-  int MFlvol = ld*Lblock*Rblock;
 
-  Vector<vector_type > lvSum(MFrvol);
-  thread_for(r,MFrvol,{
-    lvSum[r] = Zero();
-  });
-
-  Vector<scalar_type > lsSum(MFlvol);             
-  thread_for(r,MFlvol,{
-    lsSum[r]=scalar_type(0.0);
-  });
-
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
-
-  thread_for(r,rd,{
-
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-
-	int ss= so+n*stride+b;
-
-	for(int i=0;i<Lblock;i++){
-
-	  autoView(wi_v,wi[i],CpuRead);
-	  auto w = conjugate(wi_v[ss]);
-	  if (g5) {
-	    w()(2)(0) = - w()(2)(0);
-	    w()(2)(1) = - w()(2)(1);
-	    w()(2)(2) = - w()(2)(2);
-	    w()(3)(0) = - w()(3)(0);
-	    w()(3)(1) = - w()(3)(1);
-	    w()(3)(2) = - w()(3)(2);
-	  }
-	  for(int j=0;j<Rblock;j++){
-	    
-	    autoView(vj_v,vj[j],CpuRead);
-	    auto v  = vj_v[ss];
-	    auto vv = v()(0)(0);
-
-	    vv =      w()(0)(0) * v()(0)(0)// Gamma5 Dirac basis explicitly written out
-	      +       w()(0)(1) * v()(0)(1)
-	      +       w()(0)(2) * v()(0)(2)
-	      +       w()(1)(0) * v()(1)(0)
-	      +       w()(1)(1) * v()(1)(1)
-	      +       w()(1)(2) * v()(1)(2)
-	      +       w()(2)(0) * v()(2)(0)
-	      +       w()(2)(1) * v()(2)(1)
-	      +       w()(2)(2) * v()(2)(2)
-	      +       w()(3)(0) * v()(3)(0)
-	      +       w()(3)(1) * v()(3)(1)
-	      +       w()(3)(2) * v()(3)(2);
-	    
-	    int idx = i+Lblock*j+Lblock*Rblock*r;
-	    lvSum[idx] = lvSum[idx]+vv;
-	  }
-	}
-      }
-    }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  thread_for(rt,rd,{
-
-      Coordinate icoor(nd);
-    iScalar<vector_type> temp; 
-    ExtractBuffer<iScalar<scalar_type> > extracted(Nsimd);               
-
-    for(int i=0;i<Lblock;i++){
-    for(int j=0;j<Rblock;j++){
-
-      int ij_rdx = i+Lblock*j+Lblock*Rblock*rt;
-
-      temp._internal =lvSum[ij_rdx];
-      extract(temp,extracted);
-
-      for(int idx=0;idx<Nsimd;idx++){
-
-	grid->iCoorFromIindex(icoor,idx);
-
-	int ldx    = rt+icoor[orthogdim]*rd;
-
-	int ij_ldx =i+Lblock*j+Lblock*Rblock*ldx;
-
-	lsSum[ij_ldx]=lsSum[ij_ldx]+extracted[idx]._internal;
+  assert(mat.dimension(0) == Nt);
 
-      }
-    }}
-  });
+  // Gamma5 Dirac basis explicitly written out
+  std::vector<RealD> spin_weight({1.0,1.0,1.0,1.0});
+  if (g5) {
+    spin_weight[2] = -1.0;
+    spin_weight[3] = -1.0;
+  }
+  std::vector<ComplexField> nomom;
+  std::vector<Eigen::MatrixXcd> C;
+  MesonFieldGemmLocal(C,wi,Lblock,vj,Rblock,nomom,spin_weight,orthogdim);
 
-  assert(mat.dimension(0) == Nt);
-  // ld loop and local only??
-  int pd = grid->_processors[orthogdim];
   int pc = grid->_processor_coor[orthogdim];
-  thread_for_collapse(2,lt,ld,{
-    for(int pt=0;pt<pd;pt++){
-      int t = lt + pt*ld;
-      if (pt == pc){
-	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    int ij_dx = i + Lblock * j + Lblock * Rblock * lt;
-	    mat(t,i,j) = lsSum[ij_dx];
-	  }
-	}
-      } else { 
-	const scalar_type zz(0.0);
-	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    mat(t,i,j) =zz;
-	  }
-	}
+  thread_for_collapse(2,t,fd,{
+    for(int j=0;j<Rblock;j++){
+      int lt = (int)t - pc*ld;
+      for(int i=0;i<Lblock;i++){
+	if ( (lt>=0) && (lt<ld) ) mat(t,i,j) = ComplexD(C[lt](i,j).real(),C[lt](i,j).imag());
+	else                      mat(t,i,j) = ComplexD(0.0);
       }
     }
   });
@@ -477,139 +416,28 @@ void A2Autils<FImpl>::PionFieldWVmom(Eigen::Tensor<ComplexD,4> &mat,
 
   GridBase *grid = wi[0].Grid();
   
-  const int    nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
-
   int Nt     = grid->GlobalDimensions()[orthogdim];
   int Nmom   = mom.size();
 
   int fd=grid->_fdimensions[orthogdim];
   int ld=grid->_ldimensions[orthogdim];
-  int rd=grid->_rdimensions[orthogdim];
-
-  // will locally sum vectors first
-  // sum across these down to scalars
-  // splitting the SIMD
-  int MFrvol = rd*Lblock*Rblock*Nmom;
-  int MFlvol = ld*Lblock*Rblock*Nmom;
-
-  Vector<vector_type > lvSum(MFrvol);
-  thread_for(r,MFrvol,{
-    lvSum[r] = Zero();
-  });
-
-  Vector<scalar_type > lsSum(MFlvol);             
-  thread_for(r,MFlvol,{
-    lsSum[r]=scalar_type(0.0);
-  });
-
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
-
-  thread_for(r,rd,{
-
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-
-	int ss= so+n*stride+b;
-
-	for(int i=0;i<Lblock;i++){
-
-	  autoView(wi_v,wi[i],CpuRead);
-	  auto w = conjugate(wi_v[ss]);
-
-	  for(int j=0;j<Rblock;j++){
-
-	    autoView(vj_v,vj[j],CpuRead);
-	    auto v = vj_v[ss];
-
-	    auto vv = w()(0)(0) * v()(0)(0)// Gamma5 Dirac basis explicitly written out
-	      +       w()(0)(1) * v()(0)(1)
-	      +       w()(0)(2) * v()(0)(2)
-	      +       w()(1)(0) * v()(1)(0)
-	      +       w()(1)(1) * v()(1)(1)
-	      +       w()(1)(2) * v()(1)(2)
-	      -       w()(2)(0) * v()(2)(0)
-	      -       w()(2)(1) * v()(2)(1)
-	      -       w()(2)(2) * v()(2)(2)
-	      -       w()(3)(0) * v()(3)(0)
-	      -       w()(3)(1) * v()(3)(1)
-	      -       w()(3)(2) * v()(3)(2);
-
-	    
-	    // After getting the sitewise product do the mom phase loop
-	    int base = Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*r;
-	    for ( int m=0;m<Nmom;m++){
-	      int idx = m+base;
-	      autoView(mom_v,mom[m],CpuRead);
-	      auto phase = mom_v[ss];
-	      mac(&lvSum[idx],&vv,&phase()()());
-	    }
-	  }
-	}
-      }
-    }
-  });
-
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  thread_for(rt,rd,{
-
-    Coordinate icoor(nd);
-    iScalar<vector_type> temp; 
-    ExtractBuffer<iScalar<scalar_type> > extracted(Nsimd);               
-
-    for(int i=0;i<Lblock;i++){
-    for(int j=0;j<Rblock;j++){
-    for(int m=0;m<Nmom;m++){
-
-      int ij_rdx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*rt;
-
-      temp._internal = lvSum[ij_rdx];
-      extract(temp,extracted);
-
-      for(int idx=0;idx<Nsimd;idx++){
-
-	grid->iCoorFromIindex(icoor,idx);
-
-	int ldx    = rt+icoor[orthogdim]*rd;
-
-	int ij_ldx = m+Nmom*i+Nmom*Lblock*j+Nmom*Lblock*Rblock*ldx;
-
-	lsSum[ij_ldx]=lsSum[ij_ldx]+extracted[idx]._internal;
-
-      }
-    }}}
-  });
 
   assert(mat.dimension(0) == Nmom);
   assert(mat.dimension(1) == Nt);
- 
-  int pd = grid->_processors[orthogdim];
+
+  // Gamma5 Dirac basis explicitly written out
+  std::vector<RealD> spin_weight({1.0,1.0,-1.0,-1.0});
+  std::vector<Eigen::MatrixXcd> C;
+  MesonFieldGemmLocal(C,wi,Lblock,vj,Rblock,mom,spin_weight,orthogdim);
+
   int pc = grid->_processor_coor[orthogdim];
-  thread_for_collapse(2,lt,ld,{
-    for(int pt=0;pt<pd;pt++){
-      int t = lt + pt*ld;
-      if (pt == pc){
-	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    for(int m=0;m<Nmom;m++){
-	      int ij_dx = m+Nmom*i + Nmom*Lblock * j + Nmom*Lblock * Rblock * lt;
-	      mat(m,t,i,j) = lsSum[ij_dx];
-	    }
-	  }
-	}
-      } else { 
-	const scalar_type zz(0.0);
-	for(int i=0;i<Lblock;i++){
-	  for(int j=0;j<Rblock;j++){
-	    for(int m=0;m<Nmom;m++){
-	      mat(m,t,i,j) =zz;
-	    }
-	  }
+  thread_for_collapse(2,t,fd,{
+    for(int j=0;j<Rblock;j++){
+      int lt = (int)t - pc*ld;
+      for(int i=0;i<Lblock;i++){
+	for(int m=0;m<Nmom;m++){
+	  if ( (lt>=0) && (lt<ld) ) mat(m,t,i,j) = ComplexD(C[lt*Nmom+m](i,j).real(),C[lt*Nmom+m](i,j).imag());
+	  else                      mat(m,t,i,j) = ComplexD(0.0);
 	}
       }
     }
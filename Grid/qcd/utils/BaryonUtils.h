@@ -109,7 +109,41 @@ public:
          const int wick_contractions,
          const int nt,
          robj &result);
+
+  // One baryon two point function of a batch for ContractBaryonsBatched
+  struct BaryonContraction {
+    Gamma GammaA_left;
+    Gamma GammaB_left;
+    Gamma GammaA_right;
+    Gamma GammaB_right;
+    int wick_contractions;
+    int parity;
+  };
+  // A non-zero product epsilon_{a_f b_f c_f} epsilon_{a_i b_i c_i}
+  struct BaryonEpsilonPair {
+    int a_f, b_f, c_f;
+    int a_i, b_i, c_i;
+    Real sign;
+  };
+  static void ContractBaryonsBatched(const PropagatorField &q1_left,
+         const PropagatorField &q2_left,
+         const PropagatorField &q3_left,
+         const std::vector<BaryonContraction> &contractions,
+         std::vector<std::vector<ComplexD> > &baryon_corr,
+         int orthogdim);
   private:
+  template <class mobj, class robj> accelerator_inline
+  static void BaryonSiteTerms(const mobj &D1,
+           const mobj &D2,
+           const mobj &D3,
+           const Gamma GammaA_i,
+           const Gamma GammaB_i,
+           const Gamma GammaA_f,
+           const Gamma GammaB_f,
+           const int parity,
+           const int terms,
+           const BaryonEpsilonPair *eps,
+           robj *term);
   template <class mobj, class mobj2, class robj> accelerator_inline
   static void BaryonGamma3ptGroup1Site(
            const mobj &Dq1_ti,
@@ -373,6 +407,122 @@ void BaryonUtils<FImpl>::BaryonSite(const mobj &D1,
   }
 }
 
+//BaryonSite for several Wick terms at once: term[ie] receives the term of
+//bit ie of 'terms'. The gamma-propagator products are formed once for all of
+//them, and the colour sums run over the 36 non-zero epsilon pairs in eps.
+template <class FImpl>
+template <class mobj, class robj> accelerator_inline
+void BaryonUtils<FImpl>::BaryonSiteTerms(const mobj &D1,
+                const mobj &D2,
+                const mobj &D3,
+                const Gamma GammaA_i,
+                const Gamma GammaB_i,
+                const Gamma GammaA_f,
+                const Gamma GammaB_f,
+                const int parity,
+                const int terms,
+                const BaryonEpsilonPair *eps,
+                robj *term)
+{
+
+  Gamma g4(Gamma::Algebra::GammaT); //needed for parity P_\pm = 0.5*(1 \pm \gamma_4)
+    
+  auto D1_GAi =  D1 * GammaA_i;
+  auto D1_GAi_g4 = D1_GAi * g4;
+  auto D1_GAi_P = 0.5*(D1_GAi + (Real)parity * D1_GAi_g4);
+  auto GAf_D1_GAi_P = GammaA_f * D1_GAi_P;
+  auto GBf_D1_GAi_P = GammaB_f * D1_GAi_P;
+
+  auto D2_GBi = D2 * GammaB_i;
+  auto GBf_D2_GBi = GammaB_f * D2_GBi;
+  auto GAf_D2_GBi = GammaA_f * D2_GBi;
+
+  auto GBf_D3 = GammaB_f * D3;
+  auto GAf_D3 = GammaA_f * D3;
+
+  for (int ie=0; ie < 36 ; ie++){
+    const int a_f = eps[ie].a_f;
+    const int b_f = eps[ie].b_f;
+    const int c_f = eps[ie].c_f;
+    const int a_i = eps[ie].a_i;
+    const int b_i = eps[ie].b_i;
+    const int c_i = eps[ie].c_i;
+    const Real ee = eps[ie].sign;
+    //This is the \delta_{456}^{123} part
+    if (terms & 1){
+      for (int rho=0; rho<Ns; rho++){
+        auto GAf_D1_GAi_P_rr_cc = GAf_D1_GAi_P()(rho,rho)(c_f,c_i);
+        for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[0]()()() += ee  * GAf_D1_GAi_P_rr_cc
+                                       * D2_GBi    ()(alpha_f,beta_i)(a_f,a_i)
+                                       * GBf_D3    ()(alpha_f,beta_i)(b_f,b_i);
+        }}
+      }
+    }
+    //This is the \delta_{456}^{231} part
+    if (terms & 2){
+      for (int rho=0; rho<Ns; rho++){
+      for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        auto D1_GAi_P_ar_ac = D1_GAi_P()(alpha_f,rho)(a_f,c_i);
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[1]()()() += ee  * D1_GAi_P_ar_ac
+                                       * GBf_D2_GBi    ()(alpha_f,beta_i)(b_f,a_i)
+                                       * GAf_D3        ()(rho,beta_i)(c_f,b_i);
+        }
+      }}
+    }
+    //This is the \delta_{456}^{312} part
+    if (terms & 4){
+      for (int rho=0; rho<Ns; rho++){
+      for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        auto GBf_D1_GAi_P_ar_bc = GBf_D1_GAi_P()(alpha_f,rho)(b_f,c_i);
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[2]()()() += ee  * GBf_D1_GAi_P_ar_bc
+                                       * GAf_D2_GBi    ()(rho,beta_i)(c_f,a_i)
+                                       * D3            ()(alpha_f,beta_i)(a_f,b_i);
+        }
+      }}
+    }
+    //This is the \delta_{456}^{132} part
+    if (terms & 8){
+      for (int rho=0; rho<Ns; rho++){
+        auto GAf_D1_GAi_P_rr_cc = GAf_D1_GAi_P()(rho,rho)(c_f,c_i);
+        for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[3]()()() -= ee  * GAf_D1_GAi_P_rr_cc
+                                       * GBf_D2_GBi    ()(alpha_f,beta_i)(b_f,a_i)
+                                       * D3            ()(alpha_f,beta_i)(a_f,b_i);
+        }}
+      }
+    }
+    //This is the \delta_{456}^{321} part
+    if (terms & 16){
+      for (int rho=0; rho<Ns; rho++){
+      for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        auto GBf_D1_GAi_P_ar_bc = GBf_D1_GAi_P()(alpha_f,rho)(b_f,c_i);
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[4]()()() -= ee  * GBf_D1_GAi_P_ar_bc
+                                       * D2_GBi    ()(alpha_f,beta_i)(a_f,a_i)
+                                       * GAf_D3    ()(rho,beta_i)(c_f,b_i);
+        }
+      }}
+    }
+    //This is the \delta_{456}^{213} part
+    if (terms & 32){
+      for (int rho=0; rho<Ns; rho++){
+      for (int alpha_f=0; alpha_f<Ns; alpha_f++){
+        auto D1_GAi_P_ar_ac = D1_GAi_P()(alpha_f,rho)(a_f,c_i);
+        for (int beta_i=0; beta_i<Ns; beta_i++){
+          term[5]()()() -= ee  * D1_GAi_P_ar_ac
+                                       * GAf_D2_GBi    ()(rho,beta_i)(c_f,a_i)
+                                       * GBf_D3        ()(alpha_f,beta_i)(b_f,b_i);
+        }
+      }}
+    }
+  }
+}
+
 //New version without parity projection or trace
 template <class FImpl>
 template <class mobj, class robj> accelerator_inline
@@ -660,6 +810,164 @@ void BaryonUtils<FImpl>::ContractBaryonsSlicedMatrix(const mobj &D1,
   }
 }
 
+/* Batched version of ContractBaryons followed by sliceSum.          *
+ * The propagators are read once per site for all contractions.       *
+ * Contractions with the same gammas and parity form a group whose    *
+ * six Wick terms are each computed once and then added up for every  *
+ * flavour pattern that needs them. All the correlators are reduced   *
+ * over timeslices together, with a single global sum.                *
+ * baryon_corr[n][t] is the correlator of contractions[n].            */
+template<class FImpl>
+void BaryonUtils<FImpl>::ContractBaryonsBatched(const PropagatorField &q1_left,
+             const PropagatorField &q2_left,
+             const PropagatorField &q3_left,
+             const std::vector<BaryonContraction> &contractions,
+             std::vector<std::vector<ComplexD> > &baryon_corr,
+             int orthogdim)
+{
+  typedef typename ComplexField::vector_object vobj;
+  typedef typename vobj::scalar_object sobj;
+
+  assert(Ns==4 && "Baryon code only implemented for N_spin = 4");
+  assert(Nc==3 && "Baryon code only implemented for N_colour = 3");
+
+  GridBase *grid = q1_left.Grid();
+  const int Ncontr = contractions.size();
+  const int osites = grid->oSites();
+
+  baryon_corr.resize(Ncontr);
+  if ( Ncontr == 0 ) return;
+
+  //////////////////////////////////////////////
+  // Group by gamma structure and parity
+  //////////////////////////////////////////////
+  struct BaryonGroup {
+    Gamma GammaA_left;
+    Gamma GammaB_left;
+    Gamma GammaA_right;
+    Gamma GammaB_right;
+    int parity;
+    int terms; // union of the Wick patterns of the members
+  };
+  Vector<BaryonGroup> groups;
+  Vector<int> group(Ncontr);
+  Vector<int> wick(Ncontr);
+  for (int n=0; n<Ncontr; n++) {
+    const BaryonContraction &c = contractions[n];
+    assert(c.parity==1 || c.parity == -1 && "Parity must be +1 or -1");
+    int g=0;
+    for (; g<groups.size(); g++) {
+      if ( groups[g].GammaA_left.g  == c.GammaA_left.g  && groups[g].GammaB_left.g  == c.GammaB_left.g  &&
+           groups[g].GammaA_right.g == c.GammaA_right.g && groups[g].GammaB_right.g == c.GammaB_right.g &&
+           groups[g].parity == c.parity ) break;
+    }
+    if ( g == groups.size() ) {
+      groups.push_back({c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,c.parity,0});
+    }
+    groups[g].terms |= c.wick_contractions;
+    group[n] = g;
+    wick[n]  = c.wick_contractions;
+  }
+  const int Ngroup = groups.size();
+
+  //////////////////////////////////////////////
+  // The 36 non-zero epsilon pairs out of the
+  // 27x27 colour index combinations
+  //////////////////////////////////////////////
+  const int epsilon[6][3] = {{0,1,2},{1,2,0},{2,0,1},{0,2,1},{2,1,0},{1,0,2}};
+  const int epsilon_sgn[6] = {1,1,1,-1,-1,-1};
+  Vector<BaryonEpsilonPair> eps(36);
+  for (int ie_f=0; ie_f<6; ie_f++) {
+    for (int ie_i=0; ie_i<6; ie_i++) {
+      eps[ie_f*6+ie_i] = { epsilon[ie_f][0], epsilon[ie_f][1], epsilon[ie_f][2],
+                           epsilon[ie_i][0], epsilon[ie_i][1], epsilon[ie_i][2],
+                           Real(epsilon_sgn[ie_f]*epsilon_sgn[ie_i]) };
+    }
+  }
+
+  //////////////////////////////////////////////
+  // One sweep over the propagators
+  //////////////////////////////////////////////
+  Vector<vobj> corr((size_t)Ncontr*osites);
+  {
+    autoView( v1 , q1_left , AcceleratorRead);
+    autoView( v2 , q2_left , AcceleratorRead);
+    autoView( v3 , q3_left , AcceleratorRead);
+    vobj        *corr_p  = &corr[0];
+    BaryonGroup *group_p = &groups[0];
+    int         *gidx_p  = &group[0];
+    int         *wick_p  = &wick[0];
+    BaryonEpsilonPair *eps_p = &eps[0];
+
+    accelerator_for(ss, osites, grid->Nsimd(), {
+      auto D1 = v1(ss);
+      auto D2 = v2(ss);
+      auto D3 = v3(ss);
+      typedef decltype(coalescedRead(corr_p[0])) cVec;
+      for (int g=0; g<Ngroup; g++) {
+        const BaryonGroup &G = group_p[g];
+        cVec term[6];
+        for (int ie=0; ie<6; ie++) term[ie] = Zero();
+        BaryonSiteTerms(D1,D2,D3,G.GammaA_left,G.GammaB_left,G.GammaA_right,G.GammaB_right,G.parity,G.terms,eps_p,term);
+        for (int n=0; n<Ncontr; n++) {
+          if ( gidx_p[n] != g ) continue;
+          cVec result = Zero();
+          for (int ie=0; ie<6; ie++) {
+            if ( wick_p[n] & (1<<ie) ) result = result + term[ie];
+          }
+          coalescedWrite(corr_p[(size_t)n*osites+ss],result);
+        }
+      }
+    });
+  }
+
+  //////////////////////////////////////////////
+  // Slice sums of all correlators, one global sum
+  //////////////////////////////////////////////
+  const int    Nd = grid->_ndimension;
+  const int Nsimd = grid->Nsimd();
+  int fd=grid->_fdimensions[orthogdim];
+  int ld=grid->_ldimensions[orthogdim];
+  int rd=grid->_rdimensions[orthogdim];
+  int e1=    grid->_slice_nblock[orthogdim];
+  int e2=    grid->_slice_block [orthogdim];
+  int stride=grid->_slice_stride[orthogdim];
+
+  Vector<vobj> lvSum((size_t)Ncontr*rd);
+  thread_for(nr, Ncontr*rd, {
+    int n = nr/rd;
+    int r = nr%rd;
+    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
+    vobj sum = Zero();
+    for(int e=0;e<e1;e++){
+      for(int b=0;b<e2;b++){
+        sum = sum + corr[(size_t)n*osites+so+e*stride+b];
+      }
+    }
+    lvSum[nr] = sum;
+  });
+
+  std::vector<ComplexD> result((size_t)Ncontr*fd,ComplexD(0.0));
+  int pc = grid->_processor_coor[orthogdim];
+  thread_for(n, Ncontr, {
+    Coordinate icoor(Nd);
+    ExtractBuffer<sobj> extracted(Nsimd);
+    for(int rt=0;rt<rd;rt++){
+      extract(lvSum[n*rd+rt],extracted);
+      for(int idx=0;idx<Nsimd;idx++){
+        grid->iCoorFromIindex(icoor,idx);
+        int lt = rt+icoor[orthogdim]*rd;
+        result[(size_t)n*fd+pc*ld+lt] += TensorRemove(extracted[idx]);
+      }
+    }
+  });
+  grid->GlobalSumVector(&result[0],Ncontr*fd);
+
+  for (int n=0; n<Ncontr; n++) {
+    baryon_corr[n].assign(result.begin()+(size_t)n*fd,result.begin()+(size_t)(n+1)*fd);
+  }
+}
+
 /***********************************************************************
  * End of Baryon 2pt-function code.                                    *
  *                                                                     *
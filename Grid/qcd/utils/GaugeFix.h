@@ -153,9 +153,6 @@ public:
     FFT theFFT((GridCartesian *)grid);
 
     LatticeComplex  Fp(grid);
-    LatticeComplex  psq(grid); psq=Zero();
-    LatticeComplex  pmu(grid); 
-    LatticeComplex   one(grid); one = Complex(1.0,0.0);
 
     GaugeMat g(grid);
     GaugeMat dmuAmu_p(grid);
@@ -169,10 +166,36 @@ public:
     for(int mu=0;mu<Nd;mu++) if (mu==orthog) mask[mu]=0;
     theFFT.FFT_dim_mask(dmuAmu_p,dmuAmu,mask,FFT::forward);
 
-    //////////////////////////////////
-    // Work out Fp = psq_max/ psq...
-    // Avoid singularities in Fp
-    //////////////////////////////////
+    FourierAccelerationKernel(Fp,orthog);
+    
+    dmuAmu_p  = dmuAmu_p * Fp; 
+
+    theFFT.FFT_dim_mask(dmuAmu,dmuAmu_p,mask,FFT::backward);
+
+    GaugeMat ciadmam(grid);
+    Complex cialpha(0.0,-alpha);
+    ciadmam = dmuAmu*cialpha;
+    SU<Nc>::taExp(ciadmam,g);
+
+    Real trG = TensorRemove(sum(trace(g))).real()/vol/Nc;
+
+    xform = g*xform ;
+    SU<Nc>::GaugeTransform(U,g);
+
+    return trG;
+  }
+
+  //////////////////////////////////
+  // Work out Fp = psq_max/ psq...
+  // Avoid singularities in Fp
+  //////////////////////////////////
+  static void FourierAccelerationKernel(LatticeComplex &Fp,int orthog) {
+    GridBase *grid = Fp.Grid();
+
+    LatticeComplex  psq(grid); psq=Zero();
+    LatticeComplex  pmu(grid); 
+    LatticeComplex   one(grid); one = Complex(1.0,0.0);
+
     Coordinate latt_size = grid->GlobalDimensions();
     Coordinate coor(grid->_ndimension,0);
     for(int mu=0;mu<Nd;mu++) {
@@ -194,22 +217,335 @@ public:
 	pokeSite(TComplex(16.0),Fp,coor);
       }
     }
-    
-    dmuAmu_p  = dmuAmu_p * Fp; 
+  }
 
-    theFFT.FFT_dim_mask(dmuAmu,dmuAmu_p,mask,FFT::backward);
+  //////////////////////////////////////////////////////////////////////////////
+  // Gauge functional F = sum_{x,mu!=orthog} Re tr U_mu(x) / (Nc V Nd'), which
+  // the fixing maximises, and precision theta = sum_x tr |dmuAmu|^2 / (Nc V).
+  //////////////////////////////////////////////////////////////////////////////
+  static Real LinkTrace(const std::vector<GaugeMat> &U,int orthog) {
+    GridBase *grid = U[0].Grid();
+    ComplexD tr(0.0);
+    int ndir = 0;
+    for(int mu=0;mu<Nd;mu++){
+      if ( mu != orthog ) {
+	tr += TensorRemove(sum(trace(U[mu])));
+	ndir++;
+      }
+    }
+    return tr.real()/grid->gSites()/Nc/ndir;
+  }
+  static Real Theta(const GaugeMat &dmuAmu) {
+    return norm2(dmuAmu)/dmuAmu.Grid()->gSites()/Nc;
+  }
 
-    GaugeMat ciadmam(grid);
-    Complex cialpha(0.0,-alpha);
-    ciadmam = dmuAmu*cialpha;
-    SU<Nc>::taExp(ciadmam,g);
+  //////////////////////////////////////////////////////////////////////////////
+  // Fourier accelerated nonlinear conjugate gradient.
+  //
+  // The search direction is the Fourier accelerated gradient plus a
+  // Polak-Ribiere multiple of the previous direction, restarted whenever the
+  // multiple is negative or the line search fails. The step is the maximum of
+  // the parabola through F at 0, alpha and 2 alpha along the direction, so
+  // alpha only sets the scale of the trial steps. The links are kept as Nd
+  // link fields for the whole solve and returned to Umu once at the end.
+  // Converged when theta < theta_tol and the relative change of F is below
+  // Phi_tol; returns the number of iterations.
+  //////////////////////////////////////////////////////////////////////////////
+  static int ConjugateGradientGaugeFix(GaugeLorentz &Umu,Real alpha,int maxiter,Real theta_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
+    GridBase *grid = Umu.Grid();
+    GaugeMat xform(grid);
+    return ConjugateGradientGaugeFix(Umu,xform,alpha,maxiter,theta_tol,Phi_tol,orthog,err_on_no_converge);
+  }
+  static int ConjugateGradientGaugeFix(GaugeLorentz &Umu,GaugeMat &xform,Real alpha,int maxiter,Real theta_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
 
-    Real trG = TensorRemove(sum(trace(g))).real()/vol/Nc;
+    GridBase *grid = Umu.Grid();
 
-    xform = g*xform ;
-    SU<Nc>::GaugeTransform(U,g);
+    xform=1.0;
 
-    return trG;
+    std::vector<GaugeMat> U(Nd,grid);
+    std::vector<GaugeMat> Utrial(Nd,grid);
+    std::vector<GaugeMat> A(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
+
+    FFT theFFT((GridCartesian *)grid);
+    LatticeComplex Fp(grid);
+    FourierAccelerationKernel(Fp,orthog);
+    Coordinate mask(Nd,1);
+    if( (orthog>=0) && (orthog<Nd) ) mask[orthog]=0;
+
+    GaugeMat grad(grid), grad_old(grid);
+    GaugeMat prec(grid), grad_p(grid);
+    GaugeMat dir(grid);
+    GaugeMat g(grid);
+
+    RealD prec_grad_old = 0.0;
+    bool  restart = true;
+    Real  F0 = LinkTrace(U,orthog);
+
+    if( (orthog>=0) && (orthog<Nd) ){
+      std::cout << GridLogMessage << " CG gauge fixing to Coulomb gauge time="<<orthog<< " F= "<<F0<< std::endl;
+    } else { 
+      std::cout << GridLogMessage << " CG gauge fixing to Landau gauge F= "<<F0<< std::endl;
+    }
+
+    for(int i=0;i<maxiter;i++){
+
+      GaugeLinkToLieAlgebraField(U,A);
+      DmuAmu(A,grad,orthog);
+      Real theta = Theta(grad);
+
+      theFFT.FFT_dim_mask(grad_p,grad,mask,FFT::forward);
+      grad_p = grad_p * Fp;
+      theFFT.FFT_dim_mask(prec,grad_p,mask,FFT::backward);
+
+      RealD prec_grad = real(innerProduct(prec,grad));
+      RealD beta = 0.0;
+      if ( !restart ) {
+	beta = (prec_grad - real(innerProduct(prec,grad_old)))/prec_grad_old;
+	if ( beta < 0.0 ) beta = 0.0;
+      }
+      if ( beta == 0.0 ) dir = prec;
+      else               dir = prec + beta*dir;
+      grad_old      = grad;
+      prec_grad_old = prec_grad;
+
+      // parabola through F(0), F(alpha), F(2 alpha)
+      Real F1 = TrialLinkTrace(U,Utrial,dir,alpha,g,orthog);
+      Real F2 = TrialLinkTrace(U,Utrial,dir,2.0*alpha,g,orthog);
+      Real curv = F2 - 2.0*F1 + F0;
+      Real step = alpha;
+      restart = true;
+      if ( curv < 0.0 ) {
+	Real s = alpha*(3.0*F0 - 4.0*F1 + F2)/(2.0*curv);
+	if ( (s > 0.0) && (s < 4.0*alpha) ) {
+	  step    = s;
+	  restart = false;
+	}
+      }
+
+      ExpiAlphaDirection(dir,g,step);
+      xform = g*xform ;
+      SU<Nc>::GaugeTransform(U,g);
+
+      Real F   = LinkTrace(U,orthog);
+      Real Phi = 1.0 - F0/F;
+      F0 = F;
+
+      if ( i %20 == 0 ) { 
+	std::cout << GridLogMessage << "CG Iteration "<<i<< " F= "<<F<< " theta= "<<theta<< " Phi= "<<Phi<< " step= "<<step<< " beta= "<<beta<<std::endl;
+      }
+      if ( (theta < theta_tol) && ( ::fabs(Phi) < Phi_tol) ) {
+	std::cout << GridLogMessage << "CG gauge fixing converged in "<<i+1<<" iterations, theta= "<<theta<<std::endl;
+	for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+	return i+1;
+      }
+    }
+    for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+    std::cout << GridLogError << "CG gauge fixing did not converge in " << maxiter << " iterations." << std::endl;
+    if (err_on_no_converge) assert(0);
+    return maxiter;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Coulomb gauge fixing with every timeslice an independent 3d problem.
+  //
+  // The Coulomb functional of a slice depends only on the spatial links of
+  // that slice, so ConjugateGradientGaugeFix runs on all slices at once with
+  // slice local inner products (sliceSum), conjugation parameters, line
+  // search steps and convergence tests. A converged slice is frozen: its
+  // search direction is zero and the gauge transformation there is the
+  // identity, while unconverged slices keep iterating at their own pace.
+  // Returns the number of iterations needed by the slowest slice.
+  //////////////////////////////////////////////////////////////////////////////
+  static int CoulombGaugeFixBySlice(GaugeLorentz &Umu,GaugeMat &xform,Real alpha,int maxiter,Real theta_tol, Real Phi_tol,int orthog=Nd-1,bool err_on_no_converge=true) {
+
+    GridBase *grid = Umu.Grid();
+    assert( (orthog>=0) && (orthog<Nd) );
+    int Nt = grid->GlobalDimensions()[orthog];
+    RealD vol3 = grid->gSites()/Nt;
+
+    xform=1.0;
+
+    std::vector<GaugeMat> U(Nd,grid);
+    std::vector<GaugeMat> Utrial(Nd,grid);
+    std::vector<GaugeMat> A(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
+
+    FFT theFFT((GridCartesian *)grid);
+    LatticeComplex Fp(grid);
+    FourierAccelerationKernel(Fp,orthog);
+    Coordinate mask(Nd,1);
+    mask[orthog]=0;
+
+    GaugeMat grad(grid), grad_old(grid);
+    GaugeMat prec(grid), grad_p(grid);
+    GaugeMat dir(grid), sdir(grid);
+    GaugeMat g(grid);
+    LatticeComplex coef(grid);
+    dir = Zero();
+
+    std::vector<RealD> theta(Nt), prec_grad(Nt), prec_grad_old(Nt,0.0);
+    std::vector<RealD> beta(Nt), step(Nt), active(Nt,1.0), Phi(Nt,1.0);
+    std::vector<int>   restart(Nt,1), iters(Nt,maxiter);
+
+    std::vector<RealD> F0 = SliceLinkTrace(U,orthog);
+    std::cout << GridLogMessage << " CG gauge fixing to Coulomb gauge slice by slice, time="<<orthog<< std::endl;
+
+    int nactive = Nt;
+    int i;
+    for(i=0;i<maxiter;i++){
+
+      GaugeLinkToLieAlgebraField(U,A);
+      DmuAmu(A,grad,orthog);
+      SliceInnerProduct(grad,grad,theta,orthog);
+      for(int t=0;t<Nt;t++){
+	theta[t] = theta[t]/vol3/Nc;
+	if ( active[t] && (theta[t] < theta_tol) && (::fabs(Phi[t]) < Phi_tol) ) {
+	  active[t] = 0.0;
+	  iters[t]  = i;
+	  nactive--;
+	}
+      }
+      if ( nactive == 0 ) break;
+
+      theFFT.FFT_dim_mask(grad_p,grad,mask,FFT::forward);
+      grad_p = grad_p * Fp;
+      theFFT.FFT_dim_mask(prec,grad_p,mask,FFT::backward);
+
+      // dir = active*(prec + beta dir), per slice Polak-Ribiere
+      SliceInnerProduct(prec,grad,prec_grad,orthog);
+      SliceInnerProduct(prec,grad_old,beta,orthog);
+      for(int t=0;t<Nt;t++){
+	if ( restart[t] || !active[t] ) beta[t] = 0.0;
+	else              beta[t] = std::max(0.0,(prec_grad[t]-beta[t])/prec_grad_old[t]);
+      }
+      SliceField(coef,beta,orthog);
+      dir = prec + coef*dir;
+      SliceField(coef,active,orthog);
+      dir = coef*dir;
+      grad_old      = grad;
+      prec_grad_old = prec_grad;
+
+      // per slice parabola through F(0), F(alpha), F(2 alpha)
+      std::vector<RealD> F1 = TrialSliceLinkTrace(U,Utrial,dir,alpha,g,orthog);
+      std::vector<RealD> F2 = TrialSliceLinkTrace(U,Utrial,dir,2.0*alpha,g,orthog);
+      for(int t=0;t<Nt;t++){
+	RealD curv = F2[t] - 2.0*F1[t] + F0[t];
+	step[t]    = alpha;
+	restart[t] = 1;
+	if ( curv < 0.0 ) {
+	  RealD st = alpha*(3.0*F0[t] - 4.0*F1[t] + F2[t])/(2.0*curv);
+	  if ( (st > 0.0) && (st < 4.0*alpha) ) {
+	    step[t]    = st;
+	    restart[t] = 0;
+	  }
+	}
+      }
+      SliceField(coef,step,orthog);
+      sdir = coef*dir;
+      ExpiAlphaDirection(sdir,g,1.0);
+      xform = g*xform ;
+      SU<Nc>::GaugeTransform(U,g);
+
+      std::vector<RealD> F = SliceLinkTrace(U,orthog);
+      for(int t=0;t<Nt;t++){
+	if ( active[t] ) Phi[t] = 1.0 - F0[t]/F[t];
+      }
+      F0 = F;
+
+      if ( i %20 == 0 ) { 
+	RealD theta_max = 0.0;
+	for(int t=0;t<Nt;t++) if ( active[t] ) theta_max = std::max(theta_max,theta[t]);
+	std::cout << GridLogMessage << "CG Iteration "<<i<< " active slices "<<nactive<<"/"<<Nt<< " max theta= "<<theta_max<<std::endl;
+      }
+    }
+
+    for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+    for(int t=0;t<Nt;t++){
+      std::cout << GridLogMessage << "CG gauge fixing slice "<<t<<" converged in "<<iters[t]<<" iterations, theta= "<<theta[t]<<std::endl;
+    }
+    if ( nactive ) {
+      std::cout << GridLogError << "CG gauge fixing: " << nactive << " slices did not converge in " << maxiter << " iterations." << std::endl;
+      if (err_on_no_converge) assert(0);
+    }
+    return i;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Overrelaxed local gauge fixing.
+  //
+  // Each sweep visits the two checkerboards in turn. On a site of the active
+  // parity g maximises Re tr g w, w = sum_{mu!=orthog} U_mu(x) + U_mu(x-mu)^dag,
+  // by successive SU(2) subgroup rotations, each overrelaxed to the power
+  // omega (linearised and reunitarised, 1 <= omega < 2); the other parity is
+  // left alone, so the update is a single gauge transformation per parity.
+  // Convergence is tested every 10 sweeps as for ConjugateGradientGaugeFix.
+  //////////////////////////////////////////////////////////////////////////////
+  static int OverrelaxedGaugeFix(GaugeLorentz &Umu,Real omega,int maxiter,Real theta_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
+    GridBase *grid = Umu.Grid();
+    GaugeMat xform(grid);
+    return OverrelaxedGaugeFix(Umu,xform,omega,maxiter,theta_tol,Phi_tol,orthog,err_on_no_converge);
+  }
+  static int OverrelaxedGaugeFix(GaugeLorentz &Umu,GaugeMat &xform,Real omega,int maxiter,Real theta_tol, Real Phi_tol,int orthog=-1,bool err_on_no_converge=true) {
+
+    GridBase *grid = Umu.Grid();
+
+    xform=1.0;
+
+    std::vector<GaugeMat> U(Nd,grid);
+    std::vector<GaugeMat> A(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) U[mu]= PeekIndex<LorentzIndex>(Umu,mu);
+
+    LatticeInteger parity(grid), coor(grid);
+    parity = Zero();
+    for(int mu=0;mu<Nd;mu++){
+      LatticeCoordinate(coor,mu);
+      parity = parity + coor;
+    }
+    parity = mod(parity,2);
+
+    GaugeMat w(grid), g(grid), one(grid), dmuAmu(grid);
+    one = 1.0;
+
+    Real F0 = LinkTrace(U,orthog);
+    if( (orthog>=0) && (orthog<Nd) ){
+      std::cout << GridLogMessage << " Overrelaxed gauge fixing to Coulomb gauge time="<<orthog<< " F= "<<F0<< " omega= "<<omega<<std::endl;
+    } else { 
+      std::cout << GridLogMessage << " Overrelaxed gauge fixing to Landau gauge F= "<<F0<< " omega= "<<omega<<std::endl;
+    }
+
+    for(int i=0;i<maxiter;i++){
+
+      for(int cb=0;cb<2;cb++){
+	w = Zero();
+	for(int mu=0;mu<Nd;mu++){
+	  if ( mu != orthog ) w = w + U[mu] + adj(Cshift(U[mu],mu,-1));
+	}
+	OverrelaxedLocalMaximum(w,g,omega);
+	g = where(parity==Integer(cb),g,one);
+	xform = g*xform ;
+	SU<Nc>::GaugeTransform(U,g);
+      }
+
+      if ( (i+1) %10 == 0 ) { 
+	GaugeLinkToLieAlgebraField(U,A);
+	DmuAmu(A,dmuAmu,orthog);
+	Real theta = Theta(dmuAmu);
+	Real F     = LinkTrace(U,orthog);
+	Real Phi   = 1.0 - F0/F;
+	F0 = F;
+	std::cout << GridLogMessage << "Overrelaxed sweep "<<i+1<< " F= "<<F<< " theta= "<<theta<< " Phi= "<<Phi<<std::endl;
+	if ( (theta < theta_tol) && ( ::fabs(Phi) < Phi_tol) ) {
+	  std::cout << GridLogMessage << "Overrelaxed gauge fixing converged in "<<i+1<<" sweeps, theta= "<<theta<<std::endl;
+	  for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+	  return i+1;
+	}
+      }
+    }
+    for(int mu=0;mu<Nd;mu++) PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+    std::cout << GridLogError << "Overrelaxed gauge fixing did not converge in " << maxiter << " sweeps." << std::endl;
+    if (err_on_no_converge) assert(0);
+    return maxiter;
   }
 
   static void ExpiAlphaDmuAmu(const std::vector<GaugeMat> &A,GaugeMat &g,Real & alpha, GaugeMat &dmuAmu,int orthog) {
@@ -220,6 +556,113 @@ public:
     ciadmam = dmuAmu*cialpha;
     SU<Nc>::taExp(ciadmam,g);
   }  
+
+private:
+
+  // g = exp(-i alpha dir)
+  static void ExpiAlphaDirection(const GaugeMat &dir,GaugeMat &g,Real alpha) {
+    GridBase *grid = g.Grid();
+    Complex cialpha(0.0,-alpha);
+    GaugeMat ciadir(grid);
+    ciadir = dir*cialpha;
+    SU<Nc>::taExp(ciadir,g);
+  }
+
+  // F after the gauge transformation exp(-i alpha dir), leaving U unchanged
+  static Real TrialLinkTrace(const std::vector<GaugeMat> &U,std::vector<GaugeMat> &Utrial,
+			     const GaugeMat &dir,Real alpha,GaugeMat &g,int orthog) {
+    ExpiAlphaDirection(dir,g,alpha);
+    for(int mu=0;mu<Nd;mu++) Utrial[mu] = U[mu];
+    SU<Nc>::GaugeTransform(Utrial,g);
+    return LinkTrace(Utrial,orthog);
+  }
+
+  // Re tr of the spatial links per slice, normalised as LinkTrace
+  static std::vector<RealD> SliceLinkTrace(const std::vector<GaugeMat> &U,int orthog) {
+    GridBase *grid = U[0].Grid();
+    int Nt = grid->GlobalDimensions()[orthog];
+    RealD norm = grid->gSites()/Nt*Nc*(Nd-1);
+    LatticeComplex tr(grid);
+    tr = Zero();
+    for(int mu=0;mu<Nd;mu++){
+      if ( mu != orthog ) tr = tr + trace(U[mu]);
+    }
+    std::vector<TComplex> sl;
+    sliceSum(tr,sl,orthog);
+    std::vector<RealD> F(Nt);
+    for(int t=0;t<Nt;t++) F[t] = real(TensorRemove(sl[t]))/norm;
+    return F;
+  }
+  static std::vector<RealD> TrialSliceLinkTrace(const std::vector<GaugeMat> &U,std::vector<GaugeMat> &Utrial,
+						const GaugeMat &dir,Real alpha,GaugeMat &g,int orthog) {
+    ExpiAlphaDirection(dir,g,alpha);
+    for(int mu=0;mu<Nd;mu++) Utrial[mu] = U[mu];
+    SU<Nc>::GaugeTransform(Utrial,g);
+    return SliceLinkTrace(Utrial,orthog);
+  }
+
+  // Re <a,b> restricted to each slice
+  static void SliceInnerProduct(const GaugeMat &a,const GaugeMat &b,std::vector<RealD> &ip,int orthog) {
+    std::vector<TComplex> sl;
+    sliceSum(localInnerProduct(a,b),sl,orthog);
+    ip.resize(sl.size());
+    for(size_t t=0;t<sl.size();t++) ip[t] = real(TensorRemove(sl[t]));
+  }
+
+  // field equal to c[t] on slice t
+  static void SliceField(LatticeComplex &field,const std::vector<RealD> &c,int orthog) {
+    GridBase *grid = field.Grid();
+    Coordinate ldims = grid->LocalDimensions();
+    int t0 = grid->_processor_coor[orthog]*ldims[orthog];
+    uint64_t lsites = grid->lSites();
+    std::vector<TComplex> lex(lsites);
+    thread_for(idx,lsites,{
+      Coordinate lcoor(grid->Nd());
+      Lexicographic::CoorFromIndex(lcoor,idx,ldims);
+      lex[idx] = ComplexD(c[t0+lcoor[orthog]],0.0);
+    });
+    vectorizeFromLexOrdArray(lex,field);
+  }
+
+  // Site local maximum of Re tr g w over SU(2) subgroups, overrelaxed by omega
+  static void OverrelaxedLocalMaximum(const GaugeMat &w,GaugeMat &g,Real omega) {
+    GridBase *grid = w.Grid();
+    uint64_t osites = grid->oSites();
+    autoView( w_v , w, AcceleratorRead);
+    autoView( g_v , g, AcceleratorWrite);
+    accelerator_for(ss, osites, vComplex::Nsimd(), {
+      auto wg = coalescedRead(w_v[ss]);
+      auto gg = wg;
+      typedef typename std::remove_reference<decltype(wg()()(0,0))>::type cplx;
+      gg = 1.0;
+      for(int su2=0;su2<(Nc*(Nc-1))/2;su2++){
+	int i0, i1;
+	SU<Nc>::su2SubGroupIndex(i0, i1, su2);
+	// SU(2) proportional part n of the subgroup block of wg; the
+	// maximum is at n^dag/|n|, here mixed with the identity
+	auto n00 = (wg()()(i0,i0) + conjugate(wg()()(i1,i1)))*0.5;
+	auto n10 = (wg()()(i1,i0) - conjugate(wg()()(i0,i1)))*0.5;
+	auto nrm = sqrt(innerProduct(n00,n00)+innerProduct(n10,n10));
+	auto p   = conjugate(n00)*omega/nrm + cplx(1.0-omega);
+	auto q   = conjugate(n10)*omega/nrm;
+	auto pq  = sqrt(innerProduct(p,p)+innerProduct(q,q));
+	p = p/pq;
+	q = q/pq;
+	// r = [[p, q],[-q^*, p^*]] applied to rows i0,i1 of g and of wg
+	for(int k=0;k<Nc;k++){
+	  auto g0 = gg()()(i0,k);
+	  auto g1 = gg()()(i1,k);
+	  gg()()(i0,k) =  p*g0 + q*g1;
+	  gg()()(i1,k) = -conjugate(q)*g0 + conjugate(p)*g1;
+	  auto w0 = wg()()(i0,k);
+	  auto w1 = wg()()(i1,k);
+	  wg()()(i0,k) =  p*w0 + q*w1;
+	  wg()()(i1,k) = -conjugate(q)*w0 + conjugate(p)*w1;
+	}
+      }
+      coalescedWrite(g_v[ss],gg);
+    });
+  }
 };
 
 NAMESPACE_END(Grid);
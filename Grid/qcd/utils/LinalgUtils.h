@@ -55,6 +55,24 @@ void axpibg5x(Lattice<vobj> &z,const Lattice<vobj> &x,Coeff a,Coeff b)
   });
 }
 
+// z = a*x + b*i*G5*x + y; completes an unpreconditioned twisted mass operator in one sweep
+template<class vobj,class Coeff>
+void axpibg5xpy(Lattice<vobj> &z,const Lattice<vobj> &x,Coeff a,Coeff b,const Lattice<vobj> &y)
+{
+  z.Checkerboard() = x.Checkerboard();
+  conformable(x,y);
+  conformable(x,z);
+
+  Gamma G5(Gamma::Algebra::Gamma5);
+  autoView(x_v, x, AcceleratorRead);
+  autoView(y_v, y, AcceleratorRead);
+  autoView(z_v, z, AcceleratorWrite);
+  accelerator_for( ss, x_v.size(),vobj::Nsimd(), {
+    auto tmp = a*x_v(ss) + G5*(b*timesI(x_v(ss))) + y_v(ss);
+    coalescedWrite(z_v[ss],tmp);
+  });
+}
+
 template<class vobj,class Coeff> 
 void axpby_ssp(Lattice<vobj> &z, Coeff a,const Lattice<vobj> &x,Coeff b,const Lattice<vobj> &y,int s,int sp)
 {
@@ -0,0 +1,322 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/utils/QuenchedUpdate.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_QCD_QUENCHED_UPDATE_H
+#define GRID_QCD_QUENCHED_UPDATE_H
+
+NAMESPACE_BEGIN(Grid);
+
+class QuenchedUpdateParameters : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(QuenchedUpdateParameters,
+				  RealD, beta,
+				  int, heatbath,    // heat bath passes per sweep
+				  int, overrelax,   // overrelaxation passes after each heat bath pass
+				  int, trials);     // Kennedy-Pendleton trials before a link is left as is
+
+  QuenchedUpdateParameters(RealD _beta = 6.0, int _heatbath = 1, int _overrelax = 4, int _trials = 20)
+    : beta(_beta), heatbath(_heatbath), overrelax(_overrelax), trials(_trials) {};
+};
+
+////////////////////////////////////////////////////////////////////////////////////
+// Pure gauge (Wilson action) update: Cabibbo-Marinari heat bath with the
+// Kennedy-Pendleton SU(2) sampler, plus microcanonical overrelaxation.
+//
+// For each direction and checkerboard the staple is built once, on that
+// checkerboard only when the links are periodic, and a single
+// site kernel then runs every SU(2) subgroup on the link in registers:
+// M = U W is updated in place by the row rotation, so there are no lattice
+// wide su2Extract/su2Insert temporaries, masks or retry sweeps. The rejection
+// loop is per site, drawing from a Philox stream keyed by the serial RNG and
+// the global site, so the ensemble does not depend on the layout.
+////////////////////////////////////////////////////////////////////////////////////
+template <class Gimpl>
+class QuenchedUpdate {
+public:
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  typedef typename GaugeLinkField::vector_object vobj;
+  typedef typename vobj::scalar_object sobj;
+  typedef ComplexD Cplx;
+
+  QuenchedUpdateParameters Params;
+  uint64_t Updates;    // heat bath link updates attempted
+  uint64_t Rejected;   // of which left unchanged after Params.trials attempts
+
+  QuenchedUpdate(const QuenchedUpdateParameters &_p) : Params(_p), Updates(0), Rejected(0) {};
+
+  //////////////////////////////////////////////////////////////
+  // One sweep: Params.heatbath times (one heat bath pass followed
+  // by Params.overrelax overrelaxation passes) over all links.
+  //////////////////////////////////////////////////////////////
+  void Sweep(GridSerialRNG &sRNG, GaugeField &Umu)
+  {
+    GridBase *grid = Umu.Grid();
+
+    // Fresh key for this sweep from the serial stream
+    uint32_t key[2];
+    for(int k=0;k<2;k++){
+      RealD r;
+      random(sRNG,r);
+      key[k] = (uint32_t)(r*4294967296.0);
+    }
+    uint64_t draw = 0;
+
+    std::vector<GaugeLinkField> U(Nd,grid);
+    for(int mu=0;mu<Nd;mu++) U[mu] = PeekIndex<LorentzIndex>(Umu,mu);
+
+    // With periodic links the staple is only built on the checkerboard being
+    // updated, from copies of the links split by parity
+    bool checkerboarded = Gimpl::isPeriodicGaugeField();
+    GridRedBlackCartesian rbgrid(grid);
+    std::vector<GaugeLinkField> Ucb[2];
+    GaugeLinkField staple_cb(&rbgrid);
+    if ( checkerboarded ) {
+      for(int cb=0;cb<2;cb++){
+	Ucb[cb].resize(Nd,&rbgrid);
+	for(int mu=0;mu<Nd;mu++) pickCheckerboard(cb,Ucb[cb][mu],U[mu]);
+      }
+    }
+
+    GaugeLinkField staple(grid);
+    for(int hb=0;hb<Params.heatbath;hb++){
+      for(int pass=0;pass<=Params.overrelax;pass++){
+	for(int mu=0;mu<Nd;mu++){
+	  for(int cb=0;cb<2;cb++){
+	    if ( checkerboarded ) {
+	      StapleCheckerboard(staple_cb,Ucb,mu,cb);
+	      setCheckerboard(staple,staple_cb);
+	    } else {
+	      Staple(staple,U,mu);
+	    }
+	    UpdateLinks(U[mu],staple,cb,pass==0,key,draw++);
+	    if ( checkerboarded ) pickCheckerboard(cb,Ucb[cb][mu],U[mu]);
+	  }
+	}
+      }
+    }
+
+    for(int mu=0;mu<Nd;mu++){
+      U[mu] = ProjectOnGroup(U[mu]);
+      PokeIndex<LorentzIndex>(Umu,U[mu],mu);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////
+  // Sum of the staples around link mu; Tr U_mu staple is the sum of
+  // the plaquettes containing U_mu.
+  //////////////////////////////////////////////////////////////
+  static void Staple(GaugeLinkField &staple,const std::vector<GaugeLinkField> &U,int mu)
+  {
+    staple = Zero();
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu != mu ) {
+	staple += Gimpl::ShiftStaple(Gimpl::CovShiftForward(U[nu],nu,
+				     Gimpl::CovShiftBackward(U[mu],mu,
+				     Gimpl::CovShiftIdentityBackward(U[nu],nu))),mu);
+	staple += Gimpl::ShiftStaple(Gimpl::CovShiftBackward(U[nu],nu,
+				     Gimpl::CovShiftBackward(U[mu],mu,U[nu])),mu);
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////
+  // The same staple on the sites of checkerboard cb only; Ucb[p][nu]
+  // holds U_nu on the sites of parity p. Each shift changes parity.
+  // Periodic links only: the twisted shifts mark the boundary by
+  // coordinate, which is not available on the halved dimension.
+  //////////////////////////////////////////////////////////////
+  static void StapleCheckerboard(GaugeLinkField &staple,const std::vector<GaugeLinkField> Ucb[2],int mu,int cb)
+  {
+    assert(Gimpl::isPeriodicGaugeField());
+    int oc = 1-cb;
+    staple.Checkerboard() = cb;
+    staple = Zero();
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu != mu ) {
+	staple += Gimpl::ShiftStaple(Gimpl::CovShiftForward(Ucb[oc][nu],nu,
+				     Gimpl::CovShiftBackward(Ucb[oc][mu],mu,
+				     Gimpl::CovShiftIdentityBackward(Ucb[cb][nu],nu))),mu);
+	staple += Gimpl::ShiftStaple(Gimpl::CovShiftBackward(Ucb[cb][nu],nu,
+				     Gimpl::CovShiftBackward(Ucb[oc][mu],mu,Ucb[oc][nu])),mu);
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////
+  // Heat bath or overrelaxation of the links of one checkerboard
+  //////////////////////////////////////////////////////////////
+  void UpdateLinks(GaugeLinkField &link,const GaugeLinkField &staple,int cb,bool heatbath,
+		   const uint32_t key[2],uint64_t draw)
+  {
+    GridBase *grid = link.Grid();
+    const int Nsimd = grid->Nsimd();
+    const int Nsub  = (Nc*(Nc-1))/2;
+    RealD coeff  = Params.beta/Nc;
+    int   trials = Params.trials;
+    uint64_t osites = grid->oSites();
+    std::vector<int> rejected(osites,0);
+    std::vector<int> updated(osites,0);
+
+    autoView( link_v   , link  , CpuWrite);
+    autoView( staple_v , staple, CpuRead);
+    thread_for( ss, osites, {
+      ExtractBuffer<sobj> Ubuf(Nsimd);
+      ExtractBuffer<sobj> Sbuf(Nsimd);
+      extract(link_v[ss],Ubuf);
+      extract(staple_v[ss],Sbuf);
+
+      Coordinate ocoor, icoor, lcoor, gcoor(grid->Nd());
+      grid->oCoorFromOindex(ocoor,ss);
+      for(int lane=0;lane<Nsimd;lane++){
+
+	grid->iCoorFromIindex(icoor,lane);
+	grid->InOutCoorToLocalCoor(ocoor,icoor,lcoor);
+	int parity=0;
+	for(int d=0;d<grid->Nd();d++) {
+	  gcoor[d] = lcoor[d]+grid->_lstart[d];
+	  parity  += gcoor[d];
+	}
+	if ( (parity&1) != cb ) continue;
+	int gidx;
+	grid->GlobalCoorToGlobalIndex(gcoor,gidx);
+	PhiloxStream gen(key,gidx,draw);
+
+	sobj M = Ubuf[lane]*Sbuf[lane]*coeff;
+	auto &u = Ubuf[lane]()();
+	auto &m = M()();
+
+	for(int su2=0;su2<Nsub;su2++){
+	  int i0,i1;
+	  SU<Nc>::su2SubGroupIndex(i0,i1,su2);
+
+	  // Quaternion part of the (i0,i1) block: q = k v, v in SU(2)
+	  RealD a[4];
+	  a[0] = 0.5*real(m(i0,i0)+m(i1,i1));
+	  a[1] = 0.5*imag(m(i0,i1)+m(i1,i0));
+	  a[2] = 0.5*real(m(i0,i1)-m(i1,i0));
+	  a[3] = 0.5*imag(m(i0,i0)-m(i1,i1));
+	  RealD k = std::sqrt(a[0]*a[0]+a[1]*a[1]+a[2]*a[2]+a[3]*a[3]);
+	  if ( k < 1.0e-12 ) continue;
+	  Cplx v[2][2], vdag[2][2], x[2][2], r[2][2];
+	  Quaternion(a[0]/k,a[1]/k,a[2]/k,a[3]/k,v);
+	  Adj(v,vdag);
+
+	  if ( heatbath ) {
+	    // Re Tr r q = k Re Tr x with x = r v Haar distributed with weight e^{2k x0}
+	    updated[ss]++;
+	    RealD x0;
+	    if ( !KennedyPendleton(2.0*k,gen,trials,x0) ) {
+	      rejected[ss]++;
+	      continue;
+	    }
+	    RealD ct  = 2.0*Uniform(gen)-1.0;
+	    RealD phi = 2.0*M_PI*Uniform(gen);
+	    RealD rad = std::sqrt(std::fabs(1.0-x0*x0));
+	    RealD st  = std::sqrt(std::fabs(1.0-ct*ct));
+	    Quaternion(x0,rad*st*std::cos(phi),rad*st*std::sin(phi),rad*ct,x);
+	    Mult(x,vdag,r);
+	  } else {
+	    // Reflection leaving Re Tr r q unchanged
+	    Mult(vdag,vdag,r);
+	  }
+	  RotateRows(r,i0,i1,u);
+	  RotateRows(r,i0,i1,m);
+	}
+      }
+      merge(link_v[ss],Ubuf);
+    });
+
+    for(uint64_t ss=0;ss<osites;ss++) {
+      Updates  += updated[ss];
+      Rejected += rejected[ss];
+    }
+  }
+
+  void Report(void) {
+    std::cout << GridLogMessage << "QuenchedUpdate: " << Updates << " heat bath subgroup updates, "
+	      << Rejected << " left unchanged after " << Params.trials << " trials" << std::endl;
+  }
+
+private:
+
+  static inline RealD Uniform(PhiloxStream &gen) {
+    uint32_t hi = gen();
+    uint32_t lo = gen();
+    return Philox4x32::Uniform(hi,lo);
+  }
+
+  ///////////////////////////////////////////////////////////////
+  // PLB 156 P393 (1985) (Kennedy and Pendleton): x0 in [-1,1]
+  // with density sqrt(1-x0^2) e^{alpha x0}
+  ///////////////////////////////////////////////////////////////
+  static inline bool KennedyPendleton(RealD alpha,PhiloxStream &gen,int trials,RealD &x0)
+  {
+    for(int t=0;t<trials;t++){
+      RealD r0 = Uniform(gen);
+      RealD r1 = Uniform(gen);
+      RealD r2 = Uniform(gen);
+      RealD r3 = Uniform(gen);
+      RealD X  = -std::log(r1)/alpha;
+      RealD Xp = -std::log(r2)/alpha;
+      RealD C  = std::cos(2.0*M_PI*r3);
+      RealD d  = Xp + X*C*C;
+      if ( r0*r0 <= 1.0-0.5*d ) {
+	x0 = 1.0-d;
+	return true;
+      }
+    }
+    return false;
+  }
+
+  // x0 + i x.sigma
+  static inline void Quaternion(RealD x0,RealD x1,RealD x2,RealD x3,Cplx q[2][2]) {
+    q[0][0] = Cplx( x0, x3);
+    q[0][1] = Cplx( x2, x1);
+    q[1][0] = Cplx(-x2, x1);
+    q[1][1] = Cplx( x0,-x3);
+  }
+  static inline void Adj(const Cplx a[2][2],Cplx b[2][2]) {
+    for(int i=0;i<2;i++) for(int j=0;j<2;j++) b[i][j] = std::conj(a[j][i]);
+  }
+  static inline void Mult(const Cplx a[2][2],const Cplx b[2][2],Cplx c[2][2]) {
+    for(int i=0;i<2;i++) for(int j=0;j<2;j++) c[i][j] = a[i][0]*b[0][j]+a[i][1]*b[1][j];
+  }
+  // rows (i0,i1) of mat replaced by r acting on them
+  template<class mat> static inline void RotateRows(const Cplx r[2][2],int i0,int i1,mat &m) {
+    for(int j=0;j<Nc;j++){
+      Cplx m0 = m(i0,j);
+      Cplx m1 = m(i1,j);
+      m(i0,j) = r[0][0]*m0 + r[0][1]*m1;
+      m(i1,j) = r[1][0]*m0 + r[1][1]*m1;
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -105,6 +105,19 @@ accelerator_inline Grid_half sfw_float_to_half(float ff) {
   o.x |= static_cast<unsigned short>(sign >> 16);
   return o;
 }
+// bfloat16 is the top half of an IEEE single; round to nearest even, keep NaN quiet.
+// Branch free so that loops over a site vectorise.
+accelerator_inline uint16_t sfw_float_to_bf16(float ff) {
+  FP32 f; f.f = ff;
+  unsigned int rounded = (f.u + 0x7fff + ((f.u >> 16) & 1)) >> 16;
+  unsigned int quiet   = (f.u >> 16) | 0x0040;
+  return (uint16_t)(((f.u & 0x7fffffff) > 0x7f800000) ? quiet : rounded);
+}
+accelerator_inline float sfw_bf16_to_float(uint16_t h) {
+  FP32 f;
+  f.u = ((unsigned int)h) << 16;
+  return f.f;
+}
 
 
 #ifdef GPU_VEC
@@ -137,5 +137,239 @@ public:
   
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// General stencil with communication.
+//
+// Arbitrary shift vectors, including diagonals and shifts longer than the
+// local volume, on any processor and simd layout. An entry is local when all
+// simd lanes of the neighbour come from the same local osite, up to a lane
+// permutation (_permute is xor'ed into the lane index, as for
+// GeneralLocalStencil). Otherwise it points into the halo buffer, which
+// HaloExchange fills lane by lane:
+//
+//   one gather of every lane needed by other ranks into one send buffer,
+//   one message per source rank, all posted before any is waited on,
+//   one scatter into the halo buffer.
+//
+// The lanes needed from a rank displaced by delta depend only on local
+// coordinates, so every rank builds the same message lists and the rank at
+// -delta sends exactly the lanes this rank receives from +delta; there is no
+// setup communication. Kernels read a neighbour as
+//
+//   auto SE = st_v.GetEntry(point,ss);
+//   if ( SE->_is_local ) nbr = coalescedReadGeneralPermute(in_v[SE->_offset],SE->_permute);
+//   else                 nbr = coalescedRead(st_v.CommBuf()[SE->_offset]);
+////////////////////////////////////////////////////////////////////////////////
+struct GeneralStencilHaloEntry { 
+  uint64_t _offset;   // neighbour osite, or slot in the halo buffer
+  uint8_t  _permute;  // lane xor mask
+  uint8_t  _is_local;
+};
+
+template<class vobj>
+class GeneralStencilView {
+ public:
+  int                      _npoints;
+  GeneralStencilHaloEntry *_entries_p;
+  vobj                    *_halo_p;
+
+  accelerator_inline GeneralStencilHaloEntry * GetEntry(int point,int osite) const { 
+    return & this->_entries_p[point+this->_npoints*osite]; 
+  }
+  accelerator_inline vobj * CommBuf(void) const { return _halo_p; }
+  // tables and halo live in managed memory
+  void ViewClose(void) {}
+};
+
+template<class vobj>
+class GeneralStencil : public GeneralStencilView<vobj> {
+public:
+  typedef GeneralStencilView<vobj> View_type;
+  typedef typename vobj::scalar_object sobj;
+
+protected:
+  GridBase *                        _grid;
+
+  struct Message {
+    int      dest;    // rank we send to
+    int      from;    // rank we receive from
+    uint64_t offset;  // into the gather/scatter tables and buffers
+    uint64_t words;   // lanes
+  };
+  std::vector<Message>  _messages;
+  Vector<uint64_t>      _gather;   // osite*Nsimd+lane on this rank
+  Vector<uint64_t>      _scatter;  // slot*Nsimd+lane in the halo buffer
+
+public: 
+  GridBase *Grid(void) const { return _grid; }
+
+  View_type View(ViewMode mode=AcceleratorRead) const {
+    View_type accessor(*( (View_type *) this));
+    return accessor;
+  }
+
+  Vector<GeneralStencilHaloEntry> _entries; 
+  Vector<vobj>                    _halo;
+
+  GeneralStencil(GridBase *grid, const std::vector<Coordinate> &shifts)
+  {
+    int npoints = shifts.size();
+    int osites  = grid->oSites();
+    int Nsimd   = grid->Nsimd();
+    int nd      = grid->Nd();
+
+    this->_grid    = grid;
+    this->_npoints = npoints;
+    this->_entries.resize(npoints*osites);
+
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pdims = grid->ProcessorGrid();
+
+    // lanes sourced from each processor displacement (mod the processor grid)
+    std::map<std::vector<int>,std::pair<std::vector<uint64_t>,std::vector<uint64_t> > > lanes;
+
+    uint64_t nhalo = 0;
+    Coordinate ocoor(nd), icoor(nd), ncoor(nd);
+    std::vector<int> delta(nd);
+    std::vector<std::vector<int> > src_delta(Nsimd);
+    std::vector<uint64_t> src_osite(Nsimd), src_lane(Nsimd);
+    for(int site=0;site<osites;site++){
+      grid->oCoorFromOindex(ocoor,site);
+      for(int point=0;point<npoints;point++){
+	assert(shifts[point].size()==nd);
+
+	bool local = true;
+	for(int lane=0;lane<Nsimd;lane++){
+	  grid->iCoorFromIindex(icoor,lane);
+	  for(int d=0;d<nd;d++){
+	    int x = ocoor[d] + grid->_rdimensions[d]*icoor[d] + shifts[point][d];
+	    int q = (x >= 0) ? x/ldims[d] : -((ldims[d]-1-x)/ldims[d]);  // floor
+	    ncoor[d] = x - q*ldims[d];
+	    delta[d] = ((q % pdims[d]) + pdims[d]) % pdims[d];
+	    if ( delta[d] ) local = false;
+	  }
+	  src_delta[lane] = delta;
+	  src_osite[lane] = grid->oIndex(ncoor);
+	  src_lane[lane]  = grid->iIndex(ncoor);
+	}
+	for(int lane=0;lane<Nsimd;lane++){
+	  if ( src_osite[lane] != src_osite[0] ) local = false;
+	  if ( src_lane[lane]  != (lane ^ src_lane[0]) ) local = false;
+	}
+
+	GeneralStencilHaloEntry SE;
+	if ( local ) {
+	  SE._offset   = src_osite[0];
+	  SE._permute  = src_lane[0];
+	  SE._is_local = 1;
+	} else {
+	  SE._offset   = nhalo;
+	  SE._permute  = 0;
+	  SE._is_local = 0;
+	  for(int lane=0;lane<Nsimd;lane++){
+	    auto &l = lanes[src_delta[lane]];
+	    l.first.push_back(src_osite[lane]*Nsimd+src_lane[lane]);
+	    l.second.push_back(nhalo*Nsimd+lane);
+	  }
+	  nhalo++;
+	}
+	this->_entries[point+npoints*site] = SE;
+      }
+    }
+    this->_entries_p = &_entries[0];
+
+    _halo.resize(nhalo);
+    this->_halo_p = nhalo ? &_halo[0] : nullptr;
+
+    uint64_t words = 0;
+    for(auto &l : lanes) words += l.second.first.size();
+    _gather.resize(words);
+    _scatter.resize(words);
+
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    uint64_t offset = 0;
+    for(auto &l : lanes) {
+      Coordinate to(nd), fr(nd);
+      for(int d=0;d<nd;d++){
+	to[d] = (pcoor[d] - l.first[d] + pdims[d]) % pdims[d];
+	fr[d] = (pcoor[d] + l.first[d]) % pdims[d];
+      }
+      Message m;
+      m.dest   = grid->RankFromProcessorCoor(to);
+      m.from   = grid->RankFromProcessorCoor(fr);
+      m.offset = offset;
+      m.words  = l.second.first.size();
+      for(uint64_t w=0;w<m.words;w++){
+	_gather [offset+w] = l.second.first[w];
+	_scatter[offset+w] = l.second.second[w];
+      }
+      offset += m.words;
+      _messages.push_back(m);
+    }
+  }
+
+  void HaloExchange(const Lattice<vobj> &in)
+  {
+    conformable(_grid,in.Grid());
+    // communicate through the field's grid: a cached stencil may outlive the
+    // grid it was built on if an identical grid replaces it at the same address
+    GridBase *grid  = in.Grid();
+    const int Nsimd = vobj::Nsimd();
+    uint64_t words  = _gather.size();
+    if ( words == 0 ) return;
+
+    // Scratch buffers in the shared memory window, as for the Cshift and
+    // CartesianStencil buffers, so on node peers are written directly. Every
+    // rank allocates the same sizes in the same order, so offsets agree.
+    grid->ShmBufferFreeAll();
+    sobj *send_p = (sobj *)grid->ShmBufferMalloc(words*sizeof(sobj));
+    sobj *recv_p = (sobj *)grid->ShmBufferMalloc(words*sizeof(sobj));
+
+    // peers may still be reading their buffers from a previous exchange
+    grid->StencilBarrier();
+    {
+      autoView( in_v , in, AcceleratorRead);
+      uint64_t *gather_p = &_gather[0];
+      accelerator_for(w, words, 1, {
+	uint64_t o = gather_p[w]/Nsimd;
+	int   lane = gather_p[w]%Nsimd;
+	send_p[w]  = extractLane(lane,in_v[o]);
+      });
+    }
+
+    // all messages in flight together, then one wait
+    int nmsg = _messages.size();
+    std::vector<std::vector<CommsRequest_t> > reqs(nmsg);
+    for(int i=0;i<nmsg;i++){
+      auto &m = _messages[i];
+      if ( m.dest == grid->ThisRank() ) {
+	assert(m.from == grid->ThisRank());
+	acceleratorCopyDeviceToDeviceAsynch(&send_p[m.offset],&recv_p[m.offset],m.words*sizeof(sobj));
+      } else {
+	grid->StencilSendToRecvFromBegin(reqs[i],
+					  (void *)&send_p[m.offset],m.dest,
+					  (void *)&recv_p[m.offset],m.from,
+					  m.words*sizeof(sobj),i);
+      }
+    }
+    for(int i=0;i<nmsg;i++){
+      grid->StencilSendToRecvFromComplete(reqs[i],i);
+    }
+    acceleratorCopySynchronise();
+    // on node peers have finished writing into recv_p
+    grid->StencilBarrier();
+
+    {
+      uint64_t *scatter_p = &_scatter[0];
+      vobj     *halo_p    = &_halo[0];
+      accelerator_for(w, words, 1, {
+	uint64_t slot = scatter_p[w]/Nsimd;
+	int      lane = scatter_p[w]%Nsimd;
+	insertLane(lane,halo_p[slot],recv_p[w]);
+      });
+    }
+  }
+};
+
 NAMESPACE_END(Grid);
 
@@ -52,6 +52,20 @@ vobj coalescedReadPermute(const vobj & __restrict__ vec,int ptype,int doperm,int
     return vec;
   }
 }
+// lanemask is xor'ed into the lane index; a combination of the permute types
+template<class vobj> accelerator_inline
+vobj coalescedReadGeneralPermute(const vobj & __restrict__ vec,int lanemask,int lane=0)
+{
+  vobj ret = vec;
+  vobj tmp;
+  for(int ptype=0;(vobj::Nsimd()>>(ptype+1))>0;ptype++){
+    if ( lanemask & (vobj::Nsimd()>>(ptype+1)) ) {
+      permute(tmp,ret,ptype);
+      ret = tmp;
+    }
+  }
+  return ret;
+}
 template<class vobj> accelerator_inline
 void coalescedWrite(vobj & __restrict__ vec,const vobj & __restrict__ extracted,int lane=0)
 {
@@ -145,6 +159,11 @@ typename vobj::scalar_object coalescedReadPermute(const vobj & __restrict__ vec,
   return extractLane(plane,vec);
 }
 template<class vobj> accelerator_inline
+typename vobj::scalar_object coalescedReadGeneralPermute(const vobj & __restrict__ vec,int lanemask,int lane=acceleratorSIMTlane(vobj::Nsimd()))
+{
+  return extractLane(lane^lanemask,vec);
+}
+template<class vobj> accelerator_inline
 void coalescedWrite(vobj & __restrict__ vec,const typename vobj::scalar_object & __restrict__ extracted,int lane=acceleratorSIMTlane(vobj::Nsimd()))
 {
   insertLane(lane,vec,extracted);
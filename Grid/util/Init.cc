@@ -455,10 +455,15 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --dslash-generic: Wilson kernel for generic Nc"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel for Nc=3"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-asm    : Wilson kernel for AVX512"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-tune   : time Wilson kernels and comms modes per operator geometry on first use"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --tune-cache dir : read and record tuned choices in dir/<kernel>.db, shared between runs"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dwf-layout auto|4d|ls : SIMD layout of domain wall operators made by DomainWallLayoutFactory"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --rng-counter   : Counter based (Philox) RNGs; no per site state, decomposition independent"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
 
@@ -478,6 +483,22 @@ void Grid_init(int *argc,char ***argv)
     WilsonKernelsStatic::Opt=WilsonKernelsStatic::OptGeneric;
     StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptGeneric;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-tune") ){
+    WilsonKernelsTuner::Enabled=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--tune-cache") ){
+    GridTuneCache::Directory=GridCmdOptionPayload(*argv,*argv+*argc,"--tune-cache");
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dwf-layout") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--dwf-layout");
+    if      ( arg == "4d"   ) DomainWallLayout::Layout=DomainWallLayout::Layout4d;
+    else if ( arg == "ls"   ) DomainWallLayout::Layout=DomainWallLayout::LayoutLs;
+    else if ( arg == "auto" ) DomainWallLayout::Layout=DomainWallLayout::LayoutAuto;
+    else {
+      std::cout<<GridLogError<<"--dwf-layout expects auto, 4d or ls"<<std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap") ){
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
@@ -495,6 +516,9 @@ void Grid_init(int *argc,char ***argv)
   if( GridCmdOptionExists(*argv,*argv+*argc,"--lebesgue") ){
     LebesgueOrder::UseLebesgueOrder=1;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--rng-counter") ){
+    GridRNGbase::UseCounterBased=1;
+  }
   CartesianCommunicator::nCommThreads = 1;
 #ifdef GRID_COMMS_THREADS  
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-threads") ){
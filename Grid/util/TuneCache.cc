@@ -0,0 +1,136 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/util/TuneCache.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/GridCore.h>
+#include <unistd.h>
+
+NAMESPACE_BEGIN(Grid);
+
+std::string GridTuneCache::Directory;
+
+// rank 0's string on every rank
+static void BroadcastString(std::string &s)
+{
+  int len = s.size();
+  CartesianCommunicator::BroadcastWorld(0,(void *)&len,sizeof(len));
+  std::vector<char> buf(len+1,'\0');
+  if ( CartesianCommunicator::RankWorld() == 0 ) std::copy(s.begin(),s.end(),buf.begin());
+  if ( len ) CartesianCommunicator::BroadcastWorld(0,(void *)&buf[0],len);
+  s = std::string(&buf[0],len);
+}
+
+static std::string Token(std::string s)
+{
+  for(auto &c : s) if ( isspace(c) ) c = '_';
+  return s;
+}
+
+const std::string &GridTuneCache::Machine(void)
+{
+  static std::string machine;
+  static int initialised = 0;
+  if ( !initialised ) {
+    initialised = 1;
+    if ( CartesianCommunicator::RankWorld() == 0 ) {
+      char host[256];
+      if ( gethostname(host,sizeof(host)) ) strcpy(host,"unknown");
+      host[sizeof(host)-1] = '\0';
+
+      std::string model("unknown");
+      std::ifstream cpuinfo("/proc/cpuinfo");
+      std::string line;
+      while ( std::getline(cpuinfo,line) ) {
+	if ( line.compare(0,10,"model name") == 0 ) {
+	  auto colon = line.find(':');
+	  if ( colon != std::string::npos ) {
+	    auto start = line.find_first_not_of(" \t",colon+1);
+	    if ( start != std::string::npos ) model = line.substr(start);
+	  }
+	  break;
+	}
+      }
+      machine = Token(std::string(host) + "/" + model);
+    }
+    BroadcastString(machine);
+  }
+  return machine;
+}
+
+std::string GridTuneCache::File(const std::string &kernel)
+{
+  return Directory + "/" + kernel + ".db";
+}
+
+std::map<std::string,std::string> &GridTuneCache::Table(const std::string &kernel)
+{
+  static std::map<std::string,std::map<std::string,std::string> > tables;
+  auto it = tables.find(kernel);
+  if ( it != tables.end() ) return it->second;
+
+  auto &table = tables[kernel];
+  if ( Persistent() && (CartesianCommunicator::RankWorld() == 0) ) {
+    std::ifstream f(File(kernel));
+    std::string machine, key, value;
+    while ( f >> machine >> key ) {
+      std::getline(f,value);
+      auto start = value.find_first_not_of(" \t");
+      value = (start == std::string::npos) ? std::string() : value.substr(start);
+      if ( machine == Machine() ) table[key] = value;
+    }
+  }
+  return table;
+}
+
+bool GridTuneCache::Query(const std::string &kernel, const std::string &key, std::string &value)
+{
+  Machine(); // collective on first use, before rank 0 reads the table
+  auto &table = Table(kernel);
+  int found = 0;
+  if ( CartesianCommunicator::RankWorld() == 0 ) {
+    auto it = table.find(key);
+    if ( it != table.end() ) {
+      found = 1;
+      value = it->second;
+    }
+  }
+  CartesianCommunicator::BroadcastWorld(0,(void *)&found,sizeof(found));
+  if ( found ) BroadcastString(value);
+  return found;
+}
+
+void GridTuneCache::Record(const std::string &kernel, const std::string &key, const std::string &value)
+{
+  const std::string &machine = Machine();
+  Table(kernel)[key] = value;
+  if ( Persistent() && (CartesianCommunicator::RankWorld() == 0) ) {
+    std::ofstream f(File(kernel), std::ios::app);
+    f << machine << " " << key << " " << value << std::endl;
+    if ( !f ) std::cout << GridLogWarning << "GridTuneCache: could not write " << File(kernel) << std::endl;
+  }
+}
+
+NAMESPACE_END(Grid);
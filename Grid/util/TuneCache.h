@@ -0,0 +1,61 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/util/TuneCache.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <map>
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////
+// Persistent record of measured performance decisions.
+//
+// Each kernel id has a text file <Directory>/<kernel>.db with one line per
+// decision: "<machine> <key> <value>". The machine is the host name and CPU
+// model of rank 0; key is a whitespace free description of the geometry or
+// problem chosen by the caller, value is the rest of the line.
+//
+// Query and Record are collective: rank 0 owns the files and broadcasts the
+// answers so that every rank takes the same decision. Without a directory
+// (--tune-cache) decisions are remembered only for the current run.
+//////////////////////////////////////////////////////////////////////////////
+class GridTuneCache {
+public:
+  static std::string Directory;
+
+  static int Persistent(void) { return !Directory.empty(); }
+  static const std::string &Machine(void);
+
+  static bool Query (const std::string &kernel, const std::string &key, std::string &value);
+  static void Record(const std::string &kernel, const std::string &key, const std::string &value);
+
+private:
+  static std::map<std::string,std::string> &Table(const std::string &kernel);
+  static std::string File(const std::string &kernel);
+};
+
+NAMESPACE_END(Grid);
@@ -3,4 +3,5 @@
 #include <Grid/util/Coordinate.h>
 #include <Grid/util/Lexicographic.h>
 #include <Grid/util/Init.h>
+#include <Grid/util/TuneCache.h>
 #endif
@@ -0,0 +1,180 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./benchmarks/Benchmark_madwf.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Mobius solve three ways: red-black CG on the outer operator, MADWF with a
+// double precision ZMobius inner operator, and MADWF with single precision
+// inner and Pauli-Villars solves and recycled inner solutions.
+//
+//   --Ls n --Ls-inner n --mass m --resid r
+
+typedef SchurRedBlackDiagMooeeSolve<LatticeFermionD> SchurSolverD;
+typedef SchurRedBlackDiagMooeeSolve<LatticeFermionF> SchurSolverF;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  int   Ls_outer = 16;
+  int   Ls_inner = 8;
+  RealD mass     = 0.01;
+  RealD resid    = 1.0e-8;
+  RealD M5       = 1.8;
+  RealD b_plus_c_outer = 2.0;
+  RealD b_plus_c_inner = 1.0;
+  RealD lambda_max     = 1.42;
+
+  std::string arg;
+  if( GridCmdOptionExists(argv,argv+argc,"--Ls") ){
+    arg = GridCmdOptionPayload(argv,argv+argc,"--Ls");  GridCmdOptionInt(arg,Ls_outer);
+  }
+  if( GridCmdOptionExists(argv,argv+argc,"--Ls-inner") ){
+    arg = GridCmdOptionPayload(argv,argv+argc,"--Ls-inner");  GridCmdOptionInt(arg,Ls_inner);
+  }
+  if( GridCmdOptionExists(argv,argv+argc,"--mass") ){
+    float f; arg = GridCmdOptionPayload(argv,argv+argc,"--mass");  GridCmdOptionFloat(arg,f); mass = f;
+  }
+  if( GridCmdOptionExists(argv,argv+argc,"--resid") ){
+    float f; arg = GridCmdOptionPayload(argv,argv+argc,"--resid");  GridCmdOptionFloat(arg,f); resid = f;
+  }
+
+  std::vector<ComplexD> gamma_inner;
+  Approx::computeZmobiusGamma(gamma_inner, b_plus_c_inner, Ls_inner, b_plus_c_outer, Ls_outer, lambda_max);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * UGridF   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGridF = SpaceTimeGrid::makeFourDimRedBlackGrid(UGridF);
+
+  GridCartesian         * FGrid_outer   = SpaceTimeGrid::makeFiveDimGrid(Ls_outer,UGrid);
+  GridRedBlackCartesian * FrbGrid_outer = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_outer,UGrid);
+  GridCartesian         * FGrid_inner   = SpaceTimeGrid::makeFiveDimGrid(Ls_inner,UGrid);
+  GridRedBlackCartesian * FrbGrid_inner = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_inner,UGrid);
+
+  GridCartesian         * FGridF_outer   = SpaceTimeGrid::makeFiveDimGrid(Ls_outer,UGridF);
+  GridRedBlackCartesian * FrbGridF_outer = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_outer,UGridF);
+  GridCartesian         * FGridF_inner   = SpaceTimeGrid::makeFiveDimGrid(Ls_inner,UGridF);
+  GridRedBlackCartesian * FrbGridF_inner = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_inner,UGridF);
+
+  std::vector<int> seeds4({1,2,3,4});
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeFieldD Umu(UGrid);   SU<Nc>::HotConfiguration(RNG4,Umu);
+  LatticeGaugeFieldF UmuF(UGridF); precisionChange(UmuF,Umu);
+  LatticeFermionD src4(UGrid); random(RNG4,src4);
+
+  RealD bmc = 1.0;
+  RealD b_outer = (b_plus_c_outer + bmc)/2.;
+  RealD c_outer = (b_plus_c_outer - bmc)/2.;
+  RealD b_inner = (b_plus_c_inner + bmc)/2.;
+  RealD c_inner = (b_plus_c_inner - bmc)/2.;
+
+  MobiusFermionD  D_outer (Umu ,*FGrid_outer ,*FrbGrid_outer ,*UGrid ,*UrbGrid ,mass,M5,b_outer,c_outer);
+  MobiusFermionF  D_outerF(UmuF,*FGridF_outer,*FrbGridF_outer,*UGridF,*UrbGridF,mass,M5,b_outer,c_outer);
+  ZMobiusFermionD D_inner (Umu ,*FGrid_inner ,*FrbGrid_inner ,*UGrid ,*UrbGrid ,mass,M5,gamma_inner,b_inner,c_inner);
+  ZMobiusFermionF D_innerF(UmuF,*FGridF_inner,*FrbGridF_inner,*UGridF,*UrbGridF,mass,M5,gamma_inner,b_inner,c_inner);
+
+  std::cout << GridLogMessage << "Lattice " << GridDefaultLatt() << " Ls outer " << Ls_outer << " Ls inner " << Ls_inner
+	    << " mass " << mass << std::endl;
+
+  LatticeFermionD src5(FGrid_outer);
+  D_outer.ImportPhysicalFermionSource(src4,src5);
+
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  std::cout << GridLogMessage << "= Red-black CG on the outer operator" << std::endl;
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  LatticeFermionD sol_ref(FGrid_outer); sol_ref = Zero();
+  ConjugateGradient<LatticeFermionD> CG_outer(resid,10000);
+  SchurSolverD SchurSolver_outer(CG_outer);
+  GridStopWatch Timer;
+  Timer.Start();
+  SchurSolver_outer(D_outer,src5,sol_ref);
+  Timer.Stop();
+  auto t_cg = Timer.Elapsed();
+
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  std::cout << GridLogMessage << "= MADWF, double precision inner solves" << std::endl;
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  typedef PauliVillarsSolverRBprec<LatticeFermionD,SchurSolverD> PVtypeD;
+  ConjugateGradient<LatticeFermionD> CG_pv(resid,10000);
+  SchurSolverD SchurSolver_pv(CG_pv);
+  PVtypeD PV_D(SchurSolver_pv);
+
+  RealD resid_inner = 1.0e-4;
+  ConjugateGradient<LatticeFermionD> CG_inner(resid_inner,10000,0);
+  SchurSolverD SchurSolver_inner(CG_inner);
+  ZeroGuesser<LatticeFermionD> GuessD;
+
+  LatticeFermionD sol_D(FGrid_outer); sol_D = Zero();
+  MADWF<MobiusFermionD,ZMobiusFermionD,PVtypeD,SchurSolverD,ZeroGuesser<LatticeFermionD> >
+    madwfD(D_outer,D_inner,PV_D,SchurSolver_inner,GuessD,resid,100);
+  Timer.Reset();
+  Timer.Start();
+  madwfD(src4,sol_D);
+  Timer.Stop();
+  auto t_madwfD = Timer.Elapsed();
+
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  std::cout << GridLogMessage << "= MADWF, single precision inner and PV solves, recycled inner solutions" << std::endl;
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  typedef PauliVillarsSolverMixedPrec<MobiusFermionF,SchurSolverF> PVtypeF;
+  ConjugateGradient<LatticeFermionF> CG_pvF(1.0e-5,10000,0);
+  SchurSolverF SchurSolver_pvF(CG_pvF);
+  PVtypeF PV_F(D_outerF,SchurSolver_pvF,resid);
+
+  ConjugateGradient<LatticeFermionF> CG_innerF(resid_inner,10000,0);
+  SchurSolverF SchurSolver_innerF(CG_innerF);
+  ZeroGuesser<LatticeFermionF> GuessF;
+
+  LatticeFermionD sol_F(FGrid_outer); sol_F = Zero();
+  MADWF<MobiusFermionD,ZMobiusFermionF,PVtypeF,SchurSolverF,ZeroGuesser<LatticeFermionF> >
+    madwfF(D_outer,D_innerF,PV_F,SchurSolver_innerF,GuessF,resid,100);
+  madwfF.SetInnerRecycle(8);
+  Timer.Reset();
+  Timer.Start();
+  madwfF(src4,sol_F);
+  Timer.Stop();
+  auto t_madwfF = Timer.Elapsed();
+
+  LatticeFermionD diff(FGrid_outer);
+  LatticeFermionD sol_ref_o(FrbGrid_outer), sol_o(FrbGrid_outer), diff_o(FrbGrid_outer);
+  pickCheckerboard(Odd,sol_ref_o,sol_ref);
+
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+  std::cout << GridLogMessage << "Red-black CG              " << t_cg << std::endl;
+  pickCheckerboard(Odd,sol_o,sol_D);  diff_o = sol_o - sol_ref_o;
+  std::cout << GridLogMessage << "MADWF double              " << t_madwfD << "  odd parity difference " << std::sqrt(norm2(diff_o)/norm2(sol_ref_o)) << std::endl;
+  pickCheckerboard(Odd,sol_o,sol_F);  diff_o = sol_o - sol_ref_o;
+  std::cout << GridLogMessage << "MADWF single inner and PV " << t_madwfF << "  odd parity difference " << std::sqrt(norm2(diff_o)/norm2(sol_ref_o)) << std::endl;
+  std::cout << GridLogMessage << "==============================================================" << std::endl;
+
+  Grid_finalize();
+}
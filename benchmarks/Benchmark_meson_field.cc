@@ -772,6 +772,28 @@ int main (int argc, char ** argv)
 
 
 
+  std::cout<<GridLogMessage << "Running A2Autils GEMM engine, Sixteen gammas "<<Nmom<<" momenta "<<std::endl;
+  Eigen::Tensor<ComplexD,5> MesonFieldsGemm(Nmom,16,nt,Nm,Nm);
+  flops = vol * ( 8.0 * Nc * Ns * Ns * Nmom) * Nm*Nm;
+  byte  = vol * (12.0 * sizeof(Complex) ) * Nm*Nm
+        + vol * ( 2.0 * sizeof(Complex) *Nmom ) * Nm*Nm* 16;
+  double t_kernel, t_gsum;
+  t0 = usecond();
+  A2Autils<WilsonImplR>::MesonField(MesonFieldsGemm,&w[0],&v[0],Gmu16,phases,Tp,&t_kernel,&t_gsum);
+  t1 = usecond();
+  std::cout<<GridLogMessage << "Done "<< (t1-t0) <<" usecond, GEMM "<< t_kernel <<" usecond" <<std::endl;
+  std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
+  std::cout<<GridLogMessage << "Done "<< byte /(t1-t0) <<" MB/s " <<std::endl;
+
+  std::cout<<GridLogMessage << "Running A2Autils GEMM engine, PionFieldWV"<<std::endl;
+  Eigen::Tensor<ComplexD,3> PionFieldsGemm(nt,Nm,Nm);
+  flops = vol * ( 8.0 * Nc * Ns ) * Nm*Nm;
+  t0 = usecond();
+  A2Autils<WilsonImplR>::PionFieldWV(PionFieldsGemm,&w[0],&v[0],Tp);
+  t1 = usecond();
+  std::cout<<GridLogMessage << "Done "<< (t1-t0) <<" usecond " <<std::endl;
+  std::cout<<GridLogMessage << "Done "<< flops/(t1-t0) <<" mflops " <<std::endl;
+
   RealD err = 0;
   RealD err2 = 0;
   ComplexD diff;
@@ -809,6 +831,26 @@ int main (int argc, char ** argv)
   std::cout << GridLogMessage << "Norm error 16 gamma1/16 gamma naive    " << err << std::endl;
   std::cout << GridLogMessage << "Norm error 16 gamma1/sliceInnerProduct " << err2 << std::endl;
 
+  err = 0;
+  err2 = 0;
+  for (int i = 0; i < Nm; i++){
+    for (int j = 0; j < Nm; j++){
+      for (int t = 0; t < nt; t++){
+	for (int mu = 0; mu < 16; mu++){
+	  for (int m = 0; m < Nmom; m++){
+	    diff = MesonFieldsGemm(m,mu,t,i,j) - MesonFields161[mu+i*16+Nm*16*j][t];
+	    err += real(diff*conj(diff));
+	  }
+	}
+	// Gmu16[0] is Gamma5
+	diff2 = PionFieldsGemm(t,i,j) - MesonFields161[i*16+Nm*16*j][t];
+	err2 += real(diff2*conj(diff2));
+      }
+    }
+  }
+  std::cout << GridLogMessage << "Norm error GEMM meson field/16 gamma1  " << err << std::endl;
+  std::cout << GridLogMessage << "Norm error GEMM pion field/16 gamma1   " << err2 << std::endl;
+
   Grid_finalize();
 }
 
@@ -0,0 +1,100 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./benchmarks/Benchmark_rng.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Engine based (per site std:: distributions, extract/merge) against the
+// counter based vectorised samplers, for the fills used in momentum refresh.
+template<class Field,class Fill>
+double TimeFill(Field &f,GridParallelRNG &rng,Fill fill,int Nloop)
+{
+  fill(rng,f);
+  double start=usecond();
+  for(int i=0;i<Nloop;i++) fill(rng,f);
+  double stop=usecond();
+  return (stop-start)/Nloop/1000.0; // ms
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#define LMAX (32)
+#define LMIN (8)
+#define LADD (8)
+
+  int Nloop=10;
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  std::vector<int> seeds({45,12,81,9});
+
+  int threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  auto gauss = [](GridParallelRNG &rng,LatticeColourMatrix &f){ gaussian(rng,f); };
+  auto unif  = [](GridParallelRNG &rng,LatticeColourMatrix &f){ random(rng,f); };
+  auto mom   = [](GridParallelRNG &rng,LatticeColourMatrix &f){ SU<Nc>::GaussianFundamentalLieAlgebraMatrix(rng,f); };
+
+  std::vector<std::string> names({"gaussian","uniform","Lie algebra momentum"});
+
+  for(int t=0;t<names.size();t++){
+    std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+    std::cout<<GridLogMessage << "= Benchmarking "<<names[t]<<" LatticeColourMatrix fill"<<std::endl;
+    std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+    std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"engine ms"<<"\t"<<"counter ms"<<"\t"<<"speedup"<<"\t\t"<<"Mrandoms/s (counter)"<<std::endl;
+    std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+
+    for(int lat=LMIN;lat<=LMAX;lat+=LADD){
+
+      Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+      int64_t vol = latt_size[0]*latt_size[1]*latt_size[2]*latt_size[3];
+      GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+
+      GridRNGbase::UseCounterBased=0;
+      GridParallelRNG   engineRNG(&Grid);  engineRNG.SeedFixedIntegers(seeds);
+      GridRNGbase::UseCounterBased=1;
+      GridParallelRNG   counterRNG(&Grid); counterRNG.SeedFixedIntegers(seeds);
+      GridRNGbase::UseCounterBased=0;
+
+      LatticeColourMatrix f(&Grid);
+
+      double te,tc;
+      double nrand = 2.0*Nc*Nc*vol;
+      if ( t==0 ) { te = TimeFill(f,engineRNG,gauss,Nloop); tc = TimeFill(f,counterRNG,gauss,Nloop); }
+      if ( t==1 ) { te = TimeFill(f,engineRNG,unif ,Nloop); tc = TimeFill(f,counterRNG,unif ,Nloop); }
+      if ( t==2 ) { te = TimeFill(f,engineRNG,mom  ,Nloop); tc = TimeFill(f,counterRNG,mom  ,Nloop); nrand = (Nc*Nc-1.0)*vol; }
+
+      std::cout<<GridLogMessage<<std::setprecision(3) << lat<<"\t\t"<<te<<"\t\t"<<tc<<"\t\t"<<te/tc<<"\t\t"<<nrand/tc/1000.0<<std::endl;
+    }
+  }
+
+  Grid_finalize();
+}
@@ -108,5 +108,30 @@ int main (int argc, char ** argv)
   std::cout<<GridLogMessage << "norm result "<< norm2(result)<<std::endl;
   std::cout<<GridLogMessage << "mflop/s =   "<< flops/(t1-t0)<<std::endl;
 
+  ////////////////////////////////////////////////////////////
+  // Multi-shift CG on the even-odd operator, as in the RHMC
+  ////////////////////////////////////////////////////////////
+  int nshift=12;
+  MultiShiftFunction Shifts(nshift,0.0,1.0);
+  Shifts.order=nshift;
+  Shifts.norm=0.0;
+  Shifts.tolerances.resize(nshift,1.0e-8);
+  for(int s=0;s<nshift;s++){
+    Shifts.poles[s]   = 1.0e-4*std::pow(3.0,s);
+    Shifts.residues[s]= 1.0;
+  }
+
+  SchurStaggeredOperator<ImprovedStaggeredFermionR,FermionField> HermOpEO(Ds);
+  FermionField src_o(&RBGrid); pickCheckerboard(Odd,src_o,src);
+  std::vector<FermionField> psi(nshift,&RBGrid);
+  ConjugateGradientMultiShift<FermionField> MSCG(10000,Shifts);
+
+  double t2=usecond();
+  MSCG(HermOpEO,src_o,psi);
+  double t3=usecond();
+  std::cout<<GridLogMessage << "Multishift "<<nshift<<" poles : "<<MSCG.IterationsToComplete<<" iterations"<<std::endl;
+  std::cout<<GridLogMessage << "Multishift usec          =   "<< (t3-t2)<<std::endl;
+  std::cout<<GridLogMessage << "Multishift usec/iteration =  "<< (t3-t2)/MSCG.IterationsToComplete<<std::endl;
+
   Grid_finalize();
 }
@@ -258,5 +258,45 @@ int main (int argc, char ** argv)
   assert(fabs(err0) < 1.0e-3);
   assert(fabs(err1) < 1.0e-3);
 
+  ////////////////////////////////////////////////////////////////////
+  // Compressed links: two rows and a phase per link (14 reals, not 18)
+  // against full links, on an SU(3) field
+  ////////////////////////////////////////////////////////////////////
+  if ( Nc == 3 ) {
+    LatticeGaugeField Usu3(&Grid);
+    SU<Nc>::HotConfiguration(pRNG,Usu3);
+
+    typename WilsonFermionCompressedR::ImplParams cparams;
+    WilsonFermionR           Dfull(Usu3,Grid,RBGrid,mass,params);
+    WilsonFermionCompressedR Dcomp(Usu3,Grid,RBGrid,mass,cparams);
+
+    LatticeFermion rfull(&Grid);
+    LatticeFermion rcomp(&Grid);
+
+    Grid.Barrier();
+    double tf0=usecond();
+    for(int i=0;i<ncall;i++){
+      Dfull.Dhop(src,rfull,0);
+    }
+    Grid.Barrier();
+    double tf1=usecond();
+    for(int i=0;i<ncall;i++){
+      Dcomp.Dhop(src,rcomp,0);
+    }
+    Grid.Barrier();
+    double tc1=usecond();
+
+    double gauge_full = volume * 2*Nd*Nc*Nc       * simdwidth / nsimd * ncall / (1024.*1024.*1024.);
+    double gauge_comp = volume * 2*Nd*(2*Nc+1)   * simdwidth / nsimd * ncall / (1024.*1024.*1024.);
+    err = rfull-rcomp;
+    std::cout<<GridLogMessage << "Full links       mflop/s = "<< flops/(tf1-tf0)
+	     << " gauge GiB/s = "<< 1000000. * gauge_full/(tf1-tf0) <<std::endl;
+    std::cout<<GridLogMessage << "Compressed links mflop/s = "<< flops/(tc1-tf1)
+	     << " gauge GiB/s = "<< 1000000. * gauge_comp/(tc1-tf1) <<std::endl;
+    std::cout<<GridLogMessage << "Compressed link speedup  = "<< (tf1-tf0)/(tc1-tf1) <<std::endl;
+    std::cout<<GridLogMessage << "Compressed link norm diff "<< norm2(err) << " / " << norm2(rfull) <<std::endl;
+    assert(norm2(err) < 1.0e-10*norm2(rfull));
+  }
+
   Grid_finalize();
 }
@@ -118,5 +118,46 @@ int main (int argc, char ** argv)
     }
   }
 
+  ////////////////////////////////////////////////////////////
+  // All nearest neighbour shifts with one halo exchange
+  ////////////////////////////////////////////////////////////
+  std::vector<std::pair<int,int> > shifts;
+  for(int dir=0;dir<4;dir++){
+    shifts.push_back(std::make_pair(dir,+1));
+    shifts.push_back(std::make_pair(dir,-1));
+  }
+  shifts.push_back(std::make_pair(0,2));
+  shifts.push_back(std::make_pair(3,-latt_size[3]/2-1));
+
+  int nshift = shifts.size();
+  std::vector<LatticeComplex> ShiftMany(nshift,&Fine);
+  CshiftMany(U,shifts,ShiftMany);
+  for(int p=0;p<nshift;p++){
+    ShiftU = Cshift(U,shifts[p].first,shifts[p].second) - ShiftMany[p];
+    std::cout<<GridLogMessage<<"CshiftMany dir "<<shifts[p].first<<" shift "<<shifts[p].second
+	     <<" N2diff "<<norm2(ShiftU)<<std::endl;
+    assert(norm2(ShiftU)==0.0);
+  }
+
+  int ncall = 10;
+  double t0 = usecond();
+  for(int i=0;i<ncall;i++) CshiftMany(U,shifts,ShiftMany);
+  double t1 = usecond();
+  for(int i=0;i<ncall;i++){
+    for(int p=0;p<nshift;p++) ShiftMany[p] = Cshift(U,shifts[p].first,shifts[p].second);
+  }
+  double t2 = usecond();
+  std::cout<<GridLogMessage<<nshift<<" shifts: CshiftMany "<<(t1-t0)/ncall<<" us, Cshift "<<(t2-t1)/ncall<<" us"<<std::endl;
+
+  GridRedBlackCartesian RBFine(&Fine);
+  LatticeComplex Ueo(&RBFine), Deo(&RBFine);
+  pickCheckerboard(Odd,Ueo,U);
+  std::vector<LatticeComplex> ShiftEo(2,&RBFine);
+  CshiftMany(Ueo,{{1,+1},{2,-1}},ShiftEo);
+  Deo = Cshift(Ueo,1,+1) - ShiftEo[0];
+  assert(norm2(Deo)==0.0);
+  Deo = Cshift(Ueo,2,-1) - ShiftEo[1];
+  assert(norm2(Deo)==0.0);
+
   Grid_finalize();
 }
@@ -0,0 +1,143 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/Test_general_stencil_comms.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/stencil/GeneralLocalStencil.h>
+
+// A single rank only exercises the local copies. Run also on several ranks,
+// with rank counts that put neighbours both on and off node, e.g.
+//
+//   mpirun -np 2 ./Test_general_stencil_comms --grid 8.8.8.8  --mpi 1.1.1.2
+//   mpirun -np 4 ./Test_general_stencil_comms --grid 8.8.8.8  --mpi 1.1.2.2
+//   mpirun -np 6 ./Test_general_stencil_comms --grid 8.8.6.8  --mpi 1.1.3.2
+//   mpirun -np 8 ./Test_general_stencil_comms --grid 16.8.8.8 --mpi 2.2.2.1
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+void StencilShift(GeneralStencil<typename Field::vector_object> &st,int point,const Field &in,Field &out)
+{
+  st.HaloExchange(in);
+  autoView( st_v , st, AcceleratorRead);
+  autoView( in_v , in, AcceleratorRead);
+  autoView( out_v, out, AcceleratorWrite);
+  accelerator_for(ss, in.Grid()->oSites(), Field::vector_object::Nsimd(), {
+    auto SE = st_v.GetEntry(point,ss);
+    if ( SE->_is_local ) coalescedWrite(out_v[ss],coalescedReadGeneralPermute(in_v[SE->_offset],SE->_permute));
+    else                 coalescedWrite(out_v[ss],coalescedRead(st_v.CommBuf()[SE->_offset]));
+  });
+}
+
+int main(int argc, char ** argv) 
+{
+  Grid_init(&argc, &argv);
+
+  auto latt_size   = GridDefaultLatt();
+  auto simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  auto mpi_layout  = GridDefaultMpi();
+
+  GridCartesian Fine(latt_size,simd_layout,mpi_layout);
+  GridParallelRNG fRNG(&Fine);
+  std::vector<int> seeds({1,2,3,4});
+  fRNG.SeedFixedIntegers(seeds);
+
+  ////////////////////////////////////////////////////////////////
+  // Diagonal and long range shifts against chains of Cshift
+  ////////////////////////////////////////////////////////////////
+  std::vector<Coordinate> shifts({
+      Coordinate({ 1, 0, 0, 0}),
+      Coordinate({ 0, 0, 0,-1}),
+      Coordinate({ 1, 1, 0, 0}),
+      Coordinate({-1, 0, 1, 0}),
+      Coordinate({ 1,-1, 1,-1}),
+      Coordinate({ 2, 0,-2, 1}),
+      Coordinate({ 0,-3, 0, 5}),
+      Coordinate({ latt_size[0]/2+1, 0, 0, -latt_size[3]/2-1})
+    });
+
+  GeneralStencil<vColourMatrix> gStencil(&Fine,shifts);
+
+  LatticeColourMatrix Foo(&Fine), Bar(&Fine), Check(&Fine), Diff(&Fine);
+  random(fRNG,Foo);
+
+  for(int point=0;point<shifts.size();point++){
+    Bar = Foo;
+    for(int d=0;d<Nd;d++) if ( shifts[point][d] ) Bar = Cshift(Bar,d,shifts[point][d]);
+    StencilShift(gStencil,point,Foo,Check);
+    Diff = Check - Bar;
+    std::cout << GridLogMessage << "shift " << shifts[point] << " N2diff " << norm2(Diff) << std::endl;
+    assert(norm2(Diff) == 0.0);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Fused plaquette kernel from one exchange of the gauge field
+  ////////////////////////////////////////////////////////////////
+  LatticeGaugeField Umu(&Fine);
+  SU<Nc>::HotConfiguration(fRNG,Umu);
+
+  std::vector<Coordinate> hops;
+  for(int mu=0;mu<Nd;mu++){
+    Coordinate shift(Nd,0);
+    shift[mu]=1;
+    hops.push_back(shift);
+  }
+  GeneralStencil<vLorentzColourMatrix> hStencil(&Fine,hops);
+  hStencil.HaloExchange(Umu);
+
+  LatticeComplex plaq(&Fine);
+  {
+    autoView( st_v  , hStencil, AcceleratorRead);
+    autoView( U_v   , Umu, AcceleratorRead);
+    autoView( plaq_v, plaq, AcceleratorWrite);
+    accelerator_for(ss, Fine.oSites(), vComplex::Nsimd(), {
+      typedef decltype(coalescedRead(U_v[0])) calcLink;
+      calcLink Ufwd[Nd];
+      for(int mu=0;mu<Nd;mu++){
+	auto SE = st_v.GetEntry(mu,ss);
+	if ( SE->_is_local ) Ufwd[mu] = coalescedReadGeneralPermute(U_v[SE->_offset],SE->_permute);
+	else                 Ufwd[mu] = coalescedRead(st_v.CommBuf()[SE->_offset]);
+      }
+      typedef decltype(coalescedRead(plaq_v[0])) calcComplex;
+      auto U = coalescedRead(U_v[ss]);
+      calcComplex sum;
+      sum = Zero();
+      for(int mu=1;mu<Nd;mu++){
+	for(int nu=0;nu<mu;nu++){
+	  sum() = sum() + trace(U(mu)*Ufwd[mu](nu)*adj(Ufwd[nu](mu))*adj(U(nu)));
+	}
+      }
+      coalescedWrite(plaq_v[ss],sum);
+    });
+  }
+  RealD stencil_plaq = real(TensorRemove(sum(plaq)))/(Fine.gSites()*Nc*Nd*(Nd-1)/2);
+  RealD wilson_plaq  = WilsonLoops<PeriodicGimplR>::avgPlaquette(Umu);
+  std::cout << GridLogMessage << "Plaquette stencil " << stencil_plaq << " WilsonLoops " << wilson_plaq << std::endl;
+  assert(fabs(stencil_plaq-wilson_plaq) < 1.0e-12);
+
+  Grid_finalize();
+}
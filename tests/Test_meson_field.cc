@@ -140,6 +140,35 @@ int main(int argc, char *argv[])
   write(w,"phi_rho",Mpr);
   write(w,"rho_rho",Mrr);
 
+#ifdef HAVE_HDF5
+  // stream M(phi,rho) tile by tile through the background writer and read it back
+  {
+    const int Lblock = 2;
+    const int Rblock = 3;
+    std::string StreamName = "Meson_Fields_stream.h5";
+    start = usecond();
+    {
+      A2AMesonFieldHdf5Writer sw(StreamName,"phi_rho",momenta.size(),Gmu.size(),Nt,VDIM,VDIM,Lblock,Rblock);
+      A2AMesonFieldStream<WilsonImplR>(sw,&phi[0],VDIM,&rho[0],VDIM,Lblock,Rblock,Gmu,phases,Tp);
+      sw.flush();
+    }
+    stop = usecond();
+    std::cout << GridLogMessage << "M(phi,rho) streamed, execution time " << stop-start << " us" << std::endl;
+
+    if ( grid.IsBoss() ) {
+      Hdf5Reader r(StreamName);
+      std::vector<ComplexD> buf;
+      std::vector<size_t>   dim;
+      r.readMultiDim("phi_rho",buf,dim);
+      assert(buf.size() == (size_t)Mpr.size());
+      RealD err = 0.0;
+      for(size_t n=0;n<buf.size();n++) err += norm(buf[n]-Mpr.data()[n]);
+      std::cout << GridLogMessage << "Streamed/in memory M(phi,rho) difference " << err << std::endl;
+      assert(err < 1.0e-20);
+    }
+  }
+#endif
+
   // epilogue
   std::cout << GridLogMessage << "Grid is finalizing now" << std::endl;
   Grid_finalize();
@@ -0,0 +1,105 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_baryon_batched.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/qcd/utils/BaryonUtils.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef BaryonUtils<WilsonImplR> Baryons;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian Grid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  LatticePropagator qU(&Grid); random(pRNG,qU);
+  LatticePropagator qD(&Grid); random(pRNG,qD);
+  LatticePropagator qS(&Grid); random(pRNG,qS);
+
+  // Nucleon, Lambda-like and Delta-like interpolators for several flavour patterns
+  Gamma C(Gamma::Algebra::SigmaXZ);
+  Gamma g5(Gamma::Algebra::Gamma5);
+  Gamma gT(Gamma::Algebra::GammaT);
+  Gamma gX(Gamma::Algebra::GammaX);
+  Gamma id(Gamma::Algebra::Identity);
+  Gamma Cg5 = C*g5;
+  Gamma CgX = C*gX;
+
+  std::vector<std::string> flavours_i({"udu","uds","sud","dus"});
+  std::vector<std::string> flavours_f({"udu","uds","dus","sud"});
+
+  std::vector<Baryons::BaryonContraction> contractions;
+  std::vector<std::vector<Gamma> > gammas({{id,Cg5},{gT,Cg5},{id,CgX}});
+  for(auto &G : gammas){
+    for(int parity=-1;parity<=1;parity+=2){
+      for(int f=0;f<flavours_i.size();f++){
+	int wick;
+	Baryons::WickContractions(flavours_i[f],flavours_f[f],wick);
+	contractions.push_back({G[0],G[1],G[0],G[1],wick,parity});
+      }
+    }
+  }
+  std::cout << GridLogMessage << "Batch of " << contractions.size() << " baryon contractions" << std::endl;
+
+  double t0 = usecond();
+  std::vector<std::vector<ComplexD> > batched;
+  Baryons::ContractBaryonsBatched(qU,qD,qS,contractions,batched,Tp);
+  double t1 = usecond();
+
+  RealD err = 0.0;
+  RealD nrm = 0.0;
+  LatticeComplex corr(&Grid);
+  std::vector<TComplex> sliced;
+  for(int n=0;n<contractions.size();n++){
+    auto &c = contractions[n];
+    Baryons::ContractBaryons(qU,qD,qS,c.GammaA_left,c.GammaB_left,c.GammaA_right,c.GammaB_right,
+			     c.wick_contractions,c.parity,corr);
+    sliceSum(corr,sliced,Tp);
+    for(int t=0;t<sliced.size();t++){
+      ComplexD ref = TensorRemove(sliced[t]);
+      err += norm(batched[n][t]-ref);
+      nrm += norm(ref);
+    }
+  }
+  double t2 = usecond();
+
+  std::cout << GridLogMessage << "Batched    " << t1-t0 << " us" << std::endl;
+  std::cout << GridLogMessage << "One by one " << t2-t1 << " us" << std::endl;
+  std::cout << GridLogMessage << "Relative difference " << std::sqrt(err/nrm) << std::endl;
+  assert(std::sqrt(err/nrm) < 1.0e-10);
+
+  Grid_finalize();
+}
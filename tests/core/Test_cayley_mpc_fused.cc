@@ -0,0 +1,132 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_cayley_mpc_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Action>
+void TestFused(Action &D,GridParallelRNG &RNG5,GridRedBlackCartesian *FrbGrid,GridCartesian *FGrid,std::string name)
+{
+  typedef typename Action::FermionField FermionField;
+
+  FermionField src(FGrid);  random(RNG5,src);
+  FermionField src_o(FrbGrid), ref(FrbGrid), res(FrbGrid), diff(FrbGrid);
+
+  SchurDiagMooeeOperator<Action,FermionField>      HermOp(D);
+  SchurDiagMooeeFusedOperator<Action,FermionField> HermOpFused(D);
+
+  for(int cb=0;cb<2;cb++){
+    pickCheckerboard(cb ? Odd : Even,src_o,src);
+
+    HermOp.Mpc(src_o,ref);
+    HermOpFused.Mpc(src_o,res);
+    diff = ref-res;
+    std::cout<<GridLogMessage<<name<<" cb "<<cb<<" Mpc    fused vs reference "<<norm2(diff)/norm2(ref)<<std::endl;
+    assert(res.Checkerboard()==ref.Checkerboard());
+    assert(norm2(diff)/norm2(ref) < 1.0e-24);
+
+    HermOp.MpcDag(src_o,ref);
+    HermOpFused.MpcDag(src_o,res);
+    diff = ref-res;
+    std::cout<<GridLogMessage<<name<<" cb "<<cb<<" MpcDag fused vs reference "<<norm2(diff)/norm2(ref)<<std::endl;
+    assert(norm2(diff)/norm2(ref) < 1.0e-24);
+  }
+
+  // Same Krylov operator
+  RealD n1,n2;
+  HermOp.HermOpAndNorm(src_o,ref,n1,n2);
+  HermOpFused.HermOpAndNorm(src_o,res,n1,n2);
+  diff = ref-res;
+  assert(norm2(diff)/norm2(ref) < 1.0e-24);
+
+  // Red-black solve on the fused operator against CG on the unfused one
+  {
+    FermionField sol(FGrid), sol_o(FrbGrid), src_e(FrbGrid), src_oo(FrbGrid), ref_o(FrbGrid);
+    ConjugateGradient<FermionField> CG(1.0e-10,10000);
+    SchurRedBlackDiagMooeeFusedSolve<FermionField> SchurSolver(CG);
+    sol = Zero();
+    SchurSolver(D,src,sol);
+    pickCheckerboard(Odd,sol_o,sol);
+
+    SchurSolver.RedBlackSource(D,src,src_e,src_oo);
+    ref_o = Zero();
+    CG(HermOp,src_oo,ref_o);
+    diff = sol_o-ref_o;
+    std::cout<<GridLogMessage<<name<<" red-black solve fused vs reference "<<norm2(diff)/norm2(ref_o)<<std::endl;
+    assert(norm2(diff)/norm2(ref_o) < 1.0e-16);
+  }
+
+  int ncall=10;
+  RealD t0=usecond();
+  for(int i=0;i<ncall;i++) HermOp.HermOp(src_o,ref);
+  RealD t1=usecond();
+  for(int i=0;i<ncall;i++) HermOpFused.HermOp(src_o,res);
+  RealD t2=usecond();
+  std::cout<<GridLogMessage<<name<<" MpcDagMpc "<<(t1-t0)/ncall<<" us, fused "<<(t2-t1)/ncall<<" us"<<std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  DomainWallFermionR Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  TestFused(Ddwf,RNG5,FrbGrid,FGrid,"DomainWall");
+
+  MobiusFermionR Dmob(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,1.5,0.5);
+  TestFused(Dmob,RNG5,FrbGrid,FGrid,"Mobius");
+
+  std::vector<ComplexD> omegas;
+  for(int i=0;i<Ls;i++){
+    RealD im = (i==0) ? 0.05 : ((i==Ls-1) ? -0.05 : 0.0);
+    omegas.push_back(ComplexD(0.25+0.1*i,im));
+  }
+  ZMobiusFermionR Dzmob(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,omegas,1.0,0.0);
+  TestFused(Dzmob,RNG5,FrbGrid,FGrid,"ZMobius");
+
+  Dmob.CayleyReport();
+
+  std::cout<<GridLogMessage<<"Test_cayley_mpc_fused passed"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,148 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_dslash_tune.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG pRNG4(UGrid); pRNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG pRNG5(FGrid); pRNG5.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(pRNG4,Umu);
+
+  // fresh cache in a temporary directory made by rank 0, which does the tuning I/O
+  char tmpdir[64] = "/tmp/Test_dslash_tune.XXXXXX";
+  if ( UGrid->IsBoss() ) assert(mkdtemp(tmpdir) != NULL);
+  UGrid->Broadcast(0,(void *)tmpdir,sizeof(tmpdir));
+  GridTuneCache::Directory = tmpdir;
+  std::string WilsonDb = GridTuneCache::Directory + "/WilsonDhop.db";
+  std::string TestDb   = GridTuneCache::Directory + "/TestKernel.db";
+
+  RealD mass=0.1, M5=1.8;
+  LatticeFermion src4(UGrid); random(pRNG4,src4);
+  LatticeFermion ref4(UGrid), res4(UGrid), err4(UGrid);
+  LatticeFermion src5(FGrid); random(pRNG5,src5);
+  LatticeFermion ref5(FGrid), res5(FGrid), err5(FGrid);
+
+  ////////////////////////////////////////////////////
+  // Untuned reference with the global settings
+  ////////////////////////////////////////////////////
+  WilsonKernelsTuner::Enabled = 0;
+  {
+    WilsonFermionD     Dw (Umu,*UGrid,*UrbGrid,mass);
+    DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    Dw.Dhop(src4,ref4,DaggerNo);
+    Ddwf.Dhop(src5,ref5,DaggerNo);
+  }
+
+  ////////////////////////////////////////////////////
+  // Tuned on first use, recorded, and the same answer
+  ////////////////////////////////////////////////////
+  WilsonKernelsTuner::Enabled = 1;
+  {
+    WilsonFermionD     Dw (Umu,*UGrid,*UrbGrid,mass);
+    DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    Dw.ZeroCounters();
+    Ddwf.ZeroCounters();
+    RealD tune4=0, tune5=0;
+    for(int i=0;i<2;i++){
+      if (i==0) tune4 -= usecond();
+      Dw.Dhop(src4,res4,DaggerNo);
+      if (i==0) tune4 += usecond();
+      if (i==0) tune5 -= usecond();
+      Ddwf.Dhop(src5,res5,DaggerNo);
+      if (i==0) tune5 += usecond();
+    }
+    // the tuning sweeps in the first call are not charged to the Dhop timers
+    std::cout << GridLogMessage << "4d first call " << tune4 << " us, Dhop timer " << Dw.DhopTotalTime << " us" << std::endl;
+    std::cout << GridLogMessage << "5d first call " << tune5 << " us, Dhop timer " << Ddwf.DhopTotalTime << " us" << std::endl;
+    assert(Dw.DhopTotalTime < 0.5*tune4);
+    assert(Ddwf.DhopTotalTime < 0.5*tune5);
+    assert(Dw.DhopComputeTime <= Dw.DhopTotalTime);
+    assert(Ddwf.DhopComputeTime <= Ddwf.DhopTotalTime);
+    err4 = ref4-res4;
+    err5 = ref5-res5;
+    std::cout << GridLogMessage << "4d tuned - untuned " << norm2(err4) << std::endl;
+    std::cout << GridLogMessage << "5d tuned - untuned " << norm2(err5) << std::endl;
+    assert(norm2(err4) < 1.0e-24*norm2(ref4));
+    assert(norm2(err5) < 1.0e-24*norm2(ref5));
+  }
+
+  // one entry per operator geometry
+  std::string key4 = WilsonKernelsTuner::Key(std::string("WilsonFermion.")+typeid(WilsonImplD).name(),UGrid,1);
+  std::string key5 = WilsonKernelsTuner::Key(std::string("WilsonFermion5D.")+typeid(WilsonImplD).name(),FGrid,Ls);
+  WilsonKernelsChoice choice4, choice5;
+  assert(WilsonKernelsTuner::Lookup(key4,choice4));
+  assert(WilsonKernelsTuner::Lookup(key5,choice5));
+  std::cout << GridLogMessage << key4 << " : Opt " << choice4.Opt << " Comms " << choice4.Comms << std::endl;
+  std::cout << GridLogMessage << key5 << " : Opt " << choice5.Opt << " Comms " << choice5.Comms << std::endl;
+
+  ////////////////////////////////////////////////////
+  // A new operator on the same geometry uses the database
+  ////////////////////////////////////////////////////
+  {
+    WilsonFermionD Dw (Umu,*UGrid,*UrbGrid,mass);
+    Dw.Dhop(src4,res4,DaggerNo);
+    err4 = ref4-res4;
+    assert(norm2(err4) < 1.0e-24*norm2(ref4));
+  }
+  int lines=0;
+  std::ifstream db(WilsonDb);
+  std::string line;
+  while(std::getline(db,line)) lines++;
+  std::cout << GridLogMessage << "Database entries " << lines << std::endl;
+  if ( UGrid->IsBoss() ) assert(lines == 2);
+
+  ////////////////////////////////////////////////////
+  // Generic query/record for other kernels
+  ////////////////////////////////////////////////////
+  std::string value;
+  assert(!GridTuneCache::Query("TestKernel","n16",value));
+  GridTuneCache::Record("TestKernel","n16","block 4");
+  assert(GridTuneCache::Query("TestKernel","n16",value));
+  assert(value == "block 4");
+  UGrid->Barrier();
+  if ( UGrid->IsBoss() ) {
+    std::remove(WilsonDb.c_str());
+    std::remove(TestDb.c_str());
+    std::remove(tmpdir);
+  }
+
+  std::cout << GridLogMessage << "Test_dslash_tune passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,209 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_dwf_layout.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef LatticeFermionD FermionField;
+
+// Apply a half checkerboard operation in both layouts and compare on the usual 5d grid
+template<class Action4d,class ActionVec,class Op>
+void CompareCb(Action4d &D,ActionVec &sD,const FermionField &src,GridRedBlackCartesian *FrbGrid,GridRedBlackCartesian *sFrbGrid,
+	       GridCartesian *sFGrid,std::string name,Op op)
+{
+  FermionField ssrc(sFGrid);  localConvert(src,ssrc);
+  FermionField ref(src.Grid()), res(src.Grid()), sres(sFGrid), diff(src.Grid());
+  FermionField in(FrbGrid),  out(FrbGrid);
+  FermionField sin(sFrbGrid),sout(sFrbGrid);
+  for(int cb=0;cb<2;cb++){
+    ref = Zero(); sres = Zero();
+    pickCheckerboard(cb ? Odd : Even,in,src);
+    pickCheckerboard(cb ? Odd : Even,sin,ssrc);
+    op(D,in,out);
+    op(sD,sin,sout);
+    setCheckerboard(ref,out);
+    setCheckerboard(sres,sout);
+    localConvert(sres,res);
+    diff = ref-res;
+    std::cout<<GridLogMessage<<name<<" cb "<<cb<<" Ls vectorised vs 4d "<<norm2(diff)/norm2(ref)<<std::endl;
+    assert(norm2(diff)/norm2(ref) < 1.0e-24);
+  }
+}
+
+template<class Action4d,class ActionVec>
+void CompareLayouts(Action4d &D,ActionVec &sD,GridParallelRNG &RNG5,
+		    GridCartesian *FGrid,GridRedBlackCartesian *FrbGrid,
+		    GridCartesian *sFGrid,GridRedBlackCartesian *sFrbGrid,std::string name)
+{
+  FermionField src(FGrid);  random(RNG5,src);
+  FermionField ssrc(sFGrid);  localConvert(src,ssrc);
+  FermionField ref(FGrid), res(FGrid), sres(sFGrid), diff(FGrid);
+
+  D.M(src,ref);  sD.M(ssrc,sres);  localConvert(sres,res);
+  diff = ref-res;
+  std::cout<<GridLogMessage<<name<<" M    Ls vectorised vs 4d "<<norm2(diff)/norm2(ref)<<std::endl;
+  assert(norm2(diff)/norm2(ref) < 1.0e-24);
+
+  D.Mdag(src,ref);  sD.Mdag(ssrc,sres);  localConvert(sres,res);
+  diff = ref-res;
+  std::cout<<GridLogMessage<<name<<" Mdag Ls vectorised vs 4d "<<norm2(diff)/norm2(ref)<<std::endl;
+  assert(norm2(diff)/norm2(ref) < 1.0e-24);
+
+  // Link multiplication of a 5d field; the 4d layout reference goes slice by slice
+  FermionField src4(D.Umu.Grid()), ref4(D.Umu.Grid());
+  for(int mu=0;mu<2*Nd;mu++){
+    for(int s=0;s<FGrid->_fdimensions[0];s++){
+      ExtractSlice(src4,src,s,0);
+      D.multLinkField(ref4,D.Umu,src4,mu);
+      InsertSlice(ref4,ref,s,0);
+    }
+    sD.multLinkField(sres,sD.Umu,ssrc,mu);  localConvert(sres,res);
+    diff = ref-res;
+    assert(norm2(diff)/norm2(ref) < 1.0e-24);
+  }
+  std::cout<<GridLogMessage<<name<<" multLinkField Ls vectorised vs 4d agree"<<std::endl;
+
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" Meooe      ",[](auto &Op,const FermionField &i,FermionField &o){ Op.Meooe(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" MeooeDag   ",[](auto &Op,const FermionField &i,FermionField &o){ Op.MeooeDag(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" Mooee      ",[](auto &Op,const FermionField &i,FermionField &o){ Op.Mooee(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" MooeeDag   ",[](auto &Op,const FermionField &i,FermionField &o){ Op.MooeeDag(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" MooeeInv   ",[](auto &Op,const FermionField &i,FermionField &o){ Op.MooeeInv(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" MooeeInvDag",[](auto &Op,const FermionField &i,FermionField &o){ Op.MooeeInvDag(i,o); });
+  CompareCb(D,sD,src,FrbGrid,sFrbGrid,sFGrid,name+" MpcFused   ",[](auto &Op,const FermionField &i,FermionField &o){ Op.MpcFused(i,o); });
+}
+
+// Schur solve through the factory in the given layout; returns the solution on the usual 5d grid
+template<class Factory>
+void FactorySolve(Factory &factory,LatticeGaugeFieldD &Umu,const FermionField &src,FermionField &sol,RealD mass,RealD M5)
+{
+  auto *D = factory.Create(Umu,mass,M5);
+  typedef typename Factory::Operator Operator;
+
+  GridCartesian         *OpFGrid   = factory.OperatorGrid();
+  FermionField opsrc(OpFGrid), opsol(OpFGrid);
+  factory.ImportFermion(src,opsrc);
+
+  ConjugateGradient<FermionField> CG(1.0e-10,10000);
+  SchurRedBlackDiagMooeeSolve<FermionField> SchurSolver(CG);
+  SchurSolver(*D,opsrc,opsol);
+  factory.ExportFermion(opsol,sol);
+
+  FermionField check(OpFGrid), diff(OpFGrid);
+  D->M(opsol,check);
+  diff = check-opsrc;
+  std::cout<<GridLogMessage<<"layout "<<DomainWallLayout::Name(factory.Layout())<<" true residual "<<std::sqrt(norm2(diff)/norm2(opsrc))<<std::endl;
+  assert(std::sqrt(norm2(diff)/norm2(opsrc)) < 1.0e-8);
+  delete D;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  const int nsimd=vComplexD::Nsimd();
+  auto latt4 = GridDefaultLatt();
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(latt4, GridDefaultSimd(Nd,nsimd),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  if ( (nsimd==1) || (Ls%nsimd) ) {
+    std::cout<<GridLogMessage<<"Ls="<<Ls<<" is not vectorisable with Nsimd="<<nsimd<<"; nothing to test"<<std::endl;
+    Grid_finalize();
+    return 0;
+  }
+
+  GridCartesian         * sUGrid   = SpaceTimeGrid::makeFourDimDWFGrid(latt4,GridDefaultMpi());
+  GridRedBlackCartesian * sUrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(sUGrid);
+  GridCartesian         * sFGrid   = SpaceTimeGrid::makeFiveDimDWFGrid(Ls,UGrid);
+  GridRedBlackCartesian * sFrbGrid = SpaceTimeGrid::makeFiveDimDWFRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeFieldD Umu(UGrid); SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Ls vectorised operators agree with the 4d layout"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  DomainWallFermionD      Ddwf (Umu,*FGrid ,*FrbGrid ,*UGrid ,*UrbGrid ,mass,M5);
+  DomainWallFermionVec5dD sDdwf(Umu,*sFGrid,*sFrbGrid,*sUGrid,*sUrbGrid,mass,M5);
+  CompareLayouts(Ddwf,sDdwf,RNG5,FGrid,FrbGrid,sFGrid,sFrbGrid,"DomainWall");
+
+  RealD b=1.5, c=0.5;
+  MobiusFermionD      Dmob (Umu,*FGrid ,*FrbGrid ,*UGrid ,*UrbGrid ,mass,M5,b,c);
+  MobiusFermionVec5dD sDmob(Umu,*sFGrid,*sFrbGrid,*sUGrid,*sUrbGrid,mass,M5,b,c);
+  CompareLayouts(Dmob,sDmob,RNG5,FGrid,FrbGrid,sFGrid,sFrbGrid,"Mobius");
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Automatic choice follows the reduced local extents"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    int rmin = 1<<30;
+    for(int d=0;d<Nd;d++) if ( UGrid->_simd_layout[d]>1 ) rmin = std::min(rmin,UGrid->_rdimensions[d]);
+    int expect = (rmin < DomainWallLayout::MinReducedExtent) ? DomainWallLayout::LayoutLs : DomainWallLayout::Layout4d;
+    int choice = DomainWallLayout::Choose(UGrid,Ls,nsimd);
+    std::cout<<GridLogMessage<<"smallest reduced extent "<<rmin<<" -> "<<DomainWallLayout::Name(choice)<<" layout"<<std::endl;
+    if ( DomainWallLayout::Layout == DomainWallLayout::LayoutAuto ) {
+      assert(choice == expect);
+      assert(DomainWallLayout::Choose(UGrid,Ls+1,nsimd) == DomainWallLayout::Layout4d); // Ls not a multiple of Nsimd
+    }
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Factory solves agree between layouts"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  FermionField src(FGrid); random(RNG5,src);
+  FermionField sol4d(FGrid), solLs(FGrid), diff(FGrid);
+
+  int saved = DomainWallLayout::Layout;
+  typedef DomainWallLayoutFactory<DomainWallFermionD,DomainWallFermionVec5dD> Factory;
+
+  DomainWallLayout::Layout = DomainWallLayout::Layout4d;
+  { Factory factory(UGrid,Ls); assert(factory.Layout()==DomainWallLayout::Layout4d); FactorySolve(factory,Umu,src,sol4d,mass,M5); }
+
+  DomainWallLayout::Layout = DomainWallLayout::LayoutLs;
+  { Factory factory(UGrid,Ls); assert(factory.Layout()==DomainWallLayout::LayoutLs); FactorySolve(factory,Umu,src,solLs,mass,M5); }
+
+  DomainWallLayout::Layout = saved;
+
+  diff = sol4d-solLs;
+  std::cout<<GridLogMessage<<"solution Ls vectorised vs 4d "<<norm2(diff)/norm2(sol4d)<<std::endl;
+  assert(norm2(diff)/norm2(sol4d) < 1.0e-16);
+
+  std::cout<<GridLogMessage<<"Test_dwf_layout passed"<<std::endl;
+  Grid_finalize();
+}
@@ -129,6 +129,34 @@ int main (int argc, char ** argv)
   S= S-Stilde;
   std::cout << "diff FT[SpinMat] "<<norm2(S) << std::endl;
 
+  std::cout<<"*************************************************"<<std::endl;
+  std::cout<<"Testing batched FFT against one field at a time  "<<std::endl;
+  std::cout<<"*************************************************"<<std::endl;
+  {
+    GridParallelRNG bRNG(&GRID);
+    bRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+    int Nbatch = 4;
+    std::vector<LatticeSpinMatrixD> Sb(Nbatch,&GRID);
+    std::vector<LatticeSpinMatrixD> Sbtilde(Nbatch,&GRID);
+    for(int b=0;b<Nbatch;b++) random(bRNG,Sb[b]);
+
+    double t0 = usecond();
+    theFFT.FFT_all_dim(Sbtilde,Sb,FFT::forward);
+    double t1 = usecond();
+
+    RealD diff = 0.0;
+    for(int b=0;b<Nbatch;b++){
+      theFFT.FFT_all_dim(Stilde,Sb[b],FFT::forward);
+      Stilde = Stilde - Sbtilde[b];
+      diff += norm2(Stilde);
+    }
+    double t2 = usecond();
+    std::cout << " batched " << (t1-t0)/1000.0 << " ms, one at a time " << (t2-t1)/1000.0 << " ms" << std::endl;
+    std::cout << "diff batched FT[SpinMat] "<<diff << std::endl;
+    assert(diff < 1.0e-10);
+  }
+
   /*
    */
   std::vector<int> seeds({1,2,3,4});
@@ -148,5 +148,86 @@ int main (int argc, char ** argv)
   plaq=WilsonLoops<PeriodicGimplR>::avgPlaquette(Umu);
   std::cout << " Final plaquette "<<plaq << std::endl;
 
+  std::cout<< "*****************************************************************" <<std::endl;
+  std::cout<< "* Comparing steepest descent, conjugate gradient, overrelaxation *" <<std::endl;
+  std::cout<< "*****************************************************************" <<std::endl;
+
+  typedef FourierAcceleratedGaugeFixer<PeriodicGimplR> GaugeFixer;
+
+  auto theta = [&](LatticeGaugeField &U, int orthog) {
+    std::vector<LatticeColourMatrix> Umu(Nd,&GRID), A(Nd,&GRID);
+    LatticeColourMatrix dmuAmu(&GRID);
+    for(int mu=0;mu<Nd;mu++) Umu[mu] = PeekIndex<LorentzIndex>(U,mu);
+    GaugeFixer::GaugeLinkToLieAlgebraField(Umu,A);
+    GaugeFixer::DmuAmu(A,dmuAmu,orthog);
+    return GaugeFixer::Theta(dmuAmu);
+  };
+
+  LatticeGaugeField Uhot(&GRID);
+  SU<Nc>::HotConfiguration(pRNG,Uhot);
+
+  Real theta_tol = 1.0e-10;
+  Real omega     = 1.7;
+  std::vector<int> orthogs({-1,coulomb_dir});
+  for(auto orthog : orthogs) {
+
+    std::string gauge = (orthog<0) ? "Landau " : "Coulomb";
+
+    Umu = Uhot;
+    double t0 = usecond();
+    GaugeFixer::SteepestDescentGaugeFix(Umu,xform1,alpha,10000,1.0e-12, 1.0e-12,true,orthog);
+    double t1 = usecond();
+    Real theta_sd = theta(Umu,orthog);
+
+    Umu = Uhot;
+    int iter_cg = GaugeFixer::ConjugateGradientGaugeFix(Umu,xform2,alpha,10000,theta_tol,1.0e-12,orthog);
+    double t2 = usecond();
+    Real theta_cg = theta(Umu,orthog);
+    Utmp = Uhot;
+    SU<Nc>::GaugeTransform(Utmp,xform2);
+    Utmp = Utmp - Umu;
+    std::cout << " Norm Difference of CG xformed gauge "<< norm2(Utmp) << std::endl;
+    assert(norm2(Utmp) < 1.0e-10);
+
+    Umu = Uhot;
+    int iter_or = GaugeFixer::OverrelaxedGaugeFix(Umu,xform3,omega,10000,theta_tol,1.0e-12,orthog);
+    double t3 = usecond();
+    Real theta_or = theta(Umu,orthog);
+    Uorg = Uhot;
+    SU<Nc>::GaugeTransform(Uorg,xform3);
+    Uorg = Uorg - Umu;
+    std::cout << " Norm Difference of overrelaxed xformed gauge "<< norm2(Uorg) << std::endl;
+    assert(norm2(Uorg) < 1.0e-10);
+
+    std::cout << gauge << " steepest descent (Fourier) "<< (t1-t0)/1.0e6 << " s theta " << theta_sd << std::endl;
+    std::cout << gauge << " conjugate gradient         "<< (t2-t1)/1.0e6 << " s theta " << theta_cg << " iterations " << iter_cg << std::endl;
+    std::cout << gauge << " overrelaxed omega="<<omega<<"     "<< (t3-t2)/1.0e6 << " s theta " << theta_or << " sweeps " << iter_or << std::endl;
+  }
+
+  std::cout<< "*****************************************************************" <<std::endl;
+  std::cout<< "* Coulomb gauge fixing timeslice by timeslice                    *" <<std::endl;
+  std::cout<< "*****************************************************************" <<std::endl;
+  {
+    Umu = Uhot;
+    double t0 = usecond();
+    int iter_cg = GaugeFixer::ConjugateGradientGaugeFix(Umu,xform2,alpha,10000,theta_tol,1.0e-12,coulomb_dir);
+    double t1 = usecond();
+    Real theta_cg = theta(Umu,coulomb_dir);
+
+    Umu = Uhot;
+    int iter_sl = GaugeFixer::CoulombGaugeFixBySlice(Umu,xform1,alpha,10000,theta_tol,1.0e-12,coulomb_dir);
+    double t2 = usecond();
+    Real theta_sl = theta(Umu,coulomb_dir);
+    Utmp = Uhot;
+    SU<Nc>::GaugeTransform(Utmp,xform1);
+    Utmp = Utmp - Umu;
+    std::cout << " Norm Difference of sliced xformed gauge "<< norm2(Utmp) << std::endl;
+    assert(norm2(Utmp) < 1.0e-10);
+    assert(theta_sl < theta_tol);
+
+    std::cout << "Coulomb global CG   "<< (t1-t0)/1.0e6 << " s theta " << theta_cg << " iterations " << iter_cg << std::endl;
+    std::cout << "Coulomb sliced CG   "<< (t2-t1)/1.0e6 << " s theta " << theta_sl << " iterations " << iter_sl << std::endl;
+  }
+
   Grid_finalize();
 }
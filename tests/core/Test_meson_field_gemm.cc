@@ -0,0 +1,127 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_meson_field_gemm.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/qcd/utils/A2Autils.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef A2Autils<WilsonImplR> A2A;
+typedef WilsonImplR::FermionField FermionField;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian Grid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(&Grid);  pRNG.SeedFixedIntegers(seeds);
+
+  const int Lblock = 3;
+  const int Rblock = 4;
+  const int orthogdim = Tp;
+  const int Nt = latt_size[orthogdim];
+
+  std::vector<FermionField> w(Lblock,&Grid);
+  std::vector<FermionField> v(Rblock,&Grid);
+  for(auto &f : w) random(pRNG,f);
+  for(auto &f : v) random(pRNG,f);
+
+  // Momentum phases exp(i 2pi p.x/L), including zero momentum
+  std::vector<std::vector<int> > momenta({{0,0,0},{1,0,0},{0,-1,1},{1,1,-1}});
+  std::vector<LatticeComplex> mom;
+  LatticeComplex coor(&Grid);
+  for(auto &p : momenta){
+    LatticeComplex ph(&Grid); ph = Zero();
+    for(int mu=0;mu<Nd-1;mu++){
+      LatticeCoordinate(coor,mu);
+      ph = ph + (2.0*M_PI*p[mu]/latt_size[mu])*coor;
+    }
+    ComplexD ci(0.0,1.0);
+    mom.push_back(exp(ci*ph));
+  }
+  const int Nmom = mom.size();
+
+  std::vector<Gamma::Algebra> gammas({Gamma::Algebra::Identity,
+	                              Gamma::Algebra::Gamma5,
+	                              Gamma::Algebra::GammaX,
+	                              Gamma::Algebra::GammaT,
+	                              Gamma::Algebra::GammaYGamma5,
+	                              Gamma::Algebra::SigmaXZ});
+  const int Ngamma = gammas.size();
+
+  Eigen::Tensor<ComplexD,5,Eigen::RowMajor> mat(Nmom,Ngamma,Nt,Lblock,Rblock);
+  A2A::MesonField(mat,&w[0],&v[0],gammas,mom,orthogdim);
+
+  // PionFieldWVmom is the same contraction with the gamma5 spin weight
+  Eigen::Tensor<ComplexD,4> pion(Nmom,Nt,Lblock,Rblock);
+  A2A::PionFieldWVmom(pion,&w[0],&v[0],mom,orthogdim);
+
+  // Reference: slice sum of the site local inner product <w_i| G |v_j> times the phase
+  RealD maxdiff = 0.0;
+  RealD maxref  = 0.0;
+  Gamma g5(Gamma::Algebra::Gamma5);
+  for(int i=0;i<Lblock;i++){
+    for(int j=0;j<Rblock;j++){
+      for(int mu=0;mu<Ngamma;mu++){
+	FermionField Gv(&Grid); Gv = Gamma(gammas[mu])*v[j];
+	LatticeComplex wGv(&Grid); wGv = localInnerProduct(w[i],Gv);
+	for(int m=0;m<Nmom;m++){
+	  LatticeComplex pwGv(&Grid); pwGv = mom[m]*wGv;
+	  std::vector<TComplex> ref;
+	  sliceSum(pwGv,ref,orthogdim);
+	  for(int t=0;t<Nt;t++){
+	    ComplexD r = TensorRemove(ref[t]);
+	    maxdiff = std::max(maxdiff,abs(mat(m,mu,t,i,j)-r));
+	    maxref  = std::max(maxref,abs(r));
+	  }
+	}
+      }
+      FermionField g5v(&Grid); g5v = g5*v[j];
+      LatticeComplex wg5v(&Grid); wg5v = localInnerProduct(w[i],g5v);
+      for(int m=0;m<Nmom;m++){
+	LatticeComplex pwg5v(&Grid); pwg5v = mom[m]*wg5v;
+	std::vector<TComplex> ref;
+	sliceSum(pwg5v,ref,orthogdim);
+	for(int t=0;t<Nt;t++){
+	  maxdiff = std::max(maxdiff,abs(pion(m,t,i,j)-TensorRemove(ref[t])));
+	}
+      }
+    }
+  }
+  std::cout << GridLogMessage << "Meson field max |diff| " << maxdiff
+	    << " max |ref| " << maxref << std::endl;
+  assert(maxref > 0.0);
+  assert(maxdiff < 1.0e-10*maxref);
+
+  Grid_finalize();
+}
@@ -0,0 +1,172 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_quenched_update_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::vector<int> latt({8,8,8,8});
+  GridCartesian * grid = SpaceTimeGrid::makeFourDimGrid(latt, 
+							GridDefaultSimd(Nd,vComplex::Nsimd()),
+							GridDefaultMpi());
+  GridRedBlackCartesian * rbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(grid);
+
+  std::vector<int> pseeds({1,2,3,4,5});
+  std::vector<int> sseeds({6,7,8,9,10});
+  GridParallelRNG  pRNG(grid); pRNG.SeedFixedIntegers(pseeds);
+  GridSerialRNG    sRNG;       sRNG.SeedFixedIntegers(sseeds);
+
+  RealD beta=6.0;
+  int nsweep = 20;
+  if( GridCmdOptionExists(argv,argv+argc,"--sweeps") ){
+    std::string arg = GridCmdOptionPayload(argv,argv+argc,"--sweeps");
+    GridCmdOptionInt(arg,nsweep);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Reference: masked per-subgroup heat bath as in Test_quenched_update
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeField Uref(grid); Uref=1.0;
+  LatticeColourMatrix link(grid);
+  LatticeColourMatrix staple(grid);
+  int subsets[2] = { Even, Odd};
+  LatticeInteger one(rbGrid);  one = 1;
+  LatticeInteger mask(grid); 
+
+  RealD t_ref = -usecond();
+  for(int sweep=0;sweep<nsweep;sweep++){
+    for( int cb=0;cb<2;cb++ ) {
+      one.Checkerboard()=subsets[cb];
+      mask= Zero();
+      setCheckerboard(mask,one);
+      for(int mu=0;mu<Nd;mu++){
+	ColourWilsonLoops::Staple(staple,Uref,mu);
+	link = PeekIndex<LorentzIndex>(Uref,mu);
+	for( int subgroup=0;subgroup<SU<Nc>::su2subgroups();subgroup++ ) {
+	  SU<Nc>::SubGroupHeatBath(sRNG,pRNG,beta,link,staple,subgroup,20,mask);
+	}
+	PokeIndex<LorentzIndex>(Uref,link,mu);
+	ProjectOnGroup(Uref);
+      }
+    }
+  }
+  t_ref += usecond();
+  RealD plaq_ref = ColourWilsonLoops::avgPlaquette(Uref);
+  std::cout<<GridLogMessage<<"Masked heat bath  : "<<nsweep<<" sweeps "<<t_ref/nsweep/1000.0<<" ms/sweep plaquette "<<plaq_ref<<std::endl;
+
+  ////////////////////////////////////////////////////////////
+  // Fused engine, heat bath only for a like for like timing
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeField Umu(grid); Umu=1.0;
+  QuenchedUpdate<PeriodicGimplR> HB(QuenchedUpdateParameters(beta,1,0,20));
+
+  RealD t_hb = -usecond();
+  for(int sweep=0;sweep<nsweep;sweep++) HB.Sweep(sRNG,Umu);
+  t_hb += usecond();
+  RealD plaq_hb = ColourWilsonLoops::avgPlaquette(Umu);
+  std::cout<<GridLogMessage<<"Fused heat bath   : "<<nsweep<<" sweeps "<<t_hb/nsweep/1000.0<<" ms/sweep plaquette "<<plaq_hb<<std::endl;
+  std::cout<<GridLogMessage<<"Speed up "<<t_ref/t_hb<<std::endl;
+  HB.Report();
+
+  ////////////////////////////////////////////////////////////
+  // Heat bath + overrelaxation from the same start
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeField Uor(grid); Uor=1.0;
+  QuenchedUpdate<PeriodicGimplR> HBOR(QuenchedUpdateParameters(beta,1,4,20));
+  RealD t_or = -usecond();
+  for(int sweep=0;sweep<nsweep;sweep++){
+    HBOR.Sweep(sRNG,Uor);
+    std::cout<<GridLogMessage<<"sweep "<<sweep<<" PLAQUETTE "<<ColourWilsonLoops::avgPlaquette(Uor)<<std::endl;
+  }
+  t_or += usecond();
+  RealD plaq_or = ColourWilsonLoops::avgPlaquette(Uor);
+  std::cout<<GridLogMessage<<"Fused HB + 4 OR   : "<<nsweep<<" sweeps "<<t_or/nsweep/1000.0<<" ms/sweep plaquette "<<plaq_or<<std::endl;
+
+  // Overrelaxation alone leaves the action unchanged
+  RealD plaq0 = ColourWilsonLoops::avgPlaquette(Uor);
+  QuenchedUpdate<PeriodicGimplR> OR(QuenchedUpdateParameters(beta,0,0,20));
+  LatticeGaugeField Ucopy(grid); Ucopy = Uor;
+  for(int mu=0;mu<Nd;mu++){
+    std::vector<LatticeColourMatrix> U(Nd,grid);
+    for(int nu=0;nu<Nd;nu++) U[nu] = PeekIndex<LorentzIndex>(Ucopy,nu);
+    uint32_t key[2] = {1,2};
+    QuenchedUpdate<PeriodicGimplR>::Staple(staple,U,mu);
+    OR.UpdateLinks(U[mu],staple,0,false,key,0);
+    PokeIndex<LorentzIndex>(Ucopy,U[mu],mu);
+  }
+  RealD plaq1 = ColourWilsonLoops::avgPlaquette(Ucopy);
+  LatticeGaugeField Ushift(grid); Ushift = Ucopy - Uor;
+  std::cout<<GridLogMessage<<"Overrelaxation link change "<<norm2(Ushift)/norm2(Uor)<<std::endl;
+  assert(norm2(Ushift) > 0.0);
+  std::cout<<GridLogMessage<<"Overrelaxation plaquette change "<<plaq1-plaq0<<std::endl;
+  assert(fabs(plaq1-plaq0) < 1.0e-10);
+
+  // The checkerboard staple matches the full lattice one on its sites
+  {
+    std::vector<LatticeColourMatrix> U(Nd,grid);
+    std::vector<LatticeColourMatrix> Ucb[2];
+    for(int nu=0;nu<Nd;nu++) U[nu] = PeekIndex<LorentzIndex>(Uor,nu);
+    for(int cb=0;cb<2;cb++){
+      Ucb[cb].resize(Nd,rbGrid);
+      for(int nu=0;nu<Nd;nu++) pickCheckerboard(cb,Ucb[cb][nu],U[nu]);
+    }
+    LatticeColourMatrix staple_cb(rbGrid), staple_pick(rbGrid), diff(rbGrid);
+    for(int mu=0;mu<Nd;mu++){
+      QuenchedUpdate<PeriodicGimplR>::Staple(staple,U,mu);
+      for(int cb=0;cb<2;cb++){
+	QuenchedUpdate<PeriodicGimplR>::StapleCheckerboard(staple_cb,Ucb,mu,cb);
+	pickCheckerboard(cb,staple_pick,staple);
+	diff = staple_cb-staple_pick;
+	assert(norm2(diff) < 1.0e-24*norm2(staple_pick));
+      }
+    }
+    std::cout<<GridLogMessage<<"Checkerboard staple matches"<<std::endl;
+  }
+
+  // Links stay in the group
+  LatticeColourMatrix Umat(grid), Uid(grid), Udiff(grid);
+  Uid = 1.0;
+  Umat = PeekIndex<LorentzIndex>(Uor,0);
+  Udiff = Umat*adj(Umat)-Uid;
+  RealD unitarity = norm2(Udiff)/norm2(Uid);
+  std::cout<<GridLogMessage<<"Unitarity violation "<<unitarity<<std::endl;
+  assert(unitarity < 1.0e-20);
+
+  // Equilibrium plaquette at beta=6 is 0.5937; both updates head there from a cold start
+  if ( nsweep >= 20 ) {
+    assert(fabs(plaq_hb-plaq_ref) < 0.02);
+    assert(fabs(plaq_or-0.5937)   < 0.02);
+  }
+
+  std::cout<<GridLogMessage<<"Test_quenched_update_fused passed"<<std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,148 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_rng_counter.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  // Counter based RNGs for everything constructed from here on
+  GridRNGbase::UseCounterBased=1;
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(4,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  Coordinate simd_flip(simd_layout);
+  for(int d=0;d<simd_layout.size();d++) simd_flip[d] = simd_layout[simd_layout.size()-1-d];
+
+  GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+  GridCartesian     GridFlip(latt_size,simd_flip,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+
+  GridSerialRNG            sRNG;           sRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG          pRNG(&Grid);     pRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG          pRNGflip(&GridFlip); pRNGflip.SeedFixedIntegers(seeds);
+
+  std::cout << GridLogMessage << "Simd layout " << simd_layout << " and " << simd_flip << std::endl;
+
+  ////////////////////////////////////////////////////////////
+  // Same numbers for every SIMD decomposition
+  ////////////////////////////////////////////////////////////
+  LatticeFermion src(&Grid);      gaussian(pRNG,src);
+  LatticeFermion srcflip(&GridFlip); gaussian(pRNGflip,srcflip);
+
+  RealD maxdiff = 0.0;
+  for(int gidx=0;gidx<Grid.gSites();gidx+=7){
+    Coordinate gcoor;
+    Grid.GlobalIndexToGlobalCoor(gidx,gcoor);
+    SpinColourVector a,b;
+    peekSite(a,src,gcoor);
+    peekSite(b,srcflip,gcoor);
+    maxdiff = std::max(maxdiff,(RealD)norm2(a-b));
+  }
+  std::cout << GridLogMessage << "Max site difference between SIMD layouts " << maxdiff << std::endl;
+  assert(maxdiff == 0.0);
+
+  // real fields on the complex layout repeat each lane, as toComplex requires
+  LatticeReal re(&Grid);     gaussian(pRNG,re);
+  LatticeComplex rc(&Grid);  rc = toComplex(re);
+  LatticeReal reflip(&GridFlip); gaussian(pRNGflip,reflip);
+  maxdiff = 0.0;
+  for(int gidx=0;gidx<Grid.gSites();gidx+=7){
+    Coordinate gcoor;
+    Grid.GlobalIndexToGlobalCoor(gidx,gcoor);
+    RealD r, rflip;
+    Complex z;
+    peekSite(r,re,gcoor);
+    peekSite(rflip,reflip,gcoor);
+    peekSite(z,rc,gcoor);
+    maxdiff = std::max(maxdiff,std::fabs(z.real()-r)+std::fabs(z.imag())+std::fabs(rflip-r));
+  }
+  std::cout << GridLogMessage << "Max real field difference " << maxdiff << std::endl;
+  assert(maxdiff == 0.0);
+
+  ////////////////////////////////////////////////////////////
+  // Vectorisable log/sincos against libm
+  ////////////////////////////////////////////////////////////
+  RealD logerr = 0.0, trigerr = 0.0;
+  for(int i=0;i<=100000;i++){
+    RealD u = (i+0.5)/100001.5;
+    RealD uu= std::ldexp(u,-(i%60));
+    RealD sn,cs;
+    RandomTransforms::SinCos2Pi(u,sn,cs);
+    logerr  = std::max(logerr ,fabs(RandomTransforms::LogUnit(uu)-std::log(uu))/fabs(std::log(uu)));
+    trigerr = std::max(trigerr,fabs(sn-std::sin(2.0*M_PI*u)));
+    trigerr = std::max(trigerr,fabs(cs-std::cos(2.0*M_PI*u)));
+  }
+  std::cout << GridLogMessage << "LogUnit relative error " << logerr << " SinCos2Pi error " << trigerr << std::endl;
+  assert(logerr  < 1.0e-14);
+  assert(trigerr < 1.0e-14);
+
+  ////////////////////////////////////////////////////////////
+  // Moments of the gaussian and uniform fills
+  ////////////////////////////////////////////////////////////
+  LatticeComplex c(&Grid);
+  RealD nreal = 2.0*Grid.gSites();
+
+  gaussian(pRNG,c);
+  RealD mean = real(TensorRemove(sum(real(c)+imag(c))))/nreal;
+  RealD var  = norm2(c)/nreal;
+  std::cout << GridLogMessage << "Gaussian mean " << mean << " variance " << var << std::endl;
+  assert(fabs(mean)     < 10.0/sqrt(nreal));
+  assert(fabs(var-1.0)  < 10.0*sqrt(2.0/nreal));
+
+  random(pRNG,c);
+  mean = real(TensorRemove(sum(real(c)+imag(c))))/nreal;
+  std::cout << GridLogMessage << "Uniform mean " << mean << std::endl;
+  assert(fabs(mean-0.5) < 10.0*sqrt(1.0/12.0/nreal));
+
+  ////////////////////////////////////////////////////////////
+  // State save/restore reproduces the stream
+  ////////////////////////////////////////////////////////////
+  std::vector<GridRNGbase::RngStateType> saved;
+  pRNG.GetState(saved,0);
+  LatticeFermion first(&Grid);  gaussian(pRNG,first);
+  pRNG.SetState(saved,0);
+  LatticeFermion second(&Grid); gaussian(pRNG,second);
+  LatticeFermion diff(&Grid);   diff = first-second;
+  std::cout << GridLogMessage << "Restored stream difference " << norm2(diff) << std::endl;
+  assert(norm2(diff) == 0.0);
+
+  // serial draws agree on every rank without a broadcast
+  RealD r; random(sRNG,r);
+  RealD r0 = r;
+  CartesianCommunicator::BroadcastWorld(0,(void *)&r0,sizeof(r0));
+  assert(r == r0);
+
+  std::cout << GridLogMessage << "Test_rng_counter passed" << std::endl;
+  Grid_finalize();
+}
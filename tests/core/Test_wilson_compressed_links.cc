@@ -0,0 +1,105 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/core/Test_wilson_compressed_links.cc
+
+    Copyright (C) 2015
+
+Author: paboyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(&Grid);
+
+  GridParallelRNG          pRNG(&Grid);
+  pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField Umu(&Grid);
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  LatticeFermion src (&Grid); random(pRNG,src);
+  LatticeFermion full(&Grid);
+  LatticeFermion comp(&Grid);
+  LatticeFermion err (&Grid);
+
+  // antiperiodic in time and a twist in x, so the stored phase is not det U
+  WilsonImplParams params;
+  params.boundary_phases[Nd-1] = -1.0;
+  params.twist_n_2pi_L[0]      = 1.0;
+
+  RealD mass=0.1;
+  WilsonFermionD           Dfull(Umu,Grid,RBGrid,mass,params);
+  WilsonFermionCompressedD Dcomp(Umu,Grid,RBGrid,mass,params);
+
+  RealD tol = 1.0e-24*norm2(src);
+  for(int opt=WilsonKernelsStatic::OptGeneric;opt<=WilsonKernelsStatic::OptHandUnroll;opt++){
+    WilsonKernelsStatic::Opt = opt;
+    std::cout<<GridLogMessage<<"Kernel option "<<opt<<std::endl;
+    for(int dag=0;dag<2;dag++){
+      Dfull.Dhop(src,full,dag);
+      Dcomp.Dhop(src,comp,dag);
+      err = full-comp;
+      std::cout<<GridLogMessage<<"Dhop  dag="<<dag<<" |full - compressed|^2 = "<<norm2(err)<<std::endl;
+      assert(norm2(err) < tol);
+    }
+    Dfull.M(src,full);
+    Dcomp.M(src,comp);
+    err = full-comp;
+    std::cout<<GridLogMessage<<"M       |full - compressed|^2 = "<<norm2(err)<<std::endl;
+    assert(norm2(err) < tol);
+
+    LatticeFermion src_o (&RBGrid); pickCheckerboard(Odd,src_o,src);
+    LatticeFermion full_e(&RBGrid);
+    LatticeFermion comp_e(&RBGrid);
+    LatticeFermion err_e (&RBGrid);
+    Dfull.Meooe(src_o,full_e);
+    Dcomp.Meooe(src_o,comp_e);
+    err_e = full_e-comp_e;
+    std::cout<<GridLogMessage<<"Meooe   |full - compressed|^2 = "<<norm2(err_e)<<std::endl;
+    assert(norm2(err_e) < tol);
+  }
+
+  // the links come back out of the packed form
+  std::vector<LatticeColourMatrix> Ufull(Nd,&Grid);
+  std::vector<LatticeColourMatrix> Ucomp(Nd,&Grid);
+  Dfull.extractLinkField(Ufull,Dfull.Umu);
+  Dcomp.extractLinkField(Ucomp,Dcomp.Umu);
+  for(int mu=0;mu<Nd;mu++){
+    LatticeColourMatrix Udiff(&Grid);
+    Udiff = Ufull[mu]-Ucomp[mu];
+    std::cout<<GridLogMessage<<"Link "<<mu<<" |full - compressed|^2 = "<<norm2(Udiff)<<std::endl;
+    assert(norm2(Udiff) < 1.0e-24*norm2(Ufull[mu]));
+  }
+
+  std::cout<<GridLogMessage<<"Test_wilson_compressed_links passed"<<std::endl;
+  Grid_finalize();
+}
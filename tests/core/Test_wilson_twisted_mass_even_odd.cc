@@ -118,6 +118,41 @@ int main (int argc, char ** argv)
   LatticeComplex cerr(&Grid);
   cerr = localInnerProduct(err,err);
 
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing that Meo + Moe + Moo + Mee = Munprec "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  LatticeFermion r_eeoo(&Grid);
+  for(int dag=0;dag<2;dag++){
+    if ( dag ) {
+      Dw.MeooeDag(src_e,r_o);
+      Dw.MeooeDag(src_o,r_e);
+    } else {
+      Dw.Meooe(src_e,r_o);
+      Dw.Meooe(src_o,r_e);
+    }
+    setCheckerboard(r_eo,r_o);
+    setCheckerboard(r_eo,r_e);
+
+    if ( dag ) {
+      Dw.MooeeDag(src_e,r_e);
+      Dw.MooeeDag(src_o,r_o);
+    } else {
+      Dw.Mooee(src_e,r_e);
+      Dw.Mooee(src_o,r_o);
+    }
+    setCheckerboard(r_eeoo,r_e);
+    setCheckerboard(r_eeoo,r_o);
+
+    r_eo = r_eo + r_eeoo;
+    if ( dag ) Dw.Mdag(src,ref);
+    else       Dw.M(src,ref);
+
+    err = ref - r_eo;
+    std::cout<<GridLogMessage << (dag ? "Mdag" : "M   ") << " EO norm diff   "<< norm2(err)<< " "<<norm2(ref)<< " " << norm2(r_eo) <<std::endl;
+    assert(norm2(err) < 1.0e-10*norm2(ref));
+  }
+
   std::cout<<GridLogMessage<<"=============================================================="<<std::endl;
   std::cout<<GridLogMessage<<"= Test Ddagger is the dagger of D by requiring                "<<std::endl;
   std::cout<<GridLogMessage<<"=  < phi | Deo | chi > * = < chi | Deo^dag| phi>  "<<std::endl;
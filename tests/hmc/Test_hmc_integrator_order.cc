@@ -0,0 +1,127 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./tests/hmc/Test_hmc_integrator_order.cc
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace Grid;
+
+typedef PeriodicGimplR                 Gimpl;
+typedef NoSmearing<Gimpl>              NoSmear;
+typedef Gimpl::Field                   Field;
+typedef ActionSet<Field,NoHirep>       Actions;
+
+// Only the force gradient integrator has a level selection
+template<class IntegratorType>
+void SetForceGradientLevels(IntegratorType &MDynamics, const std::vector<int> &levels)
+{
+  assert(levels.empty());
+}
+void SetForceGradientLevels(OmelyanForceGradient<Gimpl,NoSmear> &MDynamics, const std::vector<int> &levels)
+{
+  if ( levels.size() ) MDynamics.setForceGradientLevels(levels);
+}
+
+// Energy violation of one trajectory from a fixed start and fixed momenta
+template<class IntegratorType>
+RealD DeltaH(const Field &Ustart, Actions &as, int MDsteps, const std::vector<int> &fg_levels = {})
+{
+  GridBase *grid = Ustart.Grid();
+  NoSmear Sm;
+  IntegratorParameters MD(MDsteps,1.0);
+  IntegratorType MDynamics(grid,MD,as,Sm);
+  SetForceGradientLevels(MDynamics,fg_levels);
+
+  std::vector<int> sseeds({1,2,3,4});
+  std::vector<int> pseeds({5,6,7,8});
+  GridSerialRNG   sRNG; sRNG.SeedFixedIntegers(sseeds);
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(pseeds);
+
+  Field U(grid); U = Ustart;
+  MDynamics.refresh(U,sRNG,pRNG);
+  RealD H0 = MDynamics.S(U);
+  MDynamics.integrate(U);
+  RealD H1 = MDynamics.S(U);
+  return H1-H0;
+}
+
+// dH(N)/dH(2N) should approach 2^order as the step size goes to zero
+template<class IntegratorType>
+RealD StepHalvingRatio(const std::string &name, const Field &U, Actions &as, int MDsteps,
+		       const std::vector<int> &fg_levels = {})
+{
+  RealD dH1 = DeltaH<IntegratorType>(U,as,MDsteps,fg_levels);
+  RealD dH2 = DeltaH<IntegratorType>(U,as,2*MDsteps,fg_levels);
+  RealD ratio = dH1/dH2;
+  std::cout << GridLogMessage << name << " MDsteps " << MDsteps << " dH " << dH1
+	    << " MDsteps " << 2*MDsteps << " dH " << dH2 << " ratio " << ratio << std::endl;
+  return ratio;
+}
+
+int main(int argc, char **argv)
+{
+  Grid_init(&argc, &argv);
+
+  GridCartesian *grid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+						       GridDefaultSimd(Nd,vComplex::Nsimd()),
+						       GridDefaultMpi());
+
+  std::vector<int> seeds({9,10,11,12});
+  GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(seeds);
+  Field U(grid);
+  SU<Nc>::TepidConfiguration(pRNG,U);
+
+  // The Wilson action split over two nested levels, inner level twice as fine
+  RealD beta = 6.0;
+  WilsonGaugeActionR Wouter(0.5*beta);
+  WilsonGaugeActionR Winner(0.5*beta);
+  ActionLevel<Field> Level1(1);
+  ActionLevel<Field> Level2(2);
+  Level1.push_back(&Wouter);
+  Level2.push_back(&Winner);
+  Actions as;
+  as.push_back(Level1);
+  as.push_back(Level2);
+
+  // Second order reference
+  RealD r_mn2 = StepHalvingRatio<MinimumNorm2<Gimpl,NoSmear> >("MinimumNorm2",U,as,16);
+  assert(r_mn2 > 3.0 && r_mn2 < 5.5);
+
+  // Fourth order
+  RealD r_mn4 = StepHalvingRatio<MinimumNorm4<Gimpl,NoSmear> >("MinimumNorm4",U,as,16);
+  assert(r_mn4 > 12.0 && r_mn4 < 24.0);
+
+  // Force gradient on every level is fourth order
+  RealD r_ofg = StepHalvingRatio<OmelyanForceGradient<Gimpl,NoSmear> >("OmelyanForceGradient all levels",U,as,8,{1,1});
+  assert(r_ofg > 12.0 && r_ofg < 24.0);
+
+  // Default: force gradient on the inner level only, the outer Omelyan step keeps it second order
+  RealD r_def = StepHalvingRatio<OmelyanForceGradient<Gimpl,NoSmear> >("OmelyanForceGradient inner level",U,as,16);
+  assert(r_def > 3.0 && r_def < 5.5);
+
+  Grid_finalize();
+}
@@ -0,0 +1,142 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/solver/Test_madwf_recycle.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// MADWF with recycled inner solutions must reach the same solution as
+// MADWF with every inner solve started from scratch, in fewer inner iterations,
+// and must forget the recycled solutions when the gauge field changes.
+
+typedef SchurRedBlackDiagMooeeSolve<LatticeFermionD> SchurSolverD;
+typedef PauliVillarsSolverRBprec<LatticeFermionD,SchurSolverD> PVtype;
+typedef MADWF<MobiusFermionD,MobiusFermionD,PVtype,SchurSolverD,ZeroGuesser<LatticeFermionD> > MADWFtype;
+
+// Inner CG keeping a running total of its iterations
+class CountingCG : public ConjugateGradient<LatticeFermionD> {
+public:
+  int TotalIterations;
+  CountingCG(RealD tol, Integer maxit) : ConjugateGradient<LatticeFermionD>(tol,maxit,false), TotalIterations(0) {};
+  void operator()(LinearOperatorBase<LatticeFermionD> &Linop, const LatticeFermionD &src, LatticeFermionD &psi) {
+    ConjugateGradient<LatticeFermionD>::operator()(Linop,src,psi);
+    TotalIterations += IterationsToComplete;
+  }
+};
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls_outer = 12;
+  const int Ls_inner = 6;
+  RealD mass  = 0.1;
+  RealD M5    = 1.8;
+  RealD resid = 1.0e-8;
+  RealD resid_inner = 1.0e-4;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid_outer   = SpaceTimeGrid::makeFiveDimGrid(Ls_outer,UGrid);
+  GridRedBlackCartesian * FrbGrid_outer = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_outer,UGrid);
+  GridCartesian         * FGrid_inner   = SpaceTimeGrid::makeFiveDimGrid(Ls_inner,UGrid);
+  GridRedBlackCartesian * FrbGrid_inner = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls_inner,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeFieldD Umu(UGrid);  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  MobiusFermionD D_outer(Umu,*FGrid_outer,*FrbGrid_outer,*UGrid,*UrbGrid,mass,M5,1.5,0.5);
+  MobiusFermionD D_inner(Umu,*FGrid_inner,*FrbGrid_inner,*UGrid,*UrbGrid,mass,M5,1.0,0.0);
+
+  ConjugateGradient<LatticeFermionD> CG_pv(resid,10000);
+  SchurSolverD SchurSolver_pv(CG_pv);
+  PVtype PV(SchurSolver_pv);
+  ZeroGuesser<LatticeFermionD> Guess;
+
+  CountingCG CG_plain(resid_inner,10000);
+  SchurSolverD SchurSolver_plain(CG_plain);
+  MADWFtype madwf_plain(D_outer,D_inner,PV,SchurSolver_plain,Guess,resid,100);
+
+  CountingCG CG_recycle(resid_inner,10000);
+  SchurSolverD SchurSolver_recycle(CG_recycle);
+  MADWFtype madwf_recycle(D_outer,D_inner,PV,SchurSolver_recycle,Guess,resid,100);
+  madwf_recycle.SetInnerRecycle(8);
+
+  // Two sources in turn; the second call reuses the space built by the first
+  LatticeFermionD src4(UGrid);
+  LatticeFermionD sol_plain(FGrid_outer), sol_recycle(FGrid_outer), diff(FGrid_outer);
+  for(int s=0;s<2;s++){
+    random(RNG4,src4);
+
+    sol_plain = Zero();
+    madwf_plain(src4,sol_plain);
+
+    sol_recycle = Zero();
+    madwf_recycle(src4,sol_recycle);
+
+    diff = sol_recycle - sol_plain;
+    RealD rel = std::sqrt(norm2(diff)/norm2(sol_plain));
+    std::cout << GridLogMessage << "Source " << s << " recycled vs plain MADWF solution " << rel << std::endl;
+    assert(rel < 1.0e-6);
+  }
+
+  std::cout << GridLogMessage << "Inner CG iterations: plain " << CG_plain.TotalIterations
+	    << " recycled " << CG_recycle.TotalIterations << std::endl;
+  assert(CG_recycle.TotalIterations < CG_plain.TotalIterations);
+
+  // A new configuration drops the recycled space: the solver then behaves
+  // exactly like one that never saw the old configuration
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+  D_outer.ImportGauge(Umu);
+  D_inner.ImportGauge(Umu);
+
+  CountingCG CG_fresh(resid_inner,10000);
+  SchurSolverD SchurSolver_fresh(CG_fresh);
+  MADWFtype madwf_fresh(D_outer,D_inner,PV,SchurSolver_fresh,Guess,resid,100);
+  madwf_fresh.SetInnerRecycle(8);
+
+  LatticeFermionD sol_fresh(FGrid_outer);
+  random(RNG4,src4);
+  sol_fresh = Zero();
+  madwf_fresh(src4,sol_fresh);
+
+  int before = CG_recycle.TotalIterations;
+  sol_recycle = Zero();
+  madwf_recycle(src4,sol_recycle);
+
+  diff = sol_recycle - sol_fresh;
+  std::cout << GridLogMessage << "New configuration: inner CG iterations fresh " << CG_fresh.TotalIterations
+	    << " recycled " << CG_recycle.TotalIterations-before
+	    << " solution difference " << std::sqrt(norm2(diff)/norm2(sol_fresh)) << std::endl;
+  assert(CG_recycle.TotalIterations-before == CG_fresh.TotalIterations);
+  assert(norm2(diff) == 0.0);
+
+  Grid_finalize();
+}
@@ -0,0 +1,147 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_wilson_mixedcg_half_prec.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         *FGrid_d   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexD::Nsimd()), GridDefaultMpi());
+  GridCartesian         *FGrid_f   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd, vComplexF::Nsimd()), GridDefaultMpi());
+  GridRedBlackCartesian *FrbGrid_d = SpaceTimeGrid::makeFourDimRedBlackGrid(FGrid_d);
+  GridRedBlackCartesian *FrbGrid_f = SpaceTimeGrid::makeFourDimRedBlackGrid(FGrid_f);
+
+  std::vector<int> fSeeds({1, 2, 3, 4});
+  GridParallelRNG  fPRNG(FGrid_d);
+  fPRNG.SeedFixedIntegers(fSeeds);
+
+  LatticeFermionD    src(FGrid_d);    gaussian(fPRNG, src);
+  LatticeGaugeFieldD Umu_d(FGrid_d);  SU<Nc>::HotConfiguration(fPRNG, Umu_d);
+  LatticeGaugeFieldF Umu_f(FGrid_f);  precisionChange(Umu_f, Umu_d);
+
+  ////////////////////////////////////////////////////////////
+  // Round trip through 16 bit storage, with a small scale
+  // that fp16 only represents after rescaling
+  ////////////////////////////////////////////////////////////
+  LatticeFermionF src_f(FGrid_f);  precisionChange(src_f, src);
+  src_f = src_f * 1.0e-6;
+  LatticeFermionF back_f(FGrid_f);
+  LatticeFermionF diff_f(FGrid_f);
+  RealD nrm = norm2(src_f);
+  for(int format=HalfPrecisionFP16;format<=HalfPrecisionBF16;format++){
+    HalfPrecisionField<vSpinColourVectorF> half(FGrid_f,(HalfPrecisionFormat)format);
+    precisionChange(half, src_f);
+    precisionChange(back_f, half);
+    diff_f = back_f - src_f;
+    RealD rel = std::sqrt(norm2(diff_f)/nrm);
+    std::cout << GridLogMessage << "Format " << format << " round trip relative error " << rel << std::endl;
+    assert(rel < ((format==HalfPrecisionFP16) ? 1.0e-3 : 1.0e-2));
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Mixed precision CG with single and 16 bit inner storage
+  ////////////////////////////////////////////////////////////
+  RealD mass = -0.1;
+  WilsonFermionD Dw_d(Umu_d, *FGrid_d, *FrbGrid_d, mass);
+  WilsonFermionF Dw_f(Umu_f, *FGrid_f, *FrbGrid_f, mass);
+
+  LatticeFermionD src_o(FrbGrid_d);
+  pickCheckerboard(Odd, src_o, src);
+
+  SchurDiagMooeeOperator<WilsonFermionD, LatticeFermionD> HermOpEO_d(Dw_d);
+  SchurDiagMooeeOperator<WilsonFermionF, LatticeFermionF> HermOpEO_f(Dw_f);
+
+  LatticeFermionD ref_o(FrbGrid_d);
+  ref_o.Checkerboard() = Odd;
+  ref_o = Zero();
+  MixedPrecisionConjugateGradient<LatticeFermionD, LatticeFermionF> mCG(1.0e-8, 10000, 50, FrbGrid_f, HermOpEO_f, HermOpEO_d);
+  mCG(src_o, ref_o);
+  std::cout << GridLogMessage << "Single precision inner: " << mCG.TotalInnerIterations << " inner iterations "
+	    << mCG.TotalOuterIterations << " restarts" << std::endl;
+
+  for(int format=HalfPrecisionFP16;format<=HalfPrecisionBF16;format++){
+    LatticeFermionD result_o(FrbGrid_d);
+    result_o.Checkerboard() = Odd;
+    result_o = Zero();
+    MixedPrecisionConjugateGradient<LatticeFermionD, LatticeFermionF> hCG(1.0e-8, 10000, 50, FrbGrid_f, HermOpEO_f, HermOpEO_d);
+    hCG.useHalfStorage((HalfPrecisionFormat)format);
+    hCG(src_o, result_o);
+    std::cout << GridLogMessage << "Format " << format << " inner: " << hCG.TotalInnerIterations << " inner iterations "
+	      << hCG.TotalOuterIterations << " restarts" << std::endl;
+    // the 16 bit inner solves stop at the storage precision and rely on the
+    // restarts, so they must not cost much more than the single precision ones
+    assert(hCG.TotalInnerIterations <= (3*mCG.TotalInnerIterations)/2);
+
+    LatticeFermionD diff_o(FrbGrid_d);
+    RealD diff = axpy_norm(diff_o, -1.0, result_o, ref_o);
+    std::cout << GridLogMessage << "Format " << format << " solution difference " << diff/norm2(ref_o) << std::endl;
+    assert(diff < 1.0e-12*norm2(ref_o));
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Vector work per iteration: the single precision CG sequence
+  // (inner product, axpy_norm and two axpys) against the fused
+  // 16 bit kernels, over the same number of iterations
+  ////////////////////////////////////////////////////////////
+  {
+    const int iters = 50;
+    LatticeFermionF src_of(FrbGrid_f), sol_of(FrbGrid_f);
+    LatticeFermionF p(FrbGrid_f), mmp(FrbGrid_f), r(FrbGrid_f);
+    precisionChange(src_of, src_o);
+    p = src_of; r = src_of; sol_of = Zero();
+    HermOpEO_f.HermOp(p, mmp);
+
+    GridStopWatch SingleTimer;
+    SingleTimer.Start();
+    for(int k=0;k<iters;k++){
+      RealD d  = innerProduct(p, mmp).real();
+      RealD a  = 1.0e-3/d;
+      RealD cp = axpy_norm(r, -a, mmp, r);
+      axpy(sol_of, a, p, sol_of);
+      axpy(p, 1.0e-3*cp, p, r);
+    }
+    SingleTimer.Stop();
+    RealD single = (RealD)SingleTimer.useconds()/iters;
+    std::cout << GridLogMessage << "Single precision CG vector work " << single << " us per iteration" << std::endl;
+
+    for(int format=HalfPrecisionFP16;format<=HalfPrecisionBF16;format++){
+      ConjugateGradientHalfStorage<LatticeFermionF> hCG(1.0e-30, iters, (HalfPrecisionFormat)format, false);
+      sol_of = Zero();
+      hCG(HermOpEO_f, src_of, sol_of);
+      RealD half = (RealD)hCG.LinalgTimer.useconds()/hCG.MaxIterations;
+      std::cout << GridLogMessage << "Format " << format << " CG vector work " << half << " us per iteration";
+      if ( half > 0.0 ) std::cout << ", " << single/half << "x the single precision rate";
+      std::cout << std::endl;
+    }
+  }
+
+  Grid_finalize();
+}